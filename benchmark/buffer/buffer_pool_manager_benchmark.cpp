@@ -0,0 +1,54 @@
+/**
+ * Buffer pool fetch/unpin microbenchmark.
+ *
+ * Fills pools of increasing size and measures the cost of a FetchPage/UnpinPage pair on resident pages.
+ * With constant time frame bookkeeping the per-operation cost should stay flat as the pool grows.
+ *
+ * usage: buffer_pool_manager_benchmark [max_pool_size = 1048576] [operations = 1000000]
+ * note: a pool of N frames needs N * PAGE_SIZE bytes of memory and disk space.
+ */
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "utils/bench_utils.h"
+
+int main(int argc, char **argv) {
+  const size_t max_pool_size = BenchArg(argc, argv, 1, 1 << 20);
+  const size_t operations = BenchArg(argc, argv, 2, 1000000);
+  const std::string db_name = "bpm_benchmark.db";
+
+  printf("%12s %14s %14s\n", "pool_size", "fetch+unpin", "ops/sec");
+  for (size_t pool_size : BenchSizes(1024, max_pool_size)) {
+    remove(db_name.c_str());
+    auto *disk_manager = new DiskManager(db_name);
+    auto *bpm = new BufferPoolManagerInstance(pool_size, disk_manager);
+
+    // fill the whole pool so that every lookup runs against a full page table
+    page_id_t page_id;
+    for (size_t i = 0; i < pool_size; i++) {
+      bpm->NewPage(page_id);
+      bpm->UnpinPage(page_id, false);
+    }
+
+    BenchRandom random;
+    std::vector<page_id_t> accesses(operations);
+    for (auto &id : accesses) {
+      id = random.Uniform(0, static_cast<int32_t>(pool_size) - 1);
+    }
+
+    BenchTimer timer;
+    for (auto id : accesses) {
+      bpm->FetchPage(id);
+      bpm->UnpinPage(id, false);
+    }
+    double nanos = timer.Nanos();
+    printf("%12zu %11.1f ns %14.0f\n", pool_size, nanos / operations, operations / (nanos / 1e9));
+
+    delete bpm;
+    delete disk_manager;
+  }
+  remove(db_name.c_str());
+  return 0;
+}
@@ -0,0 +1,89 @@
+/**
+ * Cold random page lookups through the buffer pool, fetched one at a time versus in batches with FetchPages.
+ *
+ * Every round draws a batch of random page ids, the way a batched index lookup or a nested loop join would, fetches
+ * them and unpins them again. The pool is far smaller than the file and the file is dropped from the operating system
+ * page cache before every run, so almost every fetch is a read from the device. FetchPage waits for each read before
+ * issuing the next one, FetchPages submits all misses of a batch at once and keeps the device queue busy.
+ *
+ * usage: fetch_pages_benchmark [db_pages = 65536] [pool_size = 1024] [lookups = 20000]
+ * note: the page cache can only be dropped on a disk backed filesystem, run the benchmark outside of tmpfs.
+ */
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "utils/bench_utils.h"
+
+namespace {
+
+/** Look up random pages in batches of batch_size, @return the elapsed seconds. */
+double RunLookups(BufferPoolManager *bpm, size_t db_pages, size_t lookups, size_t batch_size, bool batched) {
+  BenchRandom random;
+  std::vector<page_id_t> page_ids(batch_size);
+  BenchTimer timer;
+  for (size_t done = 0; done < lookups; done += batch_size) {
+    for (auto &page_id : page_ids) {
+      page_id = random.Uniform(0, static_cast<int32_t>(db_pages) - 1);
+    }
+    if (batched) {
+      std::vector<Page *> pages = bpm->FetchPages(page_ids);
+      for (size_t i = 0; i < pages.size(); i++) {
+        if (pages[i] != nullptr) {
+          bpm->UnpinPage(page_ids[i], false);
+        }
+      }
+    } else {
+      for (auto page_id : page_ids) {
+        if (bpm->FetchPage(page_id) != nullptr) {
+          bpm->UnpinPage(page_id, false);
+        }
+      }
+    }
+  }
+  return timer.Seconds();
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  const size_t db_pages = BenchArg(argc, argv, 1, 65536);
+  const size_t pool_size = BenchArg(argc, argv, 2, 1024);
+  const size_t lookups = BenchArg(argc, argv, 3, 20000);
+  const std::string db_name = "fetch_pages_benchmark.db";
+
+  remove(db_name.c_str());
+  {
+    DiskManager disk_manager(db_name);
+    std::vector<char> pages(64 * PAGE_SIZE, 1);
+    std::vector<std::pair<page_id_t, const char *>> batch;
+    for (size_t i = 0; i < db_pages; i += 64) {
+      batch.clear();
+      for (size_t j = i; j < std::min(i + 64, db_pages); j++) {
+        batch.emplace_back(static_cast<page_id_t>(j), pages.data() + (j - i) * PAGE_SIZE);
+      }
+      disk_manager.WritePages(batch);
+    }
+    disk_manager.Sync();
+  }
+
+  printf("%zu pages, pool of %zu frames, %zu lookups\n", db_pages, pool_size, lookups);
+  printf("%8s %16s %16s %10s %10s\n", "batch", "FetchPage/sec", "FetchPages/sec", "speedup", "engine");
+  for (size_t batch_size : {1, 4, 16, 64, 256}) {
+    double seconds[2];
+    bool io_uring = false;
+    for (bool batched : {false, true}) {
+      DropFileCache(db_name);
+      DiskManager disk_manager(db_name);
+      BufferPoolManagerInstance bpm(pool_size, &disk_manager);
+      seconds[batched] = RunLookups(&bpm, db_pages, lookups, std::min(batch_size, pool_size), batched);
+      io_uring = disk_manager.UsesIOUring();
+    }
+    printf("%8zu %16.0f %16.0f %9.2fx %10s\n", batch_size, lookups / seconds[0], lookups / seconds[1],
+           seconds[0] / seconds[1], io_uring ? "io_uring" : "threads");
+  }
+  remove(db_name.c_str());
+  return 0;
+}
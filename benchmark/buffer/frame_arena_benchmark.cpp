@@ -0,0 +1,47 @@
+/**
+ * Random access cost over a large frame arena with and without transparent huge pages.
+ *
+ * Touches one cache line of a random frame per access, which is the memory access pattern of buffer pool hits
+ * spread over a pool far larger than the TLB reach of 4 KB pages. With huge pages one TLB entry covers 512 frames.
+ * Whether huge pages are actually used depends on /sys/kernel/mm/transparent_hugepage/enabled, the benchmark prints
+ * what the arena got.
+ *
+ * usage: frame_arena_benchmark [pool_mb = 1024] [accesses = 20000000]
+ */
+#include <cstdio>
+#include <cstring>
+
+#include "buffer/frame_arena.h"
+#include "utils/bench_utils.h"
+
+int main(int argc, char **argv) {
+  const size_t pool_mb = BenchArg(argc, argv, 1, 1024);
+  const size_t accesses = BenchArg(argc, argv, 2, 20000000);
+  const size_t num_frames = pool_mb * (1 << 20) / PAGE_SIZE;
+
+  printf("pool %zu MB, %zu frames, %zu random accesses\n", pool_mb, num_frames, accesses);
+  printf("%12s %12s %14s %12s\n", "huge pages", "advised", "populate sec", "ns/access");
+  for (bool huge_pages : {false, true}) {
+    FrameArena arena(num_frames, huge_pages);
+    BenchTimer populate;
+    for (size_t i = 0; i < num_frames; i++) {
+      memset(arena.GetData(i), 1, PAGE_SIZE);
+    }
+    double populate_seconds = populate.Seconds();
+
+    BenchRandom random;
+    uint64_t sum = 0;
+    BenchTimer timer;
+    for (size_t i = 0; i < accesses; i++) {
+      auto frame_id = random.Uniform(0, static_cast<int32_t>(num_frames) - 1);
+      sum += static_cast<unsigned char>(arena.GetData(frame_id)[(i * 64) % PAGE_SIZE]);
+    }
+    double nanos = timer.Nanos() / accesses;
+    printf("%12s %12s %14.3f %12.1f\n", huge_pages ? "requested" : "off", arena.UsesHugePages() ? "yes" : "no",
+           populate_seconds, nanos);
+    if (sum == 0) {
+      printf("unexpected checksum\n");
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,46 @@
+/**
+ * LRU replacer microbenchmark.
+ *
+ * Runs pin/unpin cycles on random frames of a full replacer, plus a victim/unpin cycle every few hits to
+ * model eviction. The cost per cycle should not depend on the number of frames.
+ *
+ * usage: lru_replacer_benchmark [max_frames = 262144] [cycles = 4000000]
+ */
+#include <cstdio>
+#include <vector>
+
+#include "buffer/lru_replacer.h"
+#include "utils/bench_utils.h"
+
+int main(int argc, char **argv) {
+  const size_t max_frames = BenchArg(argc, argv, 1, 1 << 18);
+  const size_t cycles = BenchArg(argc, argv, 2, 4000000);
+  const size_t victim_every = 16;
+
+  printf("%12s %14s %14s\n", "frames", "pin+unpin", "cycles/sec");
+  for (size_t num_frames : BenchSizes(1024, max_frames)) {
+    LRUReplacer replacer(num_frames);
+    for (size_t i = 0; i < num_frames; i++) {
+      replacer.Unpin(static_cast<frame_id_t>(i));
+    }
+
+    BenchRandom random;
+    std::vector<frame_id_t> frames(cycles);
+    for (auto &frame_id : frames) {
+      frame_id = random.Uniform(0, static_cast<int32_t>(num_frames) - 1);
+    }
+
+    BenchTimer timer;
+    frame_id_t victim;
+    for (size_t i = 0; i < cycles; i++) {
+      replacer.Pin(frames[i]);
+      replacer.Unpin(frames[i]);
+      if (i % victim_every == 0 && replacer.Victim(&victim)) {
+        replacer.Unpin(victim);
+      }
+    }
+    double nanos = timer.Nanos();
+    printf("%12zu %11.1f ns %14.0f\n", num_frames, nanos / cycles, cycles / (nanos / 1e9));
+  }
+  return 0;
+}
@@ -0,0 +1,87 @@
+/**
+ * Read-only random fetches through a private buffer pool versus the mapped pool of a read-only database.
+ *
+ * The file is in the OS page cache in both runs, as it is on a reporting replica that reads the same file over and
+ * over. The private pool is much smaller than the file and copies every miss out of the page cache into one of its
+ * frames, evicting another page; the mapped pool hands out pointers into the mapping. Every fetch reads a word of the
+ * page so that the mapped run pays for touching its pages as well.
+ *
+ * usage: mapped_pool_benchmark [db_pages = 65536] [pool_size = 1024] [fetches_per_thread = 1000000] [max_threads = 4]
+ */
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "buffer/mapped_buffer_pool_manager.h"
+#include "utils/bench_utils.h"
+
+namespace {
+
+/** @return fetches per second of num_threads threads fetching random pages */
+double RunFetches(BufferPoolManager *bpm, size_t db_pages, size_t fetches, size_t num_threads) {
+  std::vector<std::thread> threads;
+  BenchTimer timer;
+  for (size_t t = 0; t < num_threads; t++) {
+    threads.emplace_back([=] {
+      BenchRandom random(15445 + t);
+      volatile char sink = 0;
+      for (size_t i = 0; i < fetches; i++) {
+        page_id_t page_id = random.Uniform(0, static_cast<int32_t>(db_pages) - 1);
+        Page *page = bpm->FetchPage(page_id);
+        if (page != nullptr) {
+          sink = sink + page->GetData()[PAGE_SIZE / 2];
+          bpm->UnpinPage(page_id, false);
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  return num_threads * fetches / timer.Seconds();
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  const size_t db_pages = BenchArg(argc, argv, 1, 65536);
+  const size_t pool_size = BenchArg(argc, argv, 2, 1024);
+  const size_t fetches = BenchArg(argc, argv, 3, 1000000);
+  const size_t max_threads = BenchArg(argc, argv, 4, 4);
+  const std::string db_name = "mapped_pool_benchmark.db";
+
+  remove(db_name.c_str());
+  {
+    DiskManager disk_manager(db_name);
+    std::vector<char> pages(64 * PAGE_SIZE, 1);
+    std::vector<std::pair<page_id_t, const char *>> batch;
+    for (size_t i = 0; i < db_pages; i += 64) {
+      batch.clear();
+      for (size_t j = i; j < std::min(i + 64, db_pages); j++) {
+        batch.emplace_back(static_cast<page_id_t>(j), pages.data() + (j - i) * PAGE_SIZE);
+      }
+      disk_manager.WritePages(batch);
+    }
+    disk_manager.Sync();
+  }
+
+  printf("%zu pages, private pool of %zu frames (%zu KB), %zu fetches per thread\n", db_pages, pool_size,
+         pool_size * PAGE_SIZE / 1024, fetches);
+  printf("%8s %16s %16s %10s\n", "threads", "private/sec", "mapped/sec", "speedup");
+  for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+    double private_rate;
+    {
+      DiskManager disk_manager(db_name);
+      BufferPoolManagerInstance bpm(pool_size, &disk_manager);
+      private_rate = RunFetches(&bpm, db_pages, fetches, threads);
+    }
+    DiskManager disk_manager(db_name, false, true);
+    MappedBufferPoolManager bpm(&disk_manager);
+    double mapped_rate = RunFetches(&bpm, db_pages, fetches, threads);
+    printf("%8zu %16.0f %16.0f %9.2fx\n", threads, private_rate, mapped_rate, mapped_rate / private_rate);
+  }
+  remove(db_name.c_str());
+  return 0;
+}
@@ -0,0 +1,83 @@
+/**
+ * Multi-threaded fetch throughput of a single buffer pool instance versus a sharded pool.
+ *
+ * The pool is filled with resident pages, then every thread repeatedly fetches and unpins random pages. A single
+ * BufferPoolManagerInstance serializes all threads on one latch, ParallelBufferPoolManager only serializes threads
+ * that hit the same shard.
+ *
+ * usage: parallel_buffer_pool_manager_benchmark [max_threads = 16] [num_instances = 16] [pool_size = 16384]
+ *                                               [operations_per_thread = 200000]
+ */
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "buffer/parallel_buffer_pool_manager.h"
+#include "utils/bench_utils.h"
+
+namespace {
+
+double RunThreads(BufferPoolManager *bpm, size_t num_threads, size_t pool_size, size_t operations) {
+  std::vector<std::thread> threads;
+  BenchTimer timer;
+  for (size_t t = 0; t < num_threads; t++) {
+    threads.emplace_back([bpm, t, pool_size, operations] {
+      BenchRandom random(15445 + t);
+      for (size_t i = 0; i < operations; i++) {
+        page_id_t page_id = random.Uniform(0, static_cast<int32_t>(pool_size) - 1);
+        bpm->FetchPage(page_id);
+        bpm->UnpinPage(page_id, false);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  return timer.Seconds();
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  const size_t max_threads = BenchArg(argc, argv, 1, 16);
+  const size_t num_instances = BenchArg(argc, argv, 2, 16);
+  const size_t pool_size = BenchArg(argc, argv, 3, 16384);
+  const size_t operations = BenchArg(argc, argv, 4, 200000);
+  const std::string db_name = "parallel_bpm_benchmark.db";
+
+  printf("%zu frames, %zu shards, %zu fetch+unpin per thread, %u hardware threads\n", pool_size, num_instances,
+         operations, std::thread::hardware_concurrency());
+  printf("%10s %8s %14s %14s\n", "pool", "threads", "Mops/sec", "speedup");
+  for (const char *name : {"single", "parallel"}) {
+    remove(db_name.c_str());
+    auto *disk_manager = new DiskManager(db_name);
+    std::unique_ptr<BufferPoolManager> bpm;
+    if (std::string(name) == "single") {
+      bpm = std::make_unique<BufferPoolManagerInstance>(pool_size, disk_manager);
+    } else {
+      bpm = std::make_unique<ParallelBufferPoolManager>(num_instances, pool_size / num_instances, disk_manager);
+    }
+    page_id_t page_id;
+    for (size_t i = 0; i < pool_size; i++) {
+      bpm->NewPage(page_id);
+      bpm->UnpinPage(page_id, false);
+    }
+
+    double base = 0;
+    for (size_t num_threads = 1; num_threads <= max_threads; num_threads *= 2) {
+      double seconds = RunThreads(bpm.get(), num_threads, pool_size, operations);
+      double throughput = num_threads * operations / seconds;
+      if (num_threads == 1) {
+        base = throughput;
+      }
+      printf("%10s %8zu %14.2f %13.2fx\n", name, num_threads, throughput / 1e6, throughput / base);
+    }
+    bpm.reset();
+    delete disk_manager;
+  }
+  remove(db_name.c_str());
+  return 0;
+}
@@ -0,0 +1,78 @@
+/**
+ * Multi-threaded FetchPage/UnpinPage throughput of a buffer pool on resident pages, per replacement policy.
+ *
+ * Every thread owns a disjoint range of the pages and repeatedly fetches and unpins random pages of its range, so
+ * every fetch is a hit. replacer_concurrency_benchmark measures the replacers alone, this one measures them behind
+ * BufferPoolManagerInstance. A hit there is not lock-free with any policy: the page table lookup, the pin count and
+ * the replacer call all happen under the latch of the pool. CLOCK only makes the work inside that latch shorter than
+ * LRU, and the hits of concurrent readers stay serialized. Only a ParallelBufferPoolManager spreads them, over the
+ * latches of its shards.
+ *
+ * usage: pool_hit_concurrency_benchmark [max_threads = 8] [pool_size = 16384] [cycles_per_thread = 1000000]
+ */
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "utils/bench_utils.h"
+
+namespace {
+
+double RunThreads(BufferPoolManager *bpm, size_t num_threads, size_t pool_size, size_t cycles) {
+  const size_t range = pool_size / num_threads;
+  std::vector<std::thread> threads;
+  BenchTimer timer;
+  for (size_t t = 0; t < num_threads; t++) {
+    threads.emplace_back([bpm, t, range, cycles] {
+      BenchRandom random(15445 + t);
+      auto first = static_cast<int32_t>(t * range);
+      for (size_t i = 0; i < cycles; i++) {
+        page_id_t page_id = random.Uniform(first, first + static_cast<int32_t>(range) - 1);
+        bpm->FetchPage(page_id);
+        bpm->UnpinPage(page_id, false);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  return timer.Seconds();
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  const size_t max_threads = BenchArg(argc, argv, 1, 8);
+  const size_t pool_size = BenchArg(argc, argv, 2, 16384);
+  const size_t cycles = BenchArg(argc, argv, 3, 1000000);
+  const std::string db_name = "pool_hit_benchmark.db";
+
+  printf("%zu frames, %zu fetch/unpin cycles per thread, %u hardware threads\n", pool_size, cycles,
+         std::thread::hardware_concurrency());
+  printf("%10s %8s %14s %14s\n", "policy", "threads", "Mcycles/sec", "ns/cycle");
+  std::vector<std::pair<const char *, ReplacerType>> policies = {{"LRU", ReplacerType::kLRU},
+                                                                 {"CLOCK", ReplacerType::kClock}};
+  for (size_t num_threads = 1; num_threads <= max_threads; num_threads *= 2) {
+    for (auto &policy : policies) {
+      remove(db_name.c_str());
+      auto *disk_manager = new DiskManager(db_name);
+      auto *bpm = new BufferPoolManagerInstance(pool_size, disk_manager, policy.second);
+      // make every page resident, so that the threads only hit
+      page_id_t page_id;
+      for (size_t i = 0; i < pool_size; i++) {
+        bpm->NewPage(page_id);
+        bpm->UnpinPage(page_id, false);
+      }
+      double seconds = RunThreads(bpm, num_threads, pool_size, cycles);
+      double total = static_cast<double>(num_threads * cycles);
+      printf("%10s %8zu %14.2f %14.1f\n", policy.first, num_threads, total / seconds / 1e6, seconds * 1e9 / total);
+      delete bpm;
+      delete disk_manager;
+    }
+  }
+  remove(db_name.c_str());
+  return 0;
+}
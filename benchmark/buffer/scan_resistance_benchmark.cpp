@@ -0,0 +1,129 @@
+/**
+ * Mixed point-lookup and full-scan benchmark for the replacement policies.
+ *
+ * Builds a table heap far larger than the buffer pool and a B+ tree over part of its rows, sized so that the tree
+ * fits in half of the pool. The workload is a stream of index point lookups, each reading the row it finds through
+ * TableHeap::GetTuple, interrupted by full scans of the table through TableIterator. The hit ratio of the index pages
+ * shows how well each policy keeps the tree cached across the scans.
+ *
+ * usage: scan_resistance_benchmark [pool_size = 1024] [heap_pages = 8192] [rounds = 10] [index_stride = 8]
+ */
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/instance.h"
+#include "index/b_plus_tree.h"
+#include "index/basic_comparator.h"
+#include "page/table_page.h"
+#include "record/field.h"
+#include "record/schema.h"
+#include "storage/table_heap.h"
+#include "utils/bench_utils.h"
+#include "utils/mem_heap.h"
+
+namespace {
+
+constexpr page_owner_t kHeapOwner = 1;
+constexpr page_owner_t kIndexOwner = 2;
+constexpr int kSlotsPerPage = 1024;  // row ids are packed into the int values of the tree
+
+/** Append full pages to a chain of table pages, the way TableHeap grows, without rescanning the chain. */
+page_id_t BuildHeap(BufferPoolManager *bpm, Schema *schema, size_t heap_pages, std::vector<RowId> *rids) {
+  PageOwnerScope owner_scope(kHeapOwner);
+  page_id_t first_page_id;
+  auto *page = reinterpret_cast<TablePage *>(bpm->NewPage(first_page_id));
+  page->Init(first_page_id, INVALID_PAGE_ID, nullptr, nullptr);
+  char name[48];
+  for (size_t i = 0; i < heap_pages;) {
+    snprintf(name, sizeof(name), "row %zu", rids->size());
+    std::vector<Field> fields{Field(TypeId::kTypeInt, static_cast<int32_t>(rids->size())),
+                              Field(TypeId::kTypeChar, name, sizeof(name), true)};
+    Row row(fields);
+    if (page->InsertTuple(row, schema, nullptr, nullptr, nullptr)) {
+      rids->push_back(row.GetRowId());
+      continue;
+    }
+    if (++i == heap_pages) {
+      break;
+    }
+    page_id_t next_page_id;
+    auto *next_page = reinterpret_cast<TablePage *>(bpm->NewPage(next_page_id));
+    next_page->Init(next_page_id, page->GetTablePageId(), nullptr, nullptr);
+    page->SetNextPageId(next_page_id);
+    bpm->UnpinPage(page->GetTablePageId(), true);
+    page = next_page;
+  }
+  bpm->UnpinPage(page->GetTablePageId(), true);
+  return first_page_id;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  const size_t pool_size = BenchArg(argc, argv, 1, 1024);
+  const size_t heap_pages = BenchArg(argc, argv, 2, 8192);
+  const size_t rounds = BenchArg(argc, argv, 3, 10);
+  const size_t index_stride = BenchArg(argc, argv, 4, 8);
+  const size_t lookups_per_round = 20000;
+  const std::string db_name = "scan_resistance_benchmark.db";
+
+  SimpleMemHeap heap;
+  std::vector<Column *> columns = {ALLOC_COLUMN(heap)("id", TypeId::kTypeInt, 0, false, false),
+                                   ALLOC_COLUMN(heap)("name", TypeId::kTypeChar, 48, 1, true, false)};
+  auto schema = std::make_unique<Schema>(columns);
+
+  printf("pool %zu frames, heap %zu pages, every %zuth row indexed, %zu rounds of %zu lookups + 1 full scan\n",
+         pool_size, heap_pages, index_stride, rounds, lookups_per_round);
+  printf("%10s %12s %16s %16s %16s\n", "policy", "index pages", "index hit ratio", "index reads", "heap reads");
+  std::vector<std::pair<const char *, ReplacerType>> policies = {{"LRU", ReplacerType::kLRU},
+                                                                 {"LRU-K", ReplacerType::kLRUK}};
+  for (auto &policy : policies) {
+    DBStorageEngine engine(db_name, true, pool_size, policy.second);
+    std::vector<RowId> rids;
+    page_id_t first_page_id = BuildHeap(engine.bpm_, schema.get(), heap_pages, &rids);
+    TableHeap *table_heap = TableHeap::Create(engine.bpm_, first_page_id, schema.get(), nullptr, nullptr, &heap);
+    table_heap->SetOwner(kHeapOwner);
+    BasicComparator<int> comparator;
+    BPlusTree<int, int, BasicComparator<int>> tree(0, engine.bpm_, comparator);
+    tree.SetOwner(kIndexOwner);
+    auto *meta_page = reinterpret_cast<DiskFileMetaPage *>(engine.disk_mgr_->GetMetaData());
+    uint32_t allocated_pages = meta_page->GetAllocatedPages();
+    for (size_t i = 0; i < rids.size(); i += index_stride) {
+      tree.Insert(static_cast<int>(i), rids[i].GetPageId() * kSlotsPerPage + static_cast<int>(rids[i].GetSlotNum()));
+    }
+    size_t index_pages = meta_page->GetAllocatedPages() - allocated_pages;
+    engine.Checkpoint();
+
+    BenchRandom random;
+    uint64_t index_fetches = 0;
+    std::map<page_owner_t, PageOwnerStats> before = engine.bpm_->GetOwnerStats();
+    for (size_t round = 0; round < rounds; round++) {
+      uint64_t fetches = engine.bpm_->GetStats().fetches_;
+      std::vector<int> values;
+      for (size_t i = 0; i < lookups_per_round; i++) {
+        auto key = random.Uniform(0, static_cast<int32_t>((rids.size() - 1) / index_stride)) *
+                   static_cast<int32_t>(index_stride);
+        values.clear();
+        tree.GetValue(key, values);
+        Row row(RowId(values[0] / kSlotsPerPage, values[0] % kSlotsPerPage));
+        table_heap->GetTuple(&row, nullptr);
+      }
+      // every lookup fetched the heap page of its row once, the rest were index pages
+      index_fetches += engine.bpm_->GetStats().fetches_ - fetches - lookups_per_round;
+      // SELECT * reads every row of the heap
+      for (auto it = table_heap->Begin(nullptr); it != table_heap->End(); ++it) {
+      }
+    }
+    std::map<page_owner_t, PageOwnerStats> after = engine.bpm_->GetOwnerStats();
+    uint64_t index_reads = after[kIndexOwner].reads_ - before[kIndexOwner].reads_;
+    uint64_t heap_reads = after[kHeapOwner].reads_ - before[kHeapOwner].reads_;
+    printf("%10s %12zu %15.2f%% %16llu %16llu\n", policy.first, index_pages,
+           100.0 * (index_fetches - index_reads) / index_fetches, static_cast<unsigned long long>(index_reads),
+           static_cast<unsigned long long>(heap_reads));
+  }
+  remove(db_name.c_str());
+  return 0;
+}
@@ -0,0 +1,128 @@
+/**
+ * Time to steady-state hit ratio after a restart, with and without buffer pool warm-up.
+ *
+ * A skewed workload, most fetches going to a hot set scattered over the file, runs until the pool is warm, then the
+ * resident page set is saved and the pool is shut down. The file is dropped from the operating system page cache and
+ * a new pool runs the same workload, once cold and once warmed up from the saved page set by the prefetch thread.
+ * The benchmark reports how long the restarted pool takes to get back to the hit ratio it had before the restart.
+ * Every restart runs in a forked process, so that both start from the same state.
+ *
+ * usage: warmup_benchmark [db_pages = 16384] [pool_size = 4096] [window = 2000]
+ * note: the page cache can only be dropped on a disk backed filesystem, run the benchmark outside of tmpfs.
+ */
+#include <sys/wait.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "utils/bench_utils.h"
+
+namespace {
+
+/** 95% of the fetches go to a hot set of three quarters of the pool, spread evenly over the file. */
+class SkewedWorkload {
+ public:
+  SkewedWorkload(size_t db_pages, size_t pool_size) : db_pages_(db_pages), hot_pages_(pool_size * 3 / 4) {}
+
+  page_id_t Next() {
+    if (random_.Uniform(0, 99) < 95) {
+      return static_cast<page_id_t>(random_.Uniform(0, static_cast<int32_t>(hot_pages_) - 1) * (db_pages_ / hot_pages_));
+    }
+    return random_.Uniform(0, static_cast<int32_t>(db_pages_) - 1);
+  }
+
+ private:
+  size_t db_pages_;
+  size_t hot_pages_;
+  BenchRandom random_;
+};
+
+/** Run one window of fetches. @return the hit ratio of the window */
+double RunWindow(BufferPoolManager *bpm, SkewedWorkload *workload, size_t window) {
+  BufferPoolStats before = bpm->GetStats();
+  for (size_t i = 0; i < window; i++) {
+    page_id_t page_id = workload->Next();
+    bpm->FetchPage(page_id);
+    bpm->UnpinPage(page_id, false);
+  }
+  BufferPoolStats after = bpm->GetStats();
+  return static_cast<double>(after.hits_ - before.hits_) / static_cast<double>(after.fetches_ - before.fetches_);
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  const size_t db_pages = BenchArg(argc, argv, 1, 16384);
+  const size_t pool_size = BenchArg(argc, argv, 2, 4096);
+  const size_t window = BenchArg(argc, argv, 3, 2000);
+  const size_t max_windows = 1000;
+  const std::string db_name = "warmup_benchmark.db";
+  const std::string warmup_name = db_name + ".warmup";
+
+  remove(db_name.c_str());
+  double steady_hit_ratio = 0;
+  {
+    auto *disk_manager = new DiskManager(db_name);
+    auto *bpm = new BufferPoolManagerInstance(pool_size, disk_manager);
+    page_id_t page_id;
+    for (size_t i = 0; i < db_pages; i++) {
+      bpm->NewPage(page_id)->GetData()[0] = 1;
+      bpm->UnpinPage(page_id, true);
+    }
+    SkewedWorkload workload(db_pages, pool_size);
+    for (size_t i = 0; i < 20; i++) {
+      steady_hit_ratio = RunWindow(bpm, &workload, window * 5);
+    }
+    bpm->SaveResidentPages(warmup_name);
+    delete bpm;
+    delete disk_manager;
+  }
+
+  const double target = steady_hit_ratio * 0.98;
+  printf("%zu pages, pool %zu frames, steady hit ratio %.3f, target %.3f, windows of %zu fetches\n", db_pages,
+         pool_size, steady_hit_ratio, target, window);
+  printf("%8s %16s %18s %16s %16s\n", "warm-up", "first window hit", "fetches to target", "ms to target",
+         "prefetched");
+  for (bool warm_up : {false, true}) {
+    DropFileCache(db_name);
+    fflush(stdout);
+    if (fork() != 0) {
+      wait(nullptr);
+      continue;
+    }
+    auto *disk_manager = new DiskManager(db_name);
+    auto *bpm = new BufferPoolManagerInstance(pool_size, disk_manager);
+    BenchTimer timer;
+    size_t prefetched = 0;
+    if (warm_up) {
+      std::vector<page_id_t> page_ids = BufferPoolManager::LoadResidentPages(warmup_name);
+      page_ids.resize(std::min(page_ids.size(), pool_size));
+      std::sort(page_ids.begin(), page_ids.end());
+      prefetched = page_ids.size();
+      bpm->PrefetchPages(page_ids);
+    }
+    SkewedWorkload workload(db_pages, pool_size);
+    double first = 0;
+    size_t windows = 0;
+    while (windows < max_windows) {
+      double hit_ratio = RunWindow(bpm, &workload, window);
+      if (windows++ == 0) {
+        first = hit_ratio;
+      }
+      if (hit_ratio >= target) {
+        break;
+      }
+    }
+    printf("%8s %16.3f %18zu %16.1f %16zu\n", warm_up ? "on" : "off", first, windows * window,
+           timer.Seconds() * 1e3, prefetched);
+    delete bpm;
+    delete disk_manager;
+    return 0;
+  }
+  remove(db_name.c_str());
+  remove(warmup_name.c_str());
+  return 0;
+}
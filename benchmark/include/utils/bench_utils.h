@@ -0,0 +1,86 @@
+#ifndef MINISQL_BENCH_UTILS_H
+#define MINISQL_BENCH_UTILS_H
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * Wall clock timer used by the benchmarks.
+ */
+class BenchTimer {
+public:
+  BenchTimer() : start_(std::chrono::steady_clock::now()) {}
+
+  void Reset() { start_ = std::chrono::steady_clock::now(); }
+
+  /** @return elapsed time since construction or the last Reset() in seconds */
+  double Seconds() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+  }
+
+  /** @return elapsed time since construction or the last Reset() in nanoseconds */
+  double Nanos() const {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start_).count();
+  }
+
+private:
+  std::chrono::steady_clock::time_point start_;
+};
+
+/**
+ * Read an unsigned integer from argv[index], or return the default value if absent.
+ */
+inline size_t BenchArg(int argc, char **argv, int index, size_t default_value) {
+  if (index < argc) {
+    return std::strtoull(argv[index], nullptr, 10);
+  }
+  return default_value;
+}
+
+/**
+ * Powers of four in [low, high], the usual sweep of buffer pool sizes.
+ */
+inline std::vector<size_t> BenchSizes(size_t low, size_t high) {
+  std::vector<size_t> sizes;
+  for (size_t size = low; size <= high; size *= 4) {
+    sizes.push_back(size);
+  }
+  return sizes;
+}
+
+/**
+ * Write a file back and evict it from the operating system page cache, so that the next read of it goes to the disk.
+ */
+inline void DropFileCache(const std::string &file_name) {
+  int fd = open(file_name.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return;
+  }
+  fdatasync(fd);
+  posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+  close(fd);
+}
+
+/**
+ * Deterministic random page id stream, so that every run of a benchmark touches the same pages.
+ */
+class BenchRandom {
+public:
+  explicit BenchRandom(uint32_t seed = 15445) : rng_(seed) {}
+
+  /** @return uniform integer in [low, high] */
+  int32_t Uniform(int32_t low, int32_t high) {
+    return std::uniform_int_distribution<int32_t>(low, high)(rng_);
+  }
+
+private:
+  std::mt19937 rng_;
+};
+
+#endif  // MINISQL_BENCH_UTILS_H
@@ -0,0 +1,22 @@
+#!/bin/bash
+# Build page_size_benchmark once for every supported page size and print its results side by side.
+#
+# usage: benchmark/page_size_matrix.sh [page_size_benchmark arguments]
+# The builds go to build-page-<size> in the current directory, and the benchmark runs there too. BUILD_TYPE sets
+# their CMake build type, Debug by default.
+set -e
+
+source_dir=$(cd "$(dirname "$0")/.." && pwd)
+header=""
+rows=""
+for page_size in 4096 8192 16384 32768; do
+  build_dir="$(pwd)/build-page-${page_size}"
+  cmake -S "${source_dir}" -B "${build_dir}" -DCMAKE_BUILD_TYPE="${BUILD_TYPE:-Debug}" \
+    -DMINISQL_PAGE_SIZE=${page_size} > /dev/null
+  cmake --build "${build_dir}" --target page_size_benchmark -j"$(nproc)" > /dev/null
+  output=$("${build_dir}/benchmark/page_size_benchmark" "$@" 2> /dev/null)
+  header=$(echo "${output}" | head -n 2)
+  rows="${rows}$(echo "${output}" | tail -n 1)"$'\n'
+done
+echo "${header}"
+echo -n "${rows}"
@@ -0,0 +1,99 @@
+/**
+ * fio-style comparison of buffered and O_DIRECT page I/O through DiskManager on the same database file.
+ *
+ * The file is written once, then every mode runs the same job: each thread issues page reads or writes, random or
+ * sequential over its own slice of the file, and the benchmark reports IOPS, bandwidth and the mean latency like fio
+ * does. The page cache is dropped before each run so that buffered reads start cold as well. Buffered writes only
+ * reach the page cache, so every job ends with Sync to count the writeback.
+ *
+ * usage: direct_io_benchmark [rw = randread|randwrite|read|write] [file_pages = 65536] [operations_per_thread = 20000]
+ *                            [threads = 4]
+ * note: direct I/O needs a filesystem that supports O_DIRECT, on tmpfs both modes end up buffered.
+ */
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "storage/disk_manager.h"
+#include "utils/bench_utils.h"
+
+namespace {
+
+/** Run one job, @return the elapsed seconds. */
+double RunJob(DiskManager *disk_manager, const std::string &rw, size_t file_pages, size_t operations,
+              size_t num_threads) {
+  bool write = rw == "randwrite" || rw == "write";
+  bool random = rw == "randread" || rw == "randwrite";
+  size_t slice = file_pages / num_threads;
+  std::vector<std::thread> threads;
+  BenchTimer timer;
+  for (size_t t = 0; t < num_threads; t++) {
+    threads.emplace_back([=] {
+      BenchRandom rng(15445 + t);
+      alignas(DISK_IO_ALIGNMENT) char page[PAGE_SIZE];
+      memset(page, static_cast<int>(t), PAGE_SIZE);
+      for (size_t i = 0; i < operations; i++) {
+        size_t index = random ? rng.Uniform(0, static_cast<int32_t>(slice) - 1) : i % slice;
+        auto page_id = static_cast<page_id_t>(t * slice + index);
+        if (write) {
+          disk_manager->WritePage(page_id, page);
+        } else {
+          disk_manager->ReadPage(page_id, page);
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  if (write) {
+    disk_manager->Sync();
+  }
+  return timer.Seconds();
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  const std::string rw = argc > 1 ? argv[1] : "randread";
+  const size_t file_pages = BenchArg(argc, argv, 2, 65536);
+  const size_t operations = BenchArg(argc, argv, 3, 20000);
+  const size_t num_threads = std::max<size_t>(BenchArg(argc, argv, 4, 4), 1);
+  const std::string db_name = "direct_io_benchmark.db";
+  if (rw != "randread" && rw != "randwrite" && rw != "read" && rw != "write") {
+    fprintf(stderr, "unknown rw mode %s, use randread, randwrite, read or write\n", rw.c_str());
+    return 1;
+  }
+
+  remove(db_name.c_str());
+  {
+    DiskManager disk_manager(db_name);
+    std::vector<char> pages(64 * PAGE_SIZE, 1);
+    std::vector<std::pair<page_id_t, const char *>> batch;
+    for (size_t i = 0; i < file_pages; i += 64) {
+      batch.clear();
+      for (size_t j = i; j < std::min(i + 64, file_pages); j++) {
+        batch.emplace_back(static_cast<page_id_t>(j), pages.data() + (j - i) * PAGE_SIZE);
+      }
+      disk_manager.WritePages(batch);
+    }
+    disk_manager.Sync();
+  }
+
+  printf("rw=%s bs=%d file=%zu MB numjobs=%zu ops/job=%zu\n", rw.c_str(), PAGE_SIZE,
+         file_pages * PAGE_SIZE / (1 << 20), num_threads, operations);
+  printf("%10s %12s %12s %14s\n", "mode", "IOPS", "MB/sec", "avg lat usec");
+  for (bool direct : {false, true}) {
+    DropFileCache(db_name);
+    DiskManager disk_manager(db_name, direct);
+    double seconds = RunJob(&disk_manager, rw, file_pages, operations, num_threads);
+    double ios = static_cast<double>(operations * num_threads);
+    printf("%10s %12.0f %12.1f %14.1f\n", direct ? (disk_manager.IsDirectIO() ? "direct" : "fallback") : "buffered",
+           ios / seconds, ios * PAGE_SIZE / seconds / (1 << 20), seconds * num_threads / ios * 1e6);
+  }
+  remove(db_name.c_str());
+  return 0;
+}
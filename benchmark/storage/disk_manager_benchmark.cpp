@@ -0,0 +1,115 @@
+/**
+ * Random page read and write IOPS of DiskManager versus the fstream page file it used to be built on.
+ *
+ * The stream file is a copy of the old DiskManager I/O path: every read stats the file and seeks a shared fstream,
+ * every write seeks it and flushes, and all threads serialize on one lock. DiskManager uses pread and pwrite on one
+ * descriptor without a lock and knows the file size. Both work on the same file, which is written once up front, so
+ * the numbers are dominated by the syscalls and the lock rather than by the device.
+ *
+ * usage: disk_manager_benchmark [file_pages = 16384] [operations_per_thread = 100000] [max_threads = 4]
+ */
+#include <sys/stat.h>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "storage/disk_manager.h"
+#include "utils/bench_utils.h"
+
+namespace {
+
+/** The page I/O of the old fstream based DiskManager. */
+class StreamPageFile {
+public:
+  explicit StreamPageFile(const std::string &file_name) : file_name_(file_name) {
+    io_.open(file_name, std::ios::binary | std::ios::in | std::ios::out);
+  }
+
+  void ReadPage(page_id_t page_id, char *page_data) {
+    std::scoped_lock<std::mutex> lock(latch_);
+    int offset = page_id * PAGE_SIZE;
+    struct stat stat_buf {};
+    int size = stat(file_name_.c_str(), &stat_buf) == 0 ? stat_buf.st_size : -1;
+    if (offset >= size) {
+      memset(page_data, 0, PAGE_SIZE);
+      return;
+    }
+    io_.seekp(offset);
+    io_.read(page_data, PAGE_SIZE);
+  }
+
+  void WritePage(page_id_t page_id, const char *page_data) {
+    std::scoped_lock<std::mutex> lock(latch_);
+    io_.seekp(static_cast<size_t>(page_id) * PAGE_SIZE);
+    io_.write(page_data, PAGE_SIZE);
+    io_.flush();
+  }
+
+private:
+  std::string file_name_;
+  std::fstream io_;
+  std::mutex latch_;
+};
+
+/** @return operations per second of num_threads threads doing random page reads or writes */
+template <typename File>
+double RunThreads(File *file, size_t num_threads, size_t file_pages, size_t operations, bool write) {
+  std::vector<std::thread> threads;
+  BenchTimer timer;
+  for (size_t t = 0; t < num_threads; t++) {
+    threads.emplace_back([=] {
+      BenchRandom random(15445 + t);
+      char page[PAGE_SIZE] = {};
+      for (size_t i = 0; i < operations; i++) {
+        page_id_t page_id = random.Uniform(0, static_cast<int32_t>(file_pages) - 1);
+        if (write) {
+          file->WritePage(page_id, page);
+        } else {
+          file->ReadPage(page_id, page);
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  return num_threads * operations / timer.Seconds();
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  const size_t file_pages = BenchArg(argc, argv, 1, 16384);
+  const size_t operations = BenchArg(argc, argv, 2, 100000);
+  const size_t max_threads = BenchArg(argc, argv, 3, 4);
+  const std::string db_name = "disk_manager_benchmark.db";
+
+  remove(db_name.c_str());
+  {
+    DiskManager disk_manager(db_name);
+    char page[PAGE_SIZE] = {};
+    for (size_t i = 0; i < file_pages; i++) {
+      disk_manager.WritePage(static_cast<page_id_t>(i), page);
+    }
+    disk_manager.Sync();
+  }
+
+  printf("%zu pages, %zu operations per thread\n", file_pages, operations);
+  printf("%8s %8s %14s %14s %10s\n", "op", "threads", "fstream IOPS", "pread IOPS", "speedup");
+  for (bool write : {false, true}) {
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+      StreamPageFile stream_file(db_name);
+      double stream_iops = RunThreads(&stream_file, threads, file_pages, operations, write);
+      DiskManager disk_manager(db_name);
+      double pread_iops = RunThreads(&disk_manager, threads, file_pages, operations, write);
+      printf("%8s %8zu %14.0f %14.0f %9.2fx\n", write ? "write" : "read", threads, stream_iops, pread_iops,
+             pread_iops / stream_iops);
+    }
+  }
+  remove(db_name.c_str());
+  return 0;
+}
@@ -0,0 +1,172 @@
+/**
+ * Cold scans of tables and indexes that were loaded side by side, with and without page runs.
+ *
+ * Several table heaps are grown in turns, one page each, and several B+ trees are loaded in turns, one key each, so
+ * that without runs their pages end up interleaved in the file. With runs every object draws its pages from runs of
+ * contiguous pages of its own, see DiskManager::AllocatePageNear. The benchmark then drops the file from the
+ * operating system page cache and, with a fresh small buffer pool, runs a full scan of the first table through
+ * TableIterator and a range scan over all leaves of the first tree. It reports the time and the share of page steps
+ * that go to the physically next page. Every scan runs in a forked process, so that both start cold.
+ *
+ * usage: page_run_benchmark [heap_pages = 2048] [index_keys = 300000] [objects = 4] [pool_size = 256]
+ * note: the page cache can only be dropped on a disk backed filesystem, run the benchmark outside of tmpfs.
+ */
+#include <sys/wait.h>
+#include <unistd.h>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "index/b_plus_tree.h"
+#include "index/basic_comparator.h"
+#include "page/b_plus_tree_leaf_page.h"
+#include "page/table_page.h"
+#include "record/field.h"
+#include "record/schema.h"
+#include "storage/table_heap.h"
+#include "utils/bench_utils.h"
+#include "utils/mem_heap.h"
+
+namespace {
+
+using Tree = BPlusTree<int, int, BasicComparator<int>>;
+using LeafPage = BPlusTreeLeafPage<int, int, BasicComparator<int>>;
+
+/** Grow objects table heaps in turns, one full page at a time, the way TableHeap grows. @return the first pages */
+std::vector<page_id_t> BuildHeaps(BufferPoolManager *bpm, Schema *schema, size_t heap_pages, size_t objects) {
+  std::vector<TablePage *> pages(objects);
+  std::vector<page_id_t> first_page_ids(objects);
+  for (size_t t = 0; t < objects; t++) {
+    pages[t] = reinterpret_cast<TablePage *>(bpm->NewPageNear(first_page_ids[t], INVALID_PAGE_ID));
+    pages[t]->Init(first_page_ids[t], INVALID_PAGE_ID, nullptr, nullptr);
+  }
+  char name[48] = "row";
+  std::vector<Field> fields{Field(TypeId::kTypeInt, 0), Field(TypeId::kTypeChar, name, sizeof(name), true)};
+  Row row(fields);
+  for (size_t i = 1; i < heap_pages; i++) {
+    for (size_t t = 0; t < objects; t++) {
+      while (pages[t]->InsertTuple(row, schema, nullptr, nullptr, nullptr)) {
+      }
+      page_id_t next_page_id;
+      auto *next_page = reinterpret_cast<TablePage *>(bpm->NewPageNear(next_page_id, pages[t]->GetTablePageId()));
+      next_page->Init(next_page_id, pages[t]->GetTablePageId(), nullptr, nullptr);
+      pages[t]->SetNextPageId(next_page_id);
+      bpm->UnpinPage(pages[t]->GetTablePageId(), true);
+      pages[t] = next_page;
+    }
+  }
+  for (auto page : pages) {
+    bpm->UnpinPage(page->GetTablePageId(), true);
+  }
+  return first_page_ids;
+}
+
+/** Load objects B+ trees in turns, one ascending key at a time. @return the leftmost leaf of the first tree */
+page_id_t BuildTrees(BufferPoolManager *bpm, size_t index_keys, size_t objects) {
+  BasicComparator<int> comparator;
+  std::vector<std::unique_ptr<Tree>> trees;
+  for (size_t t = 0; t < objects; t++) {
+    trees.push_back(std::make_unique<Tree>(static_cast<index_id_t>(t), bpm, comparator));
+  }
+  for (size_t key = 0; key < index_keys; key++) {
+    for (auto &tree : trees) {
+      tree->Insert(static_cast<int>(key), static_cast<int>(key));
+    }
+  }
+  Page *leaf = trees[0]->FindLeafPage(0, true);
+  page_id_t leaf_page_id = leaf->GetPageId();
+  bpm->UnpinPage(leaf_page_id, false);
+  return leaf_page_id;
+}
+
+/** Count a step of a scan from one page to the next. */
+void CountStep(page_id_t *previous, page_id_t page_id, size_t *steps, size_t *adjacent) {
+  if (*previous != INVALID_PAGE_ID) {
+    (*steps)++;
+    *adjacent += page_id == *previous + 1;
+  }
+  *previous = page_id;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  const size_t heap_pages = BenchArg(argc, argv, 1, 2048);
+  const size_t index_keys = BenchArg(argc, argv, 2, 300000);
+  const size_t objects = std::max<size_t>(BenchArg(argc, argv, 3, 4), 1);
+  const size_t pool_size = BenchArg(argc, argv, 4, 256);
+  const std::string db_name = "page_run_benchmark.db";
+
+  SimpleMemHeap heap;
+  std::vector<Column *> columns = {ALLOC_COLUMN(heap)("id", TypeId::kTypeInt, 0, false, false),
+                                   ALLOC_COLUMN(heap)("name", TypeId::kTypeChar, 48, 1, true, false)};
+  auto schema = std::make_unique<Schema>(columns);
+
+  printf("%zu tables of %zu pages and %zu trees of %zu keys loaded in turns, pool %zu frames\n", objects, heap_pages,
+         objects, index_keys, pool_size);
+  printf("%6s %12s %12s %12s %12s\n", "runs", "scan", "seconds", "MB/sec", "adjacent");
+  for (bool runs : {false, true}) {
+    remove(db_name.c_str());
+    std::vector<page_id_t> first_page_ids;
+    page_id_t first_leaf_id;
+    {
+      auto *disk_manager = new DiskManager(db_name);
+      disk_manager->SetPageRuns(runs);
+      auto *bpm = new BufferPoolManagerInstance(1024, disk_manager);
+      // the catalog meta page and the index roots page, as DBStorageEngine allocates them
+      page_id_t page_id;
+      for (int i = 0; i < 2; i++) {
+        bpm->NewPage(page_id);
+        bpm->UnpinPage(page_id, true);
+      }
+      first_page_ids = BuildHeaps(bpm, schema.get(), heap_pages, objects);
+      first_leaf_id = BuildTrees(bpm, index_keys, objects);
+      delete bpm;
+      delete disk_manager;
+    }
+
+    for (bool leaves : {false, true}) {
+      DropFileCache(db_name);
+      fflush(stdout);
+      if (fork() != 0) {
+        wait(nullptr);
+        continue;
+      }
+      auto *disk_manager = new DiskManager(db_name);
+      auto *bpm = new BufferPoolManagerInstance(pool_size, disk_manager);
+      size_t pages = 0;
+      size_t steps = 0;
+      size_t adjacent = 0;
+      page_id_t previous = INVALID_PAGE_ID;
+      BenchTimer timer;
+      if (!leaves) {
+        TableHeap *table_heap = TableHeap::Create(bpm, first_page_ids[0], schema.get(), nullptr, nullptr, &heap);
+        for (auto it = table_heap->Begin(nullptr); it != table_heap->End(); ++it) {
+          if (it->GetRowId().GetPageId() != previous) {
+            pages++;
+            CountStep(&previous, it->GetRowId().GetPageId(), &steps, &adjacent);
+          }
+        }
+      } else {
+        for (page_id_t page_id = first_leaf_id; page_id != INVALID_PAGE_ID;) {
+          auto *leaf = reinterpret_cast<LeafPage *>(bpm->FetchPage(page_id)->GetData());
+          pages++;
+          CountStep(&previous, page_id, &steps, &adjacent);
+          page_id_t next_page_id = leaf->GetNextPageId();
+          bpm->UnpinPage(page_id, false);
+          page_id = next_page_id;
+        }
+      }
+      double seconds = timer.Seconds();
+      printf("%6s %12s %12.3f %12.1f %11.1f%%\n", runs ? "on" : "off", leaves ? "leaves" : "table", seconds,
+             pages * PAGE_SIZE / seconds / (1 << 20), steps == 0 ? 100.0 : 100.0 * adjacent / steps);
+      delete bpm;
+      delete disk_manager;
+      return 0;
+    }
+  }
+  remove(db_name.c_str());
+  return 0;
+}
@@ -0,0 +1,144 @@
+/**
+ * Scan throughput, B+ tree fanout and point lookup latency at the page size of the build, see MINISQL_PAGE_SIZE.
+ *
+ * The page size is fixed at compile time, so one run measures one page size and benchmark/page_size_matrix.sh builds
+ * and runs the benchmark once for every supported size. To compare like with like, the table and the buffer pool are
+ * given in megabytes rather than pages.
+ *
+ * The benchmark loads a table heap and a B+ tree of int keys into one database. It then shrinks the pool, drops the
+ * file from the operating system page cache and looks up random keys, reporting the mean latency and the pages the
+ * pool fetched and missed per lookup. Last it scans the whole table cold through TableIterator with a fresh pool, with
+ * the default read-ahead window.
+ *
+ * usage: page_size_benchmark [table_mb = 128] [index_keys = 1000000] [lookups = 20000] [pool_mb = 4]
+ * note: the page cache can only be dropped on a disk backed filesystem, run the benchmark outside of tmpfs.
+ */
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "index/b_plus_tree.h"
+#include "index/basic_comparator.h"
+#include "page/table_page.h"
+#include "record/field.h"
+#include "record/schema.h"
+#include "storage/table_heap.h"
+#include "utils/bench_utils.h"
+#include "utils/mem_heap.h"
+
+namespace {
+
+using Tree = BPlusTree<int, int, BasicComparator<int>>;
+using LeafPage = BPlusTreeLeafPage<int, int, BasicComparator<int>>;
+
+/** @return the keys a leaf page holds, see LEAF_PAGE_SIZE */
+template <typename KeyType, typename ValueType>
+constexpr size_t LeafCapacity() {
+  return LEAF_PAGE_SIZE;
+}
+
+/** @return the children an internal page holds, see INTERNAL_PAGE_SIZE */
+template <typename KeyType, typename ValueType = page_id_t>
+constexpr size_t InternalCapacity() {
+  return INTERNAL_PAGE_SIZE;
+}
+
+/** Grow a table heap one full page at a time, the way TableHeap grows. @return the first page */
+page_id_t BuildHeap(BufferPoolManager *bpm, Schema *schema, size_t heap_pages) {
+  page_id_t first_page_id;
+  auto *page = reinterpret_cast<TablePage *>(bpm->NewPageNear(first_page_id, INVALID_PAGE_ID));
+  page->Init(first_page_id, INVALID_PAGE_ID, nullptr, nullptr);
+  char name[48] = "row";
+  std::vector<Field> fields{Field(TypeId::kTypeInt, 0), Field(TypeId::kTypeChar, name, sizeof(name), true)};
+  Row row(fields);
+  for (size_t i = 1; i < heap_pages; i++) {
+    while (page->InsertTuple(row, schema, nullptr, nullptr, nullptr)) {
+    }
+    page_id_t next_page_id;
+    auto *next_page = reinterpret_cast<TablePage *>(bpm->NewPageNear(next_page_id, page->GetTablePageId()));
+    next_page->Init(next_page_id, page->GetTablePageId(), nullptr, nullptr);
+    page->SetNextPageId(next_page_id);
+    bpm->UnpinPage(page->GetTablePageId(), true);
+    page = next_page;
+  }
+  bpm->UnpinPage(page->GetTablePageId(), true);
+  return first_page_id;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  const size_t table_mb = BenchArg(argc, argv, 1, 128);
+  const size_t index_keys = BenchArg(argc, argv, 2, 1000000);
+  const size_t lookups = BenchArg(argc, argv, 3, 20000);
+  const size_t pool_mb = BenchArg(argc, argv, 4, 4);
+  const std::string db_name = "page_size_benchmark.db";
+  const size_t heap_pages = (table_mb << 20) / PAGE_SIZE;
+  const size_t pool_size = std::max<size_t>((pool_mb << 20) / PAGE_SIZE, 16);
+
+  SimpleMemHeap heap;
+  std::vector<Column *> columns = {ALLOC_COLUMN(heap)("id", TypeId::kTypeInt, 0, false, false),
+                                   ALLOC_COLUMN(heap)("name", TypeId::kTypeChar, 48, 1, true, false)};
+  auto schema = std::make_unique<Schema>(columns);
+
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new BufferPoolManagerInstance(4 * pool_size, disk_manager);
+  page_id_t first_page_id = BuildHeap(bpm, schema.get(), heap_pages);
+  BasicComparator<int> comparator;
+  Tree tree(0, bpm, comparator);
+  for (size_t key = 0; key < index_keys; key++) {
+    tree.Insert(static_cast<int>(key), static_cast<int>(key));
+  }
+  size_t leaves = 0;
+  Page *leaf = tree.FindLeafPage(0, true);
+  for (page_id_t page_id = leaf->GetPageId(); page_id != INVALID_PAGE_ID; leaves++) {
+    auto *leaf_page = reinterpret_cast<LeafPage *>(bpm->FetchPage(page_id)->GetData());
+    page_id_t next_page_id = leaf_page->GetNextPageId();
+    bpm->UnpinPage(page_id, false);
+    page_id = next_page_id;
+  }
+  bpm->UnpinPage(leaf->GetPageId(), false);
+
+  bpm->FlushAllPages();
+  bpm->ResizePool(pool_size);
+  DropFileCache(db_name);
+  BenchRandom random(15445);
+  std::vector<int> result;
+  BufferPoolStats before = bpm->GetStats();
+  BenchTimer lookup_timer;
+  for (size_t i = 0; i < lookups; i++) {
+    result.clear();
+    tree.GetValue(random.Uniform(0, static_cast<int32_t>(index_keys) - 1), result);
+  }
+  double lookup_seconds = lookup_timer.Seconds();
+  BufferPoolStats after = bpm->GetStats();
+  delete bpm;
+  delete disk_manager;
+
+  DropFileCache(db_name);
+  disk_manager = new DiskManager(db_name);
+  bpm = new BufferPoolManagerInstance(pool_size, disk_manager);
+  TableHeap *table_heap = TableHeap::Create(bpm, first_page_id, schema.get(), nullptr, nullptr, &heap);
+  size_t rows = 0;
+  BenchTimer scan_timer;
+  for (auto it = table_heap->Begin(nullptr); it != table_heap->End(); ++it) {
+    rows++;
+  }
+  double scan_seconds = scan_timer.Seconds();
+  delete bpm;
+  delete disk_manager;
+  remove(db_name.c_str());
+
+  printf("table %zu MB, %zu index keys, %zu lookups, pool %zu MB\n", table_mb, index_keys, lookups, pool_mb);
+  printf("%9s %8s %8s %8s %10s %12s %11s %13s %13s\n", "page size", "leaf", "internal", "leaves", "rows/page",
+         "scan MB/sec", "lookup usec", "fetch/lookup", "miss/lookup");
+  printf("%9d %8zu %8zu %8zu %10zu %12.1f %11.2f %13.2f %13.2f\n", PAGE_SIZE, LeafCapacity<int, int>(),
+         InternalCapacity<int>(), leaves, rows / heap_pages, heap_pages * PAGE_SIZE / scan_seconds / (1 << 20),
+         lookup_seconds / lookups * 1e6, static_cast<double>(after.fetches_ - before.fetches_) / lookups,
+         static_cast<double>(after.misses_ - before.misses_) / lookups);
+  return 0;
+}
@@ -0,0 +1,87 @@
+/**
+ * Scan throughput of a database kept in one file versus split into segment files.
+ *
+ * Both layouts get the same pages, written in batches, and are then read back cold: a sequential scan in batches
+ * through ReadPages, the way a table scan prefetches, and random single page reads. The page cache is dropped before
+ * each run. Segments are small by default so that the scan crosses many of them, a segmented database should read as
+ * fast as one file.
+ *
+ * usage: segment_benchmark [file_pages = 65536] [segment_mb = 16] [batch_pages = 64] [random_reads = 20000]
+ */
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "storage/disk_manager.h"
+#include "utils/bench_utils.h"
+
+namespace {
+
+/** Write the segment files back and evict them from the operating system page cache. */
+void DropSegmentCaches(DiskManager *disk_manager, const std::string &db_name) {
+  for (size_t segment = 0; segment < disk_manager->GetSegmentCount(); segment++) {
+    DropFileCache(segment == 0 ? db_name : db_name + "." + std::to_string(segment));
+  }
+}
+
+void RemoveDatabase(const std::string &db_name) {
+  remove(db_name.c_str());
+  for (size_t segment = 1; remove((db_name + "." + std::to_string(segment)).c_str()) == 0; segment++) {
+  }
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  const size_t file_pages = BenchArg(argc, argv, 1, 65536);
+  const int64_t segment_size = static_cast<int64_t>(BenchArg(argc, argv, 2, 16)) << 20;
+  const size_t batch_pages = std::max<size_t>(BenchArg(argc, argv, 3, 64), 1);
+  const size_t random_reads = BenchArg(argc, argv, 4, 20000);
+  const std::string db_name = "segment_benchmark.db";
+
+  printf("%zu pages (%zu MB), batches of %zu pages, %zu random reads\n", file_pages,
+         file_pages * PAGE_SIZE / (1 << 20), batch_pages, random_reads);
+  printf("%10s %10s %14s %16s\n", "layout", "segments", "scan MB/sec", "random reads/sec");
+  for (int64_t size : {static_cast<int64_t>(0), segment_size}) {
+    RemoveDatabase(db_name);
+    auto *disk_manager = new DiskManager(db_name, false, false, size);
+    std::vector<char> data(batch_pages * PAGE_SIZE, 1);
+    std::vector<std::pair<page_id_t, const char *>> writes;
+    for (size_t i = 0; i < file_pages; i += batch_pages) {
+      writes.clear();
+      for (size_t j = i; j < std::min(i + batch_pages, file_pages); j++) {
+        writes.emplace_back(static_cast<page_id_t>(j), data.data() + (j - i) * PAGE_SIZE);
+      }
+      disk_manager->WritePages(writes);
+    }
+    disk_manager->Sync();
+    size_t segments = disk_manager->GetSegmentCount();
+    DropSegmentCaches(disk_manager, db_name);
+
+    std::vector<char> buffer(batch_pages * PAGE_SIZE);
+    std::vector<std::pair<page_id_t, char *>> reads;
+    BenchTimer scan_timer;
+    for (size_t i = 0; i < file_pages; i += batch_pages) {
+      reads.clear();
+      for (size_t j = i; j < std::min(i + batch_pages, file_pages); j++) {
+        reads.emplace_back(static_cast<page_id_t>(j), buffer.data() + (j - i) * PAGE_SIZE);
+      }
+      disk_manager->ReadPages(reads);
+    }
+    double scan_seconds = scan_timer.Seconds();
+    DropSegmentCaches(disk_manager, db_name);
+
+    BenchRandom random(15445);
+    BenchTimer random_timer;
+    for (size_t i = 0; i < random_reads; i++) {
+      disk_manager->ReadPage(random.Uniform(0, static_cast<int32_t>(file_pages) - 1), buffer.data());
+    }
+    double random_seconds = random_timer.Seconds();
+    printf("%10s %10zu %14.1f %16.0f\n", size == 0 ? "one file" : "segmented", segments,
+           file_pages * PAGE_SIZE / scan_seconds / (1 << 20), random_reads / random_seconds);
+    delete disk_manager;
+  }
+  RemoveDatabase(db_name);
+  return 0;
+}
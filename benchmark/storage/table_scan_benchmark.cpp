@@ -0,0 +1,110 @@
+/**
+ * Cold-cache full table scan with and without read-ahead.
+ *
+ * Builds a table heap of the given number of pages, drops the data file from the operating system page cache and
+ * scans the table through TableIterator with a fresh, small buffer pool. With read-ahead the pool prefetches the
+ * pages ahead of the scan, without it every page is one synchronous read. Every scan runs in a forked process, so
+ * that the allocator state a scan leaves behind does not skew the next one.
+ *
+ * usage: table_scan_benchmark [heap_pages = 4096] [pool_size = 256] [read_ahead_window = 32]
+ * note: the page cache can only be dropped on a disk backed filesystem, run the benchmark outside of tmpfs.
+ */
+#include <sys/wait.h>
+#include <unistd.h>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "page/table_page.h"
+#include "record/field.h"
+#include "record/schema.h"
+#include "storage/table_heap.h"
+#include "utils/bench_utils.h"
+#include "utils/mem_heap.h"
+
+namespace {
+
+/** Append full pages to a chain of table pages, the way TableHeap grows, without rescanning the chain. */
+page_id_t BuildHeap(BufferPoolManager *bpm, Schema *schema, size_t heap_pages, size_t *rows) {
+  page_id_t first_page_id;
+  auto *page = reinterpret_cast<TablePage *>(bpm->NewPage(first_page_id));
+  page->Init(first_page_id, INVALID_PAGE_ID, nullptr, nullptr);
+  char name[48];
+  for (size_t i = 0; i < heap_pages;) {
+    snprintf(name, sizeof(name), "row %zu", *rows);
+    std::vector<Field> fields{Field(TypeId::kTypeInt, static_cast<int32_t>(*rows)),
+                              Field(TypeId::kTypeChar, name, sizeof(name), true)};
+    Row row(fields);
+    if (page->InsertTuple(row, schema, nullptr, nullptr, nullptr)) {
+      (*rows)++;
+      continue;
+    }
+    if (++i == heap_pages) {
+      break;
+    }
+    page_id_t next_page_id;
+    auto *next_page = reinterpret_cast<TablePage *>(bpm->NewPage(next_page_id));
+    next_page->Init(next_page_id, page->GetTablePageId(), nullptr, nullptr);
+    page->SetNextPageId(next_page_id);
+    bpm->UnpinPage(page->GetTablePageId(), true);
+    page = next_page;
+  }
+  bpm->UnpinPage(page->GetTablePageId(), true);
+  return first_page_id;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  const size_t heap_pages = BenchArg(argc, argv, 1, 4096);
+  const size_t pool_size = BenchArg(argc, argv, 2, 256);
+  const size_t window = BenchArg(argc, argv, 3, 32);
+  const std::string db_name = "table_scan_benchmark.db";
+
+  SimpleMemHeap heap;
+  std::vector<Column *> columns = {ALLOC_COLUMN(heap)("id", TypeId::kTypeInt, 0, false, false),
+                                   ALLOC_COLUMN(heap)("name", TypeId::kTypeChar, 48, 1, true, false)};
+  auto schema = std::make_unique<Schema>(columns);
+
+  remove(db_name.c_str());
+  size_t rows = 0;
+  page_id_t first_page_id;
+  {
+    auto *disk_manager = new DiskManager(db_name);
+    auto *bpm = new BufferPoolManagerInstance(1024, disk_manager);
+    first_page_id = BuildHeap(bpm, schema.get(), heap_pages, &rows);
+    delete bpm;
+    delete disk_manager;
+  }
+
+  printf("%zu heap pages, %zu rows, pool %zu frames\n", heap_pages, rows, pool_size);
+  printf("%12s %12s %12s %14s\n", "read-ahead", "seconds", "MB/sec", "rows scanned");
+  for (size_t read_ahead : {static_cast<size_t>(0), window}) {
+    DropFileCache(db_name);
+    fflush(stdout);
+    if (fork() != 0) {
+      wait(nullptr);
+      continue;
+    }
+    auto *disk_manager = new DiskManager(db_name);
+    auto *bpm = new BufferPoolManagerInstance(pool_size, disk_manager);
+    bpm->SetReadAheadWindow(read_ahead);
+    TableHeap *table_heap = TableHeap::Create(bpm, first_page_id, schema.get(), nullptr, nullptr, &heap);
+
+    BenchTimer timer;
+    size_t scanned = 0;
+    for (auto it = table_heap->Begin(nullptr); it != table_heap->End(); ++it) {
+      scanned++;
+    }
+    double seconds = timer.Seconds();
+    printf("%12zu %12.3f %12.1f %14zu\n", read_ahead, seconds, heap_pages * PAGE_SIZE / seconds / (1 << 20),
+           scanned);
+    delete bpm;
+    delete disk_manager;
+    return 0;
+  }
+  remove(db_name.c_str());
+  return 0;
+}
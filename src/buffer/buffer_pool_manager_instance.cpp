@@ -0,0 +1,896 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "glog/logging.h"
+#include "page/bitmap_page.h"
+
+namespace {
+
+Replacer *CreateReplacer(ReplacerType replacer_type, size_t pool_size) {
+  switch (replacer_type) {
+    case ReplacerType::kLRUK:
+      return new LRUKReplacer(pool_size);
+    case ReplacerType::kClock:
+      return new ClockReplacer(pool_size);
+    case ReplacerType::kLRU:
+    default:
+      return new LRUReplacer(pool_size);
+  }
+}
+
+}  // namespace
+
+BufferPoolManagerInstance::BufferPoolManagerInstance(size_t pool_size, DiskManager *disk_manager,
+                                                     ReplacerType replacer_type)
+    : BufferPoolManagerInstance(pool_size, 1, 0, disk_manager, replacer_type) {}
+
+BufferPoolManagerInstance::BufferPoolManagerInstance(size_t pool_size, uint32_t num_instances,
+                                                     uint32_t instance_index, DiskManager *disk_manager,
+                                                     ReplacerType replacer_type)
+    : pool_size_(pool_size),
+      num_instances_(num_instances),
+      instance_index_(instance_index),
+      frames_(pool_size, BUFFER_POOL_HUGE_PAGES, BUFFER_POOL_MAX_SIZE),
+      disk_manager_(disk_manager),
+      compressed_cache_(COMPRESSED_CACHE_SIZE / num_instances),
+      retiring_from_(pool_size),
+      frame_quota_(frames_.GetMaxFrames()) {
+  ASSERT(instance_index < num_instances, "Instance index out of range.");
+  replacer_ = new PriorityReplacer(CreateReplacer(replacer_type, pool_size_), CreateReplacer(replacer_type, pool_size_),
+                                   pool_size_);
+  page_table_.reserve(pool_size_);
+  for (size_t i = 0; i < pool_size_; i++) {
+    free_list_.emplace_back(i);
+  }
+}
+
+BufferPoolManagerInstance::~BufferPoolManagerInstance() {
+  StopPrefetcher();
+  StopPageCleaner();
+  FlushAllPages();
+  delete replacer_;
+}
+
+// 1.     Search the page table for the requested page (P).
+// 1.1    If P exists, pin it and return it immediately.
+// 1.2    If P does not exist, find a replacement page (R) from either the free list or the replacer.
+//        Note that pages are always found from the free list first.
+// 2.     If R is dirty, write it back to the disk.
+// 3.     Delete R from the page table and insert P.
+// 4.     Update P's metadata, take the page content from the compressed page cache or read it in from disk, and then
+//        return a pointer to P.
+Page *BufferPoolManagerInstance::FetchPage(page_id_t page_id) {
+  std::unique_lock<std::mutex> lock(latch_);
+  bool read = false;
+  Page *result = PinPage(page_id, &lock, &read);
+  if (read) {
+    disk_manager_->ReadPage(page_id, result->GetData());
+  }
+  return result;
+}
+
+// 1.   Pin every page as FetchPage does, collecting the pages that have to be read from disk.
+// 2.   Read them with one batch, the latch is held just as FetchPage holds it for its read.
+std::vector<Page *> BufferPoolManagerInstance::FetchPages(const std::vector<page_id_t> &page_ids) {
+  std::unique_lock<std::mutex> lock(latch_);
+  std::vector<Page *> pages;
+  std::vector<std::pair<page_id_t, char *>> reads;
+  pages.reserve(page_ids.size());
+  for (auto page_id : page_ids) {
+    bool read = false;
+    Page *page = PinPage(page_id, &lock, &read);
+    if (read) {
+      reads.emplace_back(page_id, page->GetData());
+    }
+    pages.push_back(page);
+  }
+  disk_manager_->ReadPages(reads);
+  return pages;
+}
+
+Page *BufferPoolManagerInstance::PinPage(page_id_t page_id, std::unique_lock<std::mutex> *lock, bool *read) {
+  ASSERT(page_id % num_instances_ == instance_index_, "Page does not belong to this instance.");
+  Count(fetches_);
+  if (prefetching_.count(page_id) != 0) {
+    // wait for a read that is already in flight, read a page that is only queued ourselves
+    prefetch_cv_.wait(*lock, [&] { return prefetch_reading_.count(page_id) == 0; });
+    prefetching_.erase(page_id);
+  }
+  auto it = page_table_.find(page_id);
+  if (it != page_table_.end()) {
+    frame_id_t frame_id = it->second;
+    if (frames_.PinCount(frame_id)++ == 0) {
+      FramePinned();
+    }
+    replacer_->Pin(frame_id);
+    Count(hits_);
+    if (PageOwnerScope::Current() != INVALID_PAGE_OWNER) {
+      frames_.Owner(frame_id) = PageOwnerScope::Current();
+    }
+    return frames_.GetPage(frame_id);
+  }
+
+  frame_id_t frame_id;
+  if (!AcquireFrame(&frame_id)) {
+    Count(failed_fetches_);
+    return nullptr;
+  }
+  BindFrame(frame_id, page_id);
+  replacer_->Pin(frame_id);
+  FramePinned();
+  Count(misses_);
+
+  Page *result = frames_.GetPage(frame_id);
+  frames_.PageId(frame_id) = page_id;
+  frames_.PinCount(frame_id) = 1;
+  frames_.IsDirty(frame_id) = false;
+  frames_.Owner(frame_id) = PageOwnerScope::Current();
+  // the latest version of the page may still sit in the page cleaner's queue
+  SettleWriteback(page_id, true);
+  *read = !compressed_cache_.Take(page_id, result->GetData());
+  if (*read) {
+    owner_stats_[frames_.Owner(frame_id)].reads_++;
+  }
+  return result;
+}
+
+// 0.   Make sure you call AllocatePage!
+// 1.   If all the pages in the buffer pool are pinned, return nullptr.
+// 2.   Pick a victim page P from either the free list or the replacer. Always pick from the free list first.
+// 3.   Update P's metadata, zero out memory and add P to the page table.
+// 4.   Set the page ID output parameter. Return a pointer to P.
+Page *BufferPoolManagerInstance::NewPage(page_id_t &page_id) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  ASSERT(num_instances_ == 1, "Shards of a parallel buffer pool get their page ids from InstallNewPage.");
+  frame_id_t frame_id;
+  if (!AcquireFrame(&frame_id)) {
+    Count(failed_fetches_);
+    return nullptr;
+  }
+  page_id = AllocatePage();
+  DropStalePage(page_id);
+  BindFrame(frame_id, page_id);
+  replacer_->Pin(frame_id);
+  FramePinned();
+  Count(new_pages_);
+
+  Page *result = frames_.GetPage(frame_id);
+  frames_.PageId(frame_id) = page_id;
+  frames_.PinCount(frame_id) = 1;
+  frames_.IsDirty(frame_id) = false;
+  frames_.Owner(frame_id) = PageOwnerScope::Current();
+  result->ResetMemory();
+  return result;
+}
+
+Page *BufferPoolManagerInstance::NewPageNear(page_id_t &page_id, page_id_t near_page_id) {
+  ASSERT(num_instances_ == 1, "Shards of a parallel buffer pool get their page ids from InstallNewPage.");
+  page_id = disk_manager_->AllocatePageNear(near_page_id);
+  if (page_id == INVALID_PAGE_ID) {
+    return nullptr;
+  }
+  Page *result = InstallNewPage(page_id);
+  if (result == nullptr) {
+    DeallocatePage(page_id);
+    page_id = INVALID_PAGE_ID;
+  }
+  return result;
+}
+
+Page *BufferPoolManagerInstance::InstallNewPage(page_id_t page_id) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  ASSERT(page_id % num_instances_ == instance_index_, "Page does not belong to this instance.");
+  frame_id_t frame_id;
+  if (!AcquireFrame(&frame_id)) {
+    Count(failed_fetches_);
+    return nullptr;
+  }
+  DropStalePage(page_id);
+  BindFrame(frame_id, page_id);
+  replacer_->Pin(frame_id);
+  FramePinned();
+  Count(new_pages_);
+
+  Page *result = frames_.GetPage(frame_id);
+  frames_.PageId(frame_id) = page_id;
+  frames_.PinCount(frame_id) = 1;
+  frames_.IsDirty(frame_id) = false;
+  frames_.Owner(frame_id) = PageOwnerScope::Current();
+  result->ResetMemory();
+  return result;
+}
+
+// 0.   Make sure you call DeallocatePage!
+// 1.   Search the page table for the requested page (P).
+// 2.   If P exists, but has a non-zero pin-count, return false. Someone is using the page.
+// 3.   Otherwise, if P exists, remove P from the page table, reset its metadata and return it to the free list.
+// 4.   Resident or not, drop any pending writeback of P and deallocate it on disk.
+bool BufferPoolManagerInstance::DeletePage(page_id_t page_id) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  prefetching_.erase(page_id);
+  compressed_cache_.Erase(page_id);
+  cached_pages_.erase(page_id);
+  auto it = page_table_.find(page_id);
+  if (it != page_table_.end()) {
+    frame_id_t frame_id = it->second;
+    if (frames_.PinCount(frame_id) != 0) return false;
+    page_table_.erase(it);
+    frames_.PageId(frame_id) = INVALID_PAGE_ID;
+    frames_.IsDirty(frame_id) = false;
+    ReleaseFrame(frame_id);
+  }
+
+  SettleWriteback(page_id, false);
+  DeallocatePage(page_id);
+  Count(deleted_pages_);
+  return true;
+}
+
+bool BufferPoolManagerInstance::UnpinPage(page_id_t page_id, bool is_dirty) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  auto it = page_table_.find(page_id);
+  if (it == page_table_.end()) return false;
+  frame_id_t frame_id = it->second;
+  if (frames_.PinCount(frame_id) <= 0) {
+    return false;
+  }
+  if (--frames_.PinCount(frame_id) == 0) {
+    Count(pinned_frames_, -1);
+    if (static_cast<size_t>(frame_id) < retiring_from_) {
+      replacer_->Unpin(frame_id);
+    } else {
+      unpin_cv_.notify_all();
+    }
+  }
+  if (is_dirty) frames_.IsDirty(frame_id) = true;
+  return true;
+}
+
+bool BufferPoolManagerInstance::FlushPage(page_id_t page_id) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  if (page_id == INVALID_PAGE_ID) return false;
+  auto it = page_table_.find(page_id);
+  if (it == page_table_.end()) return false;
+  SettleWriteback(page_id, false);
+  disk_manager_->WritePage(page_id, frames_.GetData(it->second));
+  ChargeWrite(it->second);
+  frames_.IsDirty(it->second) = false;
+  return true;
+}
+
+void BufferPoolManagerInstance::FlushAllPages() {
+  FlushBatch batch;
+  CollectFlushBatch(&batch);
+  disk_manager_->WritePages(batch.pages_);
+  disk_manager_->Sync();
+}
+
+void BufferPoolManagerInstance::CollectFlushBatch(FlushBatch *batch) {
+  batch->latches_.emplace_back(latch_);
+  batch->latches_.emplace_back(writeback_latch_);
+  for (size_t i = 0; i < pool_size_; i++) {
+    auto frame_id = static_cast<frame_id_t>(i);
+    if (frames_.PageId(frame_id) == INVALID_PAGE_ID || !frames_.IsDirty(frame_id)) {
+      continue;
+    }
+    // the frame is newer than any cleaner copy of the page
+    pending_writebacks_.erase(frames_.PageId(frame_id));
+    batch->pages_.emplace_back(frames_.PageId(frame_id), frames_.GetData(frame_id));
+    ChargeWrite(frame_id);
+    frames_.IsDirty(frame_id) = false;
+  }
+  for (auto &pending : pending_writebacks_) {
+    batch->pages_.emplace_back(pending.first, pending.second.get());
+    batch->copies_.push_back(std::move(pending.second));
+  }
+  pending_writebacks_.clear();
+}
+
+bool BufferPoolManagerInstance::AcquireFrame(frame_id_t *frame_id) {
+  if (!free_list_.empty() && resident_pages_.load(std::memory_order_relaxed) < frame_quota_) {
+    *frame_id = free_list_.front();
+    free_list_.pop_front();
+    Count(resident_pages_);
+    return true;
+  }
+  return EvictFrame(frame_id);
+}
+
+bool BufferPoolManagerInstance::EvictFrame(frame_id_t *frame_id) {
+  if (!replacer_->Victim(frame_id)) {
+    return false;
+  }
+  Count(evictions_);
+  if (replacer_->IsProtected(*frame_id)) {
+    Count(cached_evictions_);
+  }
+  // the victim frame still holds its old page, write it back if needed and drop its mapping
+  page_id_t victim_page_id = frames_.PageId(*frame_id);
+  if (frames_.IsDirty(*frame_id)) {
+    SettleWriteback(victim_page_id, false);
+    disk_manager_->WritePage(victim_page_id, frames_.GetData(*frame_id));
+    ChargeWrite(*frame_id);
+    Count(foreground_writebacks_);
+    // the cleaner fell behind, wake it up
+    cleaner_cv_.notify_one();
+  }
+  compressed_cache_.Insert(victim_page_id, frames_.GetData(*frame_id));
+  page_table_.erase(victim_page_id);
+  return true;
+}
+
+void BufferPoolManagerInstance::DropStalePage(page_id_t page_id) {
+  prefetching_.erase(page_id);
+  compressed_cache_.Erase(page_id);
+  cached_pages_.erase(page_id);
+  auto it = page_table_.find(page_id);
+  if (it == page_table_.end()) {
+    return;
+  }
+  frame_id_t frame_id = it->second;
+  ASSERT(frames_.PinCount(frame_id) == 0, "A page that was not allocated is pinned.");
+  page_table_.erase(it);
+  frames_.PageId(frame_id) = INVALID_PAGE_ID;
+  frames_.IsDirty(frame_id) = false;
+  ReleaseFrame(frame_id);
+}
+
+void BufferPoolManagerInstance::BindFrame(frame_id_t frame_id, page_id_t page_id) {
+  page_table_.emplace(page_id, frame_id);
+  replacer_->SetProtected(frame_id, cached_pages_.count(page_id) != 0);
+  cached_resident_pages_.store(replacer_->GetProtectedFrames(), std::memory_order_relaxed);
+}
+
+void BufferPoolManagerInstance::ReleaseFrame(frame_id_t frame_id) {
+  replacer_->Remove(frame_id);
+  replacer_->SetProtected(frame_id, false);
+  cached_resident_pages_.store(replacer_->GetProtectedFrames(), std::memory_order_relaxed);
+  if (static_cast<size_t>(frame_id) < retiring_from_) {
+    free_list_.push_back(frame_id);
+  }
+  Count(resident_pages_, -1);
+}
+
+void BufferPoolManagerInstance::FramePinned() {
+  Count(pinned_frames_);
+  uint64_t pinned = pinned_frames_.load(std::memory_order_relaxed);
+  if (pinned > pinned_high_water_.load(std::memory_order_relaxed)) {
+    pinned_high_water_.store(pinned, std::memory_order_relaxed);
+  }
+}
+
+BufferPoolStats BufferPoolManagerInstance::GetStats() {
+  BufferPoolStats stats;
+  {
+    std::scoped_lock<std::mutex> lock(latch_);
+    stats.pool_size_ = pool_size_;
+    stats.frame_quota_ = std::min(frame_quota_, pool_size_);
+  }
+  stats.resident_pages_ = resident_pages_.load(std::memory_order_relaxed);
+  stats.cached_resident_pages_ = cached_resident_pages_.load(std::memory_order_relaxed);
+  stats.pinned_frames_ = pinned_frames_.load(std::memory_order_relaxed);
+  stats.pinned_high_water_ = pinned_high_water_.load(std::memory_order_relaxed);
+  stats.fetches_ = fetches_.load(std::memory_order_relaxed);
+  stats.hits_ = hits_.load(std::memory_order_relaxed);
+  stats.misses_ = misses_.load(std::memory_order_relaxed);
+  stats.failed_fetches_ = failed_fetches_.load(std::memory_order_relaxed);
+  stats.evictions_ = evictions_.load(std::memory_order_relaxed);
+  stats.cached_evictions_ = cached_evictions_.load(std::memory_order_relaxed);
+  stats.foreground_writebacks_ = foreground_writebacks_.load(std::memory_order_relaxed);
+  stats.background_writebacks_ = background_writebacks_.load(std::memory_order_relaxed);
+  stats.new_pages_ = new_pages_.load(std::memory_order_relaxed);
+  stats.deleted_pages_ = deleted_pages_.load(std::memory_order_relaxed);
+  stats.compressed_capacity_ = compressed_cache_.GetCapacity();
+  stats.compressed_pages_ = compressed_cache_.GetPages();
+  stats.compressed_bytes_ = compressed_cache_.GetBytes();
+  stats.compressed_lookups_ = compressed_cache_.GetLookups();
+  stats.compressed_hits_ = compressed_cache_.GetHits();
+  stats.compressed_rejects_ = compressed_cache_.GetRejects();
+  stats.compressed_evictions_ = compressed_cache_.GetEvictions();
+  return stats;
+}
+
+std::map<page_owner_t, PageOwnerStats> BufferPoolManagerInstance::GetOwnerStats() {
+  std::scoped_lock<std::mutex> lock(latch_);
+  return {owner_stats_.begin(), owner_stats_.end()};
+}
+
+size_t BufferPoolManagerInstance::GetPoolSize() {
+  std::scoped_lock<std::mutex> lock(latch_);
+  return pool_size_;
+}
+
+// 1.   Growing: commit the new frames in the arena and put them on the free list.
+// 2.   Shrinking: take the frames past the new size off the free list and out of the replacer. Write back and evict
+//      the unpinned pages they hold, and wait for the pinned ones to be unpinned, until all of them are empty.
+// 3.   Release the retired frames.
+bool BufferPoolManagerInstance::ResizePool(size_t pool_size) {
+  std::scoped_lock<std::mutex> resize_lock(resize_latch_);
+  std::unique_lock<std::mutex> lock(latch_);
+  if (pool_size == 0 || pool_size > frames_.GetMaxFrames()) {
+    return false;
+  }
+  if (pool_size >= pool_size_) {
+    frames_.Resize(pool_size);
+    replacer_->Resize(pool_size);
+    for (size_t i = pool_size_; i < pool_size; i++) {
+      free_list_.emplace_back(i);
+    }
+    pool_size_ = pool_size;
+    retiring_from_ = pool_size;
+    return true;
+  }
+
+  retiring_from_ = pool_size;
+  free_list_.remove_if([pool_size](frame_id_t frame_id) { return static_cast<size_t>(frame_id) >= pool_size; });
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(RESIZE_PIN_TIMEOUT_MS);
+  while (true) {
+    std::vector<page_id_t> pinned;
+    for (size_t i = pool_size; i < pool_size_; i++) {
+      auto frame_id = static_cast<frame_id_t>(i);
+      page_id_t page_id = frames_.PageId(frame_id);
+      if (page_id == INVALID_PAGE_ID) {
+        continue;
+      }
+      if (frames_.PinCount(frame_id) > 0) {
+        pinned.push_back(page_id);
+        continue;
+      }
+      if (frames_.IsDirty(frame_id)) {
+        SettleWriteback(page_id, false);
+        disk_manager_->WritePage(page_id, frames_.GetData(frame_id));
+        ChargeWrite(frame_id);
+        Count(foreground_writebacks_);
+      }
+      compressed_cache_.Insert(page_id, frames_.GetData(frame_id));
+      page_table_.erase(page_id);
+      frames_.PageId(frame_id) = INVALID_PAGE_ID;
+      frames_.IsDirty(frame_id) = false;
+      ReleaseFrame(frame_id);
+      Count(evictions_);
+    }
+    if (pinned.empty()) {
+      break;
+    }
+    if (unpin_cv_.wait_until(lock, deadline) == std::cv_status::timeout) {
+      CancelShrink(pool_size, pinned);
+      return false;
+    }
+  }
+  replacer_->Resize(pool_size);
+  frames_.Resize(pool_size);
+  pool_size_ = pool_size;
+  return true;
+}
+
+void BufferPoolManagerInstance::CancelShrink(size_t pool_size, const std::vector<page_id_t> &pinned) {
+  std::string page_ids;
+  for (auto page_id : pinned) {
+    page_ids += " " + std::to_string(page_id);
+  }
+  LOG(WARNING) << "Shrinking the buffer pool to " << pool_size << " frames timed out, still pinned:" << page_ids;
+  // the retired frames that were emptied go back to the free list, the pages unpinned since the last pass back to
+  // the replacer
+  retiring_from_ = pool_size_;
+  for (size_t i = pool_size; i < pool_size_; i++) {
+    auto frame_id = static_cast<frame_id_t>(i);
+    if (frames_.PageId(frame_id) == INVALID_PAGE_ID) {
+      free_list_.push_back(frame_id);
+    } else if (frames_.PinCount(frame_id) == 0) {
+      replacer_->Unpin(frame_id);
+    }
+  }
+}
+
+void BufferPoolManagerInstance::SetFrameQuota(size_t frames) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  frame_quota_ = std::max<size_t>(frames, 1);
+  frame_id_t frame_id;
+  while (resident_pages_.load(std::memory_order_relaxed) > frame_quota_ && EvictFrame(&frame_id)) {
+    frames_.PageId(frame_id) = INVALID_PAGE_ID;
+    frames_.IsDirty(frame_id) = false;
+    ReleaseFrame(frame_id);
+    frames_.Discard(frame_id);
+  }
+}
+
+void BufferPoolManagerInstance::SetResidencyHint(const std::vector<page_id_t> &page_ids, bool cached) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  for (auto page_id : page_ids) {
+    ASSERT(page_id % num_instances_ == instance_index_, "Page does not belong to this instance.");
+    if (cached) {
+      cached_pages_.insert(page_id);
+    } else {
+      cached_pages_.erase(page_id);
+    }
+    auto it = page_table_.find(page_id);
+    if (it != page_table_.end()) {
+      replacer_->SetProtected(it->second, cached);
+    }
+  }
+  cached_resident_pages_.store(replacer_->GetProtectedFrames(), std::memory_order_relaxed);
+}
+
+void BufferPoolManagerInstance::SetCompressedCacheSize(size_t capacity) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  compressed_cache_.SetCapacity(capacity);
+}
+
+void BufferPoolManagerInstance::SettleWriteback(page_id_t page_id, bool write_back) {
+  std::scoped_lock<std::mutex> writeback_lock(writeback_latch_);
+  auto it = pending_writebacks_.find(page_id);
+  if (it == pending_writebacks_.end()) {
+    return;
+  }
+  if (write_back) {
+    disk_manager_->WritePage(page_id, it->second.get());
+    background_writebacks_.fetch_add(1, std::memory_order_relaxed);
+  }
+  pending_writebacks_.erase(it);
+}
+
+void BufferPoolManagerInstance::StartPageCleaner(double clean_fraction) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  clean_fraction_ = clean_fraction;
+  if (cleaner_running_) {
+    return;
+  }
+  cleaner_running_ = true;
+  cleaner_thread_ = std::thread(&BufferPoolManagerInstance::RunPageCleaner, this);
+}
+
+void BufferPoolManagerInstance::StopPageCleaner() {
+  {
+    std::scoped_lock<std::mutex> lock(latch_);
+    if (!cleaner_running_) {
+      return;
+    }
+    cleaner_running_ = false;
+  }
+  cleaner_cv_.notify_one();
+  cleaner_thread_.join();
+  WritePendingPages();
+}
+
+void BufferPoolManagerInstance::RunPageCleaner() {
+  std::unique_lock<std::mutex> lock(latch_);
+  while (cleaner_running_) {
+    cleaner_cv_.wait_for(lock, std::chrono::milliseconds(PAGE_CLEANER_INTERVAL_MS));
+    if (!cleaner_running_) {
+      break;
+    }
+    CollectDirtyPages();
+    lock.unlock();
+    WritePendingPages();
+    lock.lock();
+  }
+}
+
+void BufferPoolManagerInstance::CollectDirtyPages() {
+  size_t evictable = 0;
+  size_t clean = 0;
+  std::vector<frame_id_t> dirty;
+  for (size_t i = 0; i < pool_size_; i++) {
+    if (frames_.PageId(i) == INVALID_PAGE_ID || frames_.PinCount(i) > 0) {
+      continue;
+    }
+    evictable++;
+    if (frames_.IsDirty(i)) {
+      dirty.push_back(i);
+    } else {
+      clean++;
+    }
+  }
+  auto target = static_cast<size_t>(clean_fraction_ * evictable);
+  if (clean >= target || dirty.empty()) {
+    return;
+  }
+  size_t count = std::min(target - clean, dirty.size());
+  std::sort(dirty.begin(), dirty.end(),
+            [&](frame_id_t a, frame_id_t b) { return frames_.PageId(a) < frames_.PageId(b); });
+
+  std::scoped_lock<std::mutex> writeback_lock(writeback_latch_);
+  for (size_t i = 0; i < count; i++) {
+    auto copy = std::make_unique<char[]>(PAGE_SIZE);
+    memcpy(copy.get(), frames_.GetData(dirty[i]), PAGE_SIZE);
+    pending_writebacks_[frames_.PageId(dirty[i])] = std::move(copy);
+    // charged now, the owner tag of the frame may change before the copy is written
+    ChargeWrite(dirty[i]);
+    frames_.IsDirty(dirty[i]) = false;
+  }
+}
+
+void BufferPoolManagerInstance::WritePendingPages() {
+  // one batch per latch hold, so a foreground thread settling a page waits for at most one batch
+  std::vector<std::pair<page_id_t, const char *>> pages;
+  while (true) {
+    std::scoped_lock<std::mutex> writeback_lock(writeback_latch_);
+    if (pending_writebacks_.empty()) {
+      return;
+    }
+    pages.clear();
+    auto end = pending_writebacks_.begin();
+    for (; end != pending_writebacks_.end() && pages.size() < PAGE_CLEANER_WRITE_BATCH; ++end) {
+      pages.emplace_back(end->first, end->second.get());
+    }
+    disk_manager_->WritePages(pages);
+    background_writebacks_.fetch_add(pages.size(), std::memory_order_relaxed);
+    pending_writebacks_.erase(pending_writebacks_.begin(), end);
+  }
+}
+
+// 1.   Queue every page that is neither resident nor queued yet, and start the prefetch thread if needed.
+// 2.   Advise the kernel about the queued pages so that their reads are already under way when the thread gets to
+//      them.
+void BufferPoolManagerInstance::PrefetchPages(const std::vector<page_id_t> &page_ids) {
+  std::vector<page_id_t> queued;
+  {
+    std::scoped_lock<std::mutex> lock(latch_);
+    if (prefetch_stopped_) {
+      return;
+    }
+    for (auto page_id : page_ids) {
+      ASSERT(page_id % num_instances_ == instance_index_, "Page does not belong to this instance.");
+      if (page_table_.count(page_id) != 0 || !prefetching_.insert(page_id).second) {
+        continue;
+      }
+      prefetch_queue_.push_back({page_id, PageOwnerScope::Current(), 0, nullptr});
+      queued.push_back(page_id);
+    }
+    if (queued.empty()) {
+      return;
+    }
+    if (!prefetch_running_) {
+      prefetch_running_ = true;
+      prefetch_thread_ = std::thread(&BufferPoolManagerInstance::RunPrefetcher, this);
+    }
+  }
+  prefetch_cv_.notify_all();
+  disk_manager_->AdviseWillNeed(queued);
+}
+
+// 1.   Queue the first page of the chain even if it is resident or queued already, the prefetch thread still has to
+//      take the next page id from it.
+// 2.   Advise the kernel about the page if the thread is going to read it.
+void BufferPoolManagerInstance::PrefetchChain(page_id_t page_id, size_t count, NextPageIdReader next_page_id) {
+  if (page_id == INVALID_PAGE_ID || count == 0) {
+    return;
+  }
+  bool read;
+  {
+    std::scoped_lock<std::mutex> lock(latch_);
+    ASSERT(page_id % num_instances_ == instance_index_, "Page does not belong to this instance.");
+    if (prefetch_stopped_) {
+      return;
+    }
+    read = page_table_.count(page_id) == 0 && prefetching_.insert(page_id).second;
+    prefetch_queue_.push_back({page_id, PageOwnerScope::Current(), count - 1, next_page_id});
+    if (!prefetch_running_) {
+      prefetch_running_ = true;
+      prefetch_thread_ = std::thread(&BufferPoolManagerInstance::RunPrefetcher, this);
+    }
+  }
+  prefetch_cv_.notify_all();
+  if (read) {
+    disk_manager_->AdviseWillNeed({page_id});
+  }
+}
+
+// 1.   Take the queued requests, until PREFETCH_BATCH_PAGES pages are to be read. A page that is resident already is
+//      not read, a chain goes on through its frame, read with the page pinned and read latched. A request that was
+//      cancelled by FetchPage, NewPage or DeletePage is dropped.
+// 2.   Let a chain request on an unsharded pool also read the pages that follow its page on disk, as far as the chain
+//      goes and they are allocated and neither resident nor queued: the pages of a chain are allocated in runs, see
+//      DiskManager::AllocatePageNear.
+// 3.   Read the batch with one DiskManager::ReadPages call without holding the latch.
+// 4.   Follow every chain through the pages of the batch. Install the pages it reached and the requested pages
+//      unpinned, unless they were fetched, created or deleted while they were being read, and drop the rest.
+// 5.   Queue the page where each chain leaves the batch through chain_pool_, unless the chain ends or leads to a free
+//      page.
+void BufferPoolManagerInstance::RunPrefetcher() {
+  std::unique_ptr<char, decltype(&free)> buffers(
+      static_cast<char *>(aligned_alloc(DISK_IO_ALIGNMENT, PREFETCH_BATCH_PAGES * PAGE_SIZE)), &free);
+  std::unique_lock<std::mutex> lock(latch_);
+  while (true) {
+    prefetch_cv_.wait(lock, [&] { return !prefetch_running_ || !prefetch_queue_.empty(); });
+    if (!prefetch_running_) {
+      break;
+    }
+
+    // a page of the batch: its request, whether it was only read because it may follow the page of its chain, and
+    // whether it has to come from the disk
+    struct BatchPage {
+      page_id_t page_id_;
+      size_t request_;
+      bool speculative_;
+      bool from_disk_;
+    };
+    std::vector<PrefetchRequest> requests;
+    std::vector<BatchPage> batch;
+    std::vector<std::pair<size_t, Page *>> resident_chains;  // request and pinned page of chains through a frame
+    std::unordered_map<page_id_t, size_t> batch_index;
+    auto add_page = [&](page_id_t page_id, bool speculative) {
+      char *data = buffers.get() + batch.size() * PAGE_SIZE;
+      bool from_disk = !compressed_cache_.Take(page_id, data);
+      batch_index[page_id] = batch.size();
+      batch.push_back({page_id, requests.size() - 1, speculative, from_disk});
+      prefetch_reading_.insert(page_id);
+    };
+    while (!prefetch_queue_.empty() && batch.size() < PREFETCH_BATCH_PAGES) {
+      PrefetchRequest request = prefetch_queue_.front();
+      prefetch_queue_.pop_front();
+      page_id_t page_id = request.page_id_;
+      bool follow = request.next_page_id_ != nullptr && request.chain_left_ > 0;
+      auto resident = page_table_.find(page_id);
+      if (resident != page_table_.end()) {
+        // brought in by someone else, the chain goes on through the frame
+        prefetching_.erase(page_id);
+        if (follow) {
+          if (frames_.PinCount(resident->second)++ == 0) {
+            FramePinned();
+            replacer_->Pin(resident->second);
+          }
+          requests.push_back(request);
+          resident_chains.emplace_back(requests.size() - 1, frames_.GetPage(resident->second));
+        }
+        continue;
+      }
+      if (prefetching_.count(page_id) == 0 || batch_index.count(page_id) != 0) {
+        continue;
+      }
+      requests.push_back(request);
+      add_page(page_id, false);
+      if (!follow || num_instances_ != 1) {
+        continue;
+      }
+      for (page_id_t next = page_id + 1; batch.size() < PREFETCH_BATCH_PAGES &&
+                                         static_cast<size_t>(next - page_id) <= request.chain_left_;
+           next++) {
+        if (page_table_.count(next) != 0 || prefetching_.count(next) != 0 || disk_manager_->IsPageFree(next)) {
+          break;
+        }
+        prefetching_.insert(next);
+        add_page(next, true);
+      }
+    }
+
+    lock.unlock();
+    std::vector<std::pair<page_id_t, char *>> reads;
+    for (size_t i = 0; i < batch.size(); i++) {
+      if (batch[i].from_disk_) {
+        SettleWriteback(batch[i].page_id_, true);
+        reads.emplace_back(batch[i].page_id_, buffers.get() + i * PAGE_SIZE);
+      }
+    }
+    disk_manager_->ReadPages(reads);
+    // the next page of a chain through a frame, the page stays pinned until then
+    std::vector<std::pair<size_t, page_id_t>> continuations;
+    for (auto &[index, page] : resident_chains) {
+      page->RLatch();
+      continuations.emplace_back(index, requests[index].next_page_id_(page->GetData()));
+      page_id_t page_id = page->GetPageId();
+      page->RUnlatch();
+      UnpinPage(page_id, false);
+    }
+    lock.lock();
+
+    // walk each chain through the batch, its requested page first
+    std::vector<bool> reached(batch.size(), false);
+    for (size_t i = 0; i < batch.size(); i++) {
+      if (batch[i].speculative_) {
+        continue;
+      }
+      reached[i] = true;
+      PrefetchRequest &request = requests[batch[i].request_];
+      if (request.next_page_id_ == nullptr || request.chain_left_ == 0) {
+        continue;
+      }
+      page_id_t next_page_id = request.next_page_id_(buffers.get() + i * PAGE_SIZE);
+      while (request.chain_left_ > 0) {
+        auto next = batch_index.find(next_page_id);
+        if (next == batch_index.end() || !batch[next->second].speculative_ ||
+            batch[next->second].request_ != batch[i].request_) {
+          break;
+        }
+        reached[next->second] = true;
+        request.chain_left_--;
+        next_page_id = request.next_page_id_(buffers.get() + next->second * PAGE_SIZE);
+      }
+      if (request.chain_left_ > 0) {
+        continuations.emplace_back(batch[i].request_, next_page_id);
+      }
+    }
+
+    for (size_t i = 0; i < batch.size(); i++) {
+      page_id_t page_id = batch[i].page_id_;
+      prefetch_reading_.erase(page_id);
+      if (batch[i].from_disk_ && reached[i]) {
+        owner_stats_[requests[batch[i].request_].owner_].reads_++;
+      }
+      frame_id_t frame_id;
+      if (reached[i] && prefetching_.count(page_id) != 0 && page_table_.count(page_id) == 0 &&
+          AcquireFrame(&frame_id)) {
+        BindFrame(frame_id, page_id);
+        frames_.PageId(frame_id) = page_id;
+        frames_.PinCount(frame_id) = 0;
+        frames_.IsDirty(frame_id) = false;
+        frames_.Owner(frame_id) = requests[batch[i].request_].owner_;
+        memcpy(frames_.GetData(frame_id), buffers.get() + i * PAGE_SIZE, PAGE_SIZE);
+        replacer_->Unpin(frame_id);
+      }
+      prefetching_.erase(page_id);
+    }
+    prefetch_cv_.notify_all();
+
+    lock.unlock();
+    for (auto &[index, next_page_id] : continuations) {
+      // INVALID_PAGE_ID ends the chain, any other negative id is garbage read from a page freed in the meantime
+      const PrefetchRequest &request = requests[index];
+      if (next_page_id < 0 || chain_pool_->IsPageFree(next_page_id)) {
+        continue;
+      }
+      PageOwnerScope owner_scope(request.owner_);
+      chain_pool_->PrefetchChain(next_page_id, request.chain_left_, request.next_page_id_);
+    }
+    lock.lock();
+  }
+}
+
+void BufferPoolManagerInstance::StopPrefetcher() {
+  {
+    std::scoped_lock<std::mutex> lock(latch_);
+    prefetch_stopped_ = true;
+    if (!prefetch_running_) {
+      return;
+    }
+    prefetch_running_ = false;
+    prefetch_queue_.clear();
+    prefetching_.clear();
+  }
+  prefetch_cv_.notify_all();
+  prefetch_thread_.join();
+}
+
+std::vector<page_id_t> BufferPoolManagerInstance::GetResidentPages() {
+  std::scoped_lock<std::mutex> lock(latch_);
+  std::vector<page_id_t> page_ids;
+  for (size_t i = 0; i < pool_size_; i++) {
+    auto frame_id = static_cast<frame_id_t>(i);
+    if (frames_.PageId(frame_id) != INVALID_PAGE_ID && frames_.PinCount(frame_id) > 0) {
+      page_ids.push_back(frames_.PageId(frame_id));
+    }
+  }
+  for (auto frame_id : replacer_->GetFramesByPriority()) {
+    if (frames_.PageId(frame_id) != INVALID_PAGE_ID) {
+      page_ids.push_back(frames_.PageId(frame_id));
+    }
+  }
+  return page_ids;
+}
+
+page_id_t BufferPoolManagerInstance::AllocatePage() {
+  int next_page_id = disk_manager_->AllocatePage();
+  return next_page_id;
+}
+
+void BufferPoolManagerInstance::DeallocatePage(page_id_t page_id) { disk_manager_->DeAllocatePage(page_id); }
+
+bool BufferPoolManagerInstance::IsPageFree(page_id_t page_id) { return disk_manager_->IsPageFree(page_id); }
+
+// Only used for debug
+bool BufferPoolManagerInstance::CheckAllUnpinned() {
+  std::scoped_lock<std::mutex> lock(latch_);
+  bool res = true;
+  for (size_t i = 0; i < pool_size_; i++) {
+    if (frames_.PinCount(i) != 0) {
+      res = false;
+      LOG(ERROR) << "page " << frames_.PageId(i) << " pin count:" << frames_.PinCount(i) << endl;
+    }
+  }
+  return res;
+}
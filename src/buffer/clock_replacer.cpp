@@ -0,0 +1,80 @@
+#include <algorithm>
+
+#include "buffer/clock_replacer.h"
+#include "common/macros.h"
+
+ClockReplacer::ClockReplacer(size_t num_pages) : num_pages_(num_pages), slots_(new Slot[num_pages]) {}
+
+bool ClockReplacer::Victim(frame_id_t *frame_id) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  // every full turn clears the reference bits it passes, so the sweep ends within two turns
+  // unless concurrent pins keep taking the candidates away
+  while (size_.load() > 0) {
+    Slot &slot = slots_[hand_];
+    frame_id_t current = static_cast<frame_id_t>(hand_);
+    hand_ = (hand_ + 1) % num_pages_;
+    if (!slot.evictable_.load(std::memory_order_relaxed)) {
+      continue;
+    }
+    if (slot.referenced_.exchange(false, std::memory_order_relaxed)) {
+      continue;
+    }
+    bool expected = true;
+    if (slot.evictable_.compare_exchange_strong(expected, false)) {
+      size_--;
+      *frame_id = current;
+      return true;
+    }
+  }
+  return false;
+}
+
+void ClockReplacer::Pin(frame_id_t frame_id) {
+  ASSERT(static_cast<size_t>(frame_id) < num_pages_, "Frame id out of range.");
+  Slot &slot = slots_[frame_id];
+  if (slot.evictable_.load(std::memory_order_relaxed) && slot.evictable_.exchange(false)) {
+    size_--;
+  }
+}
+
+void ClockReplacer::Unpin(frame_id_t frame_id) {
+  ASSERT(static_cast<size_t>(frame_id) < num_pages_, "Frame id out of range.");
+  Slot &slot = slots_[frame_id];
+  slot.referenced_.store(true, std::memory_order_relaxed);
+  if (!slot.evictable_.load(std::memory_order_relaxed) && !slot.evictable_.exchange(true)) {
+    size_++;
+  }
+}
+
+void ClockReplacer::Resize(size_t num_pages) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  std::unique_ptr<Slot[]> slots(new Slot[num_pages]);
+  for (size_t i = 0; i < std::min(num_pages, num_pages_); i++) {
+    slots[i].evictable_.store(slots_[i].evictable_.load());
+    slots[i].referenced_.store(slots_[i].referenced_.load());
+  }
+  slots_ = std::move(slots);
+  num_pages_ = num_pages;
+  hand_ %= num_pages_;
+}
+
+std::vector<frame_id_t> ClockReplacer::GetFramesByPriority() {
+  std::scoped_lock<std::mutex> lock(latch_);
+  // the hand evicts unreferenced frames first, in sweep order, so walk the sweep backwards from the hand and put
+  // the referenced frames ahead of the unreferenced ones
+  std::vector<frame_id_t> referenced;
+  std::vector<frame_id_t> unreferenced;
+  for (size_t i = 1; i <= num_pages_; i++) {
+    size_t slot_index = (hand_ + num_pages_ - i) % num_pages_;
+    Slot &slot = slots_[slot_index];
+    if (!slot.evictable_.load(std::memory_order_relaxed)) {
+      continue;
+    }
+    auto frame_id = static_cast<frame_id_t>(slot_index);
+    (slot.referenced_.load(std::memory_order_relaxed) ? referenced : unreferenced).push_back(frame_id);
+  }
+  referenced.insert(referenced.end(), unreferenced.begin(), unreferenced.end());
+  return referenced;
+}
+
+size_t ClockReplacer::Size() { return size_.load(); }
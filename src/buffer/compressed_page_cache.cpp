@@ -0,0 +1,73 @@
+#include <cstring>
+
+#include "buffer/compressed_page_cache.h"
+#include "buffer/lz_codec.h"
+
+bool CompressedPageCache::Insert(page_id_t page_id, const char *data) {
+  if (capacity_ == 0) {
+    return false;
+  }
+  Erase(page_id);
+  // the codec gives up as soon as the output outgrows the limit, so incompressible pages are cheap to reject
+  char buffer[PAGE_SIZE];
+  auto limit = static_cast<size_t>(COMPRESSED_CACHE_MAX_RATIO * PAGE_SIZE);
+  size_t size = LZCodec::Compress(data, PAGE_SIZE, buffer, limit);
+  if (size == 0 || size > capacity_) {
+    Count(rejects_);
+    return false;
+  }
+  ShrinkTo(capacity_ - size);
+  Entry entry;
+  entry.data_ = std::make_unique<char[]>(size);
+  memcpy(entry.data_.get(), buffer, size);
+  entry.size_ = size;
+  entry.order_ = order_.insert(order_.end(), page_id);
+  entries_.emplace(page_id, std::move(entry));
+  Count(pages_);
+  Count(bytes_, static_cast<int64_t>(size));
+  return true;
+}
+
+bool CompressedPageCache::Take(page_id_t page_id, char *data) {
+  if (capacity_ == 0) {
+    return false;
+  }
+  Count(lookups_);
+  auto it = entries_.find(page_id);
+  if (it == entries_.end()) {
+    return false;
+  }
+  // a copy that does not decompress is dropped, the caller reads the page from disk instead
+  bool decompressed = LZCodec::Decompress(it->second.data_.get(), it->second.size_, data, PAGE_SIZE);
+  RemoveEntry(it);
+  if (decompressed) {
+    Count(hits_);
+  }
+  return decompressed;
+}
+
+void CompressedPageCache::Erase(page_id_t page_id) {
+  auto it = entries_.find(page_id);
+  if (it != entries_.end()) {
+    RemoveEntry(it);
+  }
+}
+
+void CompressedPageCache::SetCapacity(size_t capacity) {
+  capacity_ = capacity;
+  ShrinkTo(capacity);
+}
+
+void CompressedPageCache::RemoveEntry(std::unordered_map<page_id_t, Entry>::iterator it) {
+  Count(pages_, -1);
+  Count(bytes_, -static_cast<int64_t>(it->second.size_));
+  order_.erase(it->second.order_);
+  entries_.erase(it);
+}
+
+void CompressedPageCache::ShrinkTo(size_t target) {
+  while (bytes_.load(std::memory_order_relaxed) > target) {
+    RemoveEntry(entries_.find(order_.front()));
+    Count(evictions_);
+  }
+}
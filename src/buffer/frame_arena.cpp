@@ -0,0 +1,102 @@
+#include <sys/mman.h>
+#include <algorithm>
+#include <new>
+
+#include "buffer/frame_arena.h"
+
+namespace {
+
+inline size_t RoundUp(size_t value, size_t alignment) { return (value + alignment - 1) & ~(alignment - 1); }
+
+}  // namespace
+
+FrameArena::FrameArena(size_t num_frames, bool huge_pages, size_t max_frames)
+    : max_frames_(std::max<size_t>({num_frames, max_frames, 1})) {
+  size_t data_size = max_frames_ * PAGE_SIZE;
+  // huge pages only pay off once the pool can span at least one of them
+  size_t alignment = huge_pages && data_size >= FRAME_ARENA_HUGE_PAGE_SIZE ? FRAME_ARENA_HUGE_PAGE_SIZE : PAGE_SIZE;
+  size_t pages_size = RoundUp(max_frames_ * sizeof(Page), PAGE_SIZE);
+  size_t page_ids_size = RoundUp(max_frames_ * sizeof(page_id_t), PAGE_SIZE);
+  size_t pin_counts_size = RoundUp(max_frames_ * sizeof(int), PAGE_SIZE);
+  size_t is_dirty_size = RoundUp(max_frames_ * sizeof(bool), PAGE_SIZE);
+  size_t owners_size = RoundUp(max_frames_ * sizeof(page_owner_t), PAGE_SIZE);
+  mapping_size_ =
+      data_size + alignment - PAGE_SIZE + pages_size + page_ids_size + pin_counts_size + is_dirty_size + owners_size;
+  // reserve address space only, memory is committed by Resize
+  void *mapping = mmap(nullptr, mapping_size_, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if (mapping == MAP_FAILED) {
+    throw std::bad_alloc();
+  }
+  mapping_ = static_cast<char *>(mapping);
+  data_ = reinterpret_cast<char *>(RoundUp(reinterpret_cast<uintptr_t>(mapping_), alignment));
+  pages_ = reinterpret_cast<Page *>(data_ + data_size);
+  page_ids_ = reinterpret_cast<page_id_t *>(reinterpret_cast<char *>(pages_) + pages_size);
+  pin_counts_ = reinterpret_cast<int *>(reinterpret_cast<char *>(page_ids_) + page_ids_size);
+  is_dirty_ = reinterpret_cast<bool *>(reinterpret_cast<char *>(pin_counts_) + pin_counts_size);
+  owners_ = reinterpret_cast<page_owner_t *>(reinterpret_cast<char *>(is_dirty_) + is_dirty_size);
+#ifdef MADV_HUGEPAGE
+  if (alignment == FRAME_ARENA_HUGE_PAGE_SIZE) {
+    huge_pages_ = madvise(data_, data_size, MADV_HUGEPAGE) == 0;
+  }
+#endif
+  try {
+    Resize(num_frames);
+  } catch (...) {
+    munmap(mapping_, mapping_size_);
+    throw;
+  }
+}
+
+FrameArena::~FrameArena() {
+  for (size_t i = 0; i < num_frames_; i++) {
+    pages_[i].~Page();
+  }
+  munmap(mapping_, mapping_size_);
+}
+
+void FrameArena::Resize(size_t num_frames) {
+  ASSERT(num_frames <= max_frames_, "Frame arena cannot grow past its reservation.");
+  if (num_frames < num_frames_) {
+    for (size_t i = num_frames; i < num_frames_; i++) {
+      ASSERT(page_ids_[i] == INVALID_PAGE_ID, "Frame past the new size still holds a page.");
+      pages_[i].~Page();
+    }
+    madvise(GetData(num_frames), (num_frames_ - num_frames) * PAGE_SIZE, MADV_DONTNEED);
+    num_frames_ = num_frames;
+    return;
+  }
+  Commit(data_, PAGE_SIZE, num_frames_, num_frames);
+  Commit(pages_, sizeof(Page), num_frames_, num_frames);
+  Commit(page_ids_, sizeof(page_id_t), num_frames_, num_frames);
+  Commit(pin_counts_, sizeof(int), num_frames_, num_frames);
+  Commit(is_dirty_, sizeof(bool), num_frames_, num_frames);
+  Commit(owners_, sizeof(page_owner_t), num_frames_, num_frames);
+  for (size_t i = num_frames_; i < num_frames; i++) {
+    page_ids_[i] = INVALID_PAGE_ID;
+    pin_counts_[i] = 0;
+    is_dirty_[i] = false;
+    owners_[i] = INVALID_PAGE_OWNER;
+    new (&pages_[i]) Page(GetData(i), &page_ids_[i], &pin_counts_[i], &is_dirty_[i]);
+  }
+  num_frames_ = num_frames;
+}
+
+void FrameArena::Discard(frame_id_t frame_id) {
+  ASSERT(page_ids_[frame_id] == INVALID_PAGE_ID, "Discarded frame still holds a page.");
+  if (!huge_pages_) {
+    madvise(GetData(frame_id), PAGE_SIZE, MADV_DONTNEED);
+  }
+}
+
+void FrameArena::Commit(void *array, size_t element_size, size_t from, size_t to) {
+  if (from >= to) {
+    return;
+  }
+  auto begin = reinterpret_cast<uintptr_t>(array) + from * element_size;
+  auto end = reinterpret_cast<uintptr_t>(array) + to * element_size;
+  begin &= ~static_cast<uintptr_t>(PAGE_SIZE - 1);
+  end = RoundUp(end, PAGE_SIZE);
+  if (mprotect(reinterpret_cast<void *>(begin), end - begin, PROT_READ | PROT_WRITE) != 0) {
+    throw std::bad_alloc();
+  }
+}
@@ -0,0 +1,87 @@
+#include "buffer/lru_k_replacer.h"
+
+LRUKReplacer::LRUKReplacer(size_t num_pages, size_t k) : k_(k), frames_(num_pages) {}
+
+bool LRUKReplacer::Victim(frame_id_t *frame_id) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  // frames with an infinite backward k-distance go first
+  std::set<Entry> &from = history_.empty() ? cache_ : history_;
+  if (from.empty()) return false;
+  *frame_id = from.begin()->second;
+  from.erase(from.begin());
+  Forget(*frame_id);
+  return true;
+}
+
+void LRUKReplacer::Pin(frame_id_t frame_id) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  if (static_cast<size_t>(frame_id) >= frames_.size()) {
+    frames_.resize(frame_id + 1);
+  }
+  FrameHistory &frame = frames_[frame_id];
+  if (frame.evictable_) {
+    SetOf(frame_id).erase(KeyOf(frame_id));
+    frame.evictable_ = false;
+  }
+  frame.accesses_.push_back(current_timestamp_++);
+  if (frame.accesses_.size() > k_) {
+    frame.accesses_.pop_front();
+  }
+}
+
+void LRUKReplacer::Unpin(frame_id_t frame_id) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  if (static_cast<size_t>(frame_id) >= frames_.size()) {
+    frames_.resize(frame_id + 1);
+  }
+  FrameHistory &frame = frames_[frame_id];
+  if (frame.evictable_) return;
+  // a frame unpinned without any recorded access is treated as accessed now
+  if (frame.accesses_.empty()) {
+    frame.accesses_.push_back(current_timestamp_++);
+  }
+  frame.evictable_ = true;
+  SetOf(frame_id).insert(KeyOf(frame_id));
+}
+
+void LRUKReplacer::Remove(frame_id_t frame_id) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  if (static_cast<size_t>(frame_id) >= frames_.size()) return;
+  if (frames_[frame_id].evictable_) {
+    SetOf(frame_id).erase(KeyOf(frame_id));
+  }
+  Forget(frame_id);
+}
+
+std::vector<frame_id_t> LRUKReplacer::GetFramesByPriority() {
+  std::scoped_lock<std::mutex> lock(latch_);
+  // the reverse of the victim order: frames with k accesses first, then the ones with an infinite k-distance
+  std::vector<frame_id_t> frames;
+  frames.reserve(history_.size() + cache_.size());
+  for (auto it = cache_.rbegin(); it != cache_.rend(); ++it) {
+    frames.push_back(it->second);
+  }
+  for (auto it = history_.rbegin(); it != history_.rend(); ++it) {
+    frames.push_back(it->second);
+  }
+  return frames;
+}
+
+size_t LRUKReplacer::Size() {
+  std::scoped_lock<std::mutex> lock(latch_);
+  return history_.size() + cache_.size();
+}
+
+LRUKReplacer::Entry LRUKReplacer::KeyOf(frame_id_t frame_id) const {
+  // the oldest kept access is the first access for short histories and the k-th most recent one otherwise
+  return {frames_[frame_id].accesses_.front(), frame_id};
+}
+
+std::set<LRUKReplacer::Entry> &LRUKReplacer::SetOf(frame_id_t frame_id) {
+  return frames_[frame_id].accesses_.size() < k_ ? history_ : cache_;
+}
+
+void LRUKReplacer::Forget(frame_id_t frame_id) {
+  frames_[frame_id].accesses_.clear();
+  frames_[frame_id].evictable_ = false;
+}
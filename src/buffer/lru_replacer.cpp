@@ -1,44 +1,72 @@
 #include "buffer/lru_replacer.h"
 
-LRUReplacer::LRUReplacer(size_t num_pages){
-  max_num_pages=num_pages;
-}
+LRUReplacer::LRUReplacer(size_t num_pages) : nodes_(num_pages) {}
 
 LRUReplacer::~LRUReplacer() = default;
 
 bool LRUReplacer::Victim(frame_id_t *frame_id) {
-  if(lru_list_.empty()) return false;
-  *frame_id=lru_list_.front();
-  lru_list_.pop_front();
+  std::scoped_lock<std::mutex> lock(latch_);
+  if (head_ == INVALID_FRAME_ID) return false;
+  *frame_id = head_;
+  Unlink(head_);
   return true;
 }
 
 void LRUReplacer::Pin(frame_id_t frame_id) {
-  std::list<frame_id_t>::iterator it;
-  it=std::find(lru_list_.begin(),lru_list_.end(),frame_id);
-  if(lru_list_.size()!=0 && !(it==lru_list_.end()&&lru_list_.back()!=frame_id)){
-    lru_list_.erase(it);
+  std::scoped_lock<std::mutex> lock(latch_);
+  if (static_cast<size_t>(frame_id) < nodes_.size() && nodes_[frame_id].in_list_) {
+    Unlink(frame_id);
   }
 }
 
 void LRUReplacer::Unpin(frame_id_t frame_id) {
-  std::list<frame_id_t>::iterator it;
-  it=std::find(lru_list_.begin(),lru_list_.end(),frame_id);
-  if(lru_list_.size()==0){
-    lru_list_.push_back(frame_id);
+  std::scoped_lock<std::mutex> lock(latch_);
+  if (static_cast<size_t>(frame_id) >= nodes_.size()) {
+    nodes_.resize(frame_id + 1);
   }
-  else{
-    if(it==lru_list_.end()&&lru_list_.back()!=frame_id){
-      if(lru_list_.size()==max_num_pages) lru_list_.pop_front();
-      lru_list_.push_back(frame_id);
-    }
-    else{
-      lru_list_.erase(it);
-      lru_list_.push_back(frame_id);
-    }
+  Node &node = nodes_[frame_id];
+  // unpinning a frame that is already evictable keeps its position
+  if (node.in_list_) return;
+  node.prev_ = tail_;
+  node.next_ = INVALID_FRAME_ID;
+  node.in_list_ = true;
+  if (tail_ != INVALID_FRAME_ID) {
+    nodes_[tail_].next_ = frame_id;
+  } else {
+    head_ = frame_id;
   }
+  tail_ = frame_id;
+  size_++;
+}
+
+std::vector<frame_id_t> LRUReplacer::GetFramesByPriority() {
+  std::scoped_lock<std::mutex> lock(latch_);
+  std::vector<frame_id_t> frames;
+  frames.reserve(size_);
+  for (frame_id_t frame_id = tail_; frame_id != INVALID_FRAME_ID; frame_id = nodes_[frame_id].prev_) {
+    frames.push_back(frame_id);
+  }
+  return frames;
 }
 
 size_t LRUReplacer::Size() {
-  return lru_list_.size();
-}
\ No newline at end of file
+  std::scoped_lock<std::mutex> lock(latch_);
+  return size_;
+}
+
+void LRUReplacer::Unlink(frame_id_t frame_id) {
+  Node &node = nodes_[frame_id];
+  if (node.prev_ != INVALID_FRAME_ID) {
+    nodes_[node.prev_].next_ = node.next_;
+  } else {
+    head_ = node.next_;
+  }
+  if (node.next_ != INVALID_FRAME_ID) {
+    nodes_[node.next_].prev_ = node.prev_;
+  } else {
+    tail_ = node.prev_;
+  }
+  node.prev_ = node.next_ = INVALID_FRAME_ID;
+  node.in_list_ = false;
+  size_--;
+}
@@ -0,0 +1,154 @@
+#include <cstdint>
+#include <cstring>
+
+#include "buffer/lz_codec.h"
+
+namespace {
+
+constexpr size_t LZ_MIN_MATCH = 4;         // shortest match worth a sequence
+constexpr size_t LZ_MAX_OFFSET = 0xFFFF;   // offsets are two bytes
+constexpr int LZ_HASH_BITS = 12;           // the match finder remembers one position per hash of 4 bytes
+constexpr size_t LZ_NIBBLE_MAX = 15;
+
+inline uint32_t Load32(const char *p) {
+  uint32_t value;
+  memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+inline uint32_t Hash(uint32_t sequence) { return (sequence * 2654435761u) >> (32 - LZ_HASH_BITS); }
+
+/** Write the extension bytes of a length whose nibble is saturated. */
+inline bool PutLength(size_t length, char *dst, size_t capacity, size_t *op) {
+  for (; length >= 255; length -= 255) {
+    if (*op == capacity) {
+      return false;
+    }
+    dst[(*op)++] = static_cast<char>(255);
+  }
+  if (*op == capacity) {
+    return false;
+  }
+  dst[(*op)++] = static_cast<char>(length);
+  return true;
+}
+
+/** Read the extension bytes of a length whose nibble is saturated. */
+inline bool GetLength(const unsigned char *src, size_t size, size_t *ip, size_t *length) {
+  unsigned char byte;
+  do {
+    if (*ip == size) {
+      return false;
+    }
+    byte = src[(*ip)++];
+    *length += byte;
+  } while (byte == 255);
+  return true;
+}
+
+/** Write one sequence, match_length is 0 for the last one. */
+bool PutSequence(const char *literals, size_t literal_length, size_t offset, size_t match_length, char *dst,
+                 size_t capacity, size_t *op) {
+  if (*op == capacity) {
+    return false;
+  }
+  size_t match_code = match_length == 0 ? 0 : match_length - LZ_MIN_MATCH;
+  dst[(*op)++] = static_cast<char>(((literal_length < LZ_NIBBLE_MAX ? literal_length : LZ_NIBBLE_MAX) << 4) |
+                                   (match_code < LZ_NIBBLE_MAX ? match_code : LZ_NIBBLE_MAX));
+  if (literal_length >= LZ_NIBBLE_MAX && !PutLength(literal_length - LZ_NIBBLE_MAX, dst, capacity, op)) {
+    return false;
+  }
+  if (capacity - *op < literal_length) {
+    return false;
+  }
+  memcpy(dst + *op, literals, literal_length);
+  *op += literal_length;
+  if (match_length == 0) {
+    return true;
+  }
+  if (capacity - *op < 2) {
+    return false;
+  }
+  dst[(*op)++] = static_cast<char>(offset & 0xFF);
+  dst[(*op)++] = static_cast<char>(offset >> 8);
+  return match_code < LZ_NIBBLE_MAX || PutLength(match_code - LZ_NIBBLE_MAX, dst, capacity, op);
+}
+
+}  // namespace
+
+// 1.   Hash the 4 bytes at every position and look up the last position with the same hash.
+// 2.   If those 4 bytes really match and are close enough, extend the match as far as it goes and emit the literals
+//      since the previous match together with it.
+// 3.   Emit whatever is left after the last match as literals.
+size_t LZCodec::Compress(const char *src, size_t size, char *dst, size_t capacity) {
+  uint32_t table[1 << LZ_HASH_BITS];
+  memset(table, 0, sizeof(table));
+  size_t ip = 0;
+  size_t anchor = 0;
+  size_t op = 0;
+  while (ip + LZ_MIN_MATCH <= size) {
+    uint32_t sequence = Load32(src + ip);
+    uint32_t hash = Hash(sequence);
+    size_t candidate = table[hash];
+    table[hash] = static_cast<uint32_t>(ip);
+    if (candidate >= ip || ip - candidate > LZ_MAX_OFFSET || Load32(src + candidate) != sequence) {
+      ip++;
+      continue;
+    }
+    size_t match_length = LZ_MIN_MATCH;
+    while (ip + match_length < size && src[candidate + match_length] == src[ip + match_length]) {
+      match_length++;
+    }
+    if (!PutSequence(src + anchor, ip - anchor, ip - candidate, match_length, dst, capacity, &op)) {
+      return 0;
+    }
+    ip += match_length;
+    anchor = ip;
+  }
+  if (!PutSequence(src + anchor, size - anchor, 0, 0, dst, capacity, &op)) {
+    return 0;
+  }
+  return op;
+}
+
+bool LZCodec::Decompress(const char *src, size_t size, char *dst, size_t capacity) {
+  auto in = reinterpret_cast<const unsigned char *>(src);
+  size_t ip = 0;
+  size_t op = 0;
+  while (ip < size) {
+    unsigned char token = in[ip++];
+    size_t literal_length = token >> 4;
+    if (literal_length == LZ_NIBBLE_MAX && !GetLength(in, size, &ip, &literal_length)) {
+      return false;
+    }
+    if (size - ip < literal_length || capacity - op < literal_length) {
+      return false;
+    }
+    memcpy(dst + op, src + ip, literal_length);
+    ip += literal_length;
+    op += literal_length;
+    if (ip == size) {
+      break;
+    }
+    if (size - ip < 2) {
+      return false;
+    }
+    size_t offset = in[ip] | (static_cast<size_t>(in[ip + 1]) << 8);
+    ip += 2;
+    size_t match_length = token & 0x0F;
+    if (match_length == LZ_NIBBLE_MAX && !GetLength(in, size, &ip, &match_length)) {
+      return false;
+    }
+    match_length += LZ_MIN_MATCH;
+    if (offset == 0 || offset > op || capacity - op < match_length) {
+      return false;
+    }
+    // the match may overlap the bytes it produces, a run of one byte has offset 1
+    const char *match = dst + op - offset;
+    for (size_t i = 0; i < match_length; i++) {
+      dst[op + i] = match[i];
+    }
+    op += match_length;
+  }
+  return op == capacity;
+}
@@ -0,0 +1,106 @@
+#include <algorithm>
+
+#include "buffer/mapped_buffer_pool_manager.h"
+#include "glog/logging.h"
+
+MappedBufferPoolManager::MappedBufferPoolManager(DiskManager *disk_manager) : disk_manager_(disk_manager) {
+  ASSERT(disk_manager_->IsReadOnly(), "A mapped buffer pool needs a read-only disk manager.");
+}
+
+Page *MappedBufferPoolManager::FetchPage(page_id_t page_id) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  stats_.fetches_++;
+  auto it = pages_.find(page_id);
+  if (it == pages_.end()) {
+    char *data = disk_manager_->GetMappedPage(page_id);
+    if (data == nullptr) {
+      stats_.failed_fetches_++;
+      return nullptr;
+    }
+    auto mapped = std::make_unique<MappedPage>();
+    mapped->page_id_ = page_id;
+    mapped->page_.reset(new Page(data, &mapped->page_id_, &mapped->pin_count_, &mapped->is_dirty_));
+    it = pages_.emplace(page_id, std::move(mapped)).first;
+    stats_.misses_++;
+  } else {
+    stats_.hits_++;
+  }
+  it->second->pin_count_++;
+  stats_.pinned_high_water_ = std::max(stats_.pinned_high_water_, pages_.size());
+  return it->second->page_.get();
+}
+
+std::vector<Page *> MappedBufferPoolManager::FetchPages(const std::vector<page_id_t> &page_ids) {
+  std::vector<Page *> pages;
+  pages.reserve(page_ids.size());
+  for (auto page_id : page_ids) {
+    pages.push_back(FetchPage(page_id));
+  }
+  return pages;
+}
+
+bool MappedBufferPoolManager::UnpinPage(page_id_t page_id, bool is_dirty) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  auto it = pages_.find(page_id);
+  if (it == pages_.end()) {
+    return false;
+  }
+  if (is_dirty) {
+    LOG(ERROR) << "Rejected dirty unpin of page " << page_id << " of a read-only database";
+  }
+  if (--it->second->pin_count_ == 0) {
+    pages_.erase(it);
+  }
+  return true;
+}
+
+bool MappedBufferPoolManager::FlushPage(page_id_t page_id) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  return pages_.count(page_id) > 0;
+}
+
+Page *MappedBufferPoolManager::NewPage(page_id_t &page_id) {
+  LOG(ERROR) << "Rejected new page in a read-only database";
+  page_id = INVALID_PAGE_ID;
+  return nullptr;
+}
+
+bool MappedBufferPoolManager::DeletePage(page_id_t page_id) {
+  LOG(ERROR) << "Rejected deletion of page " << page_id << " of a read-only database";
+  return false;
+}
+
+bool MappedBufferPoolManager::IsPageFree(page_id_t page_id) { return disk_manager_->IsPageFree(page_id); }
+
+bool MappedBufferPoolManager::CheckAllUnpinned() {
+  std::scoped_lock<std::mutex> lock(latch_);
+  return pages_.empty();
+}
+
+BufferPoolStats MappedBufferPoolManager::GetStats() {
+  std::scoped_lock<std::mutex> lock(latch_);
+  BufferPoolStats stats = stats_;
+  stats.resident_pages_ = pages_.size();
+  stats.pinned_frames_ = pages_.size();
+  return stats;
+}
+
+void MappedBufferPoolManager::PrefetchPages(const std::vector<page_id_t> &page_ids) {
+  disk_manager_->AdviseWillNeed(page_ids);
+}
+
+void MappedBufferPoolManager::PrefetchChain(page_id_t page_id, size_t count, NextPageIdReader next_page_id) {
+  if (page_id != INVALID_PAGE_ID && count != 0) {
+    disk_manager_->AdviseWillNeed({page_id});
+  }
+}
+
+std::vector<page_id_t> MappedBufferPoolManager::GetResidentPages() {
+  std::scoped_lock<std::mutex> lock(latch_);
+  std::vector<page_id_t> page_ids;
+  page_ids.reserve(pages_.size());
+  for (auto &entry : pages_) {
+    page_ids.push_back(entry.first);
+  }
+  return page_ids;
+}
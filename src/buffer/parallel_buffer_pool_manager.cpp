@@ -0,0 +1,233 @@
+#include <algorithm>
+
+#include "buffer/parallel_buffer_pool_manager.h"
+
+ParallelBufferPoolManager::ParallelBufferPoolManager(size_t num_instances, size_t pool_size,
+                                                     DiskManager *disk_manager, ReplacerType replacer_type)
+    : num_instances_(num_instances), pool_size_(pool_size), disk_manager_(disk_manager) {
+  ASSERT(num_instances_ > 0, "A parallel buffer pool needs at least one instance.");
+  instances_.reserve(num_instances_);
+  for (size_t i = 0; i < num_instances_; i++) {
+    instances_.push_back(new BufferPoolManagerInstance(pool_size_, num_instances_, i, disk_manager_, replacer_type));
+    instances_.back()->SetChainPool(this);
+  }
+}
+
+ParallelBufferPoolManager::~ParallelBufferPoolManager() {
+  // a prefetch thread may queue pages on any shard, so all of them are stopped before the first shard is deleted
+  for (auto instance : instances_) {
+    instance->StopPrefetcher();
+  }
+  // flush all shards as one batch, the shards find nothing left to write when they are deleted
+  StopPageCleaner();
+  FlushAllPages();
+  for (auto instance : instances_) {
+    delete instance;
+  }
+}
+
+Page *ParallelBufferPoolManager::FetchPage(page_id_t page_id) { return GetInstance(page_id)->FetchPage(page_id); }
+
+std::vector<Page *> ParallelBufferPoolManager::FetchPages(const std::vector<page_id_t> &page_ids) {
+  std::vector<std::vector<page_id_t>> per_instance(num_instances_);
+  std::vector<std::vector<size_t>> positions(num_instances_);
+  for (size_t i = 0; i < page_ids.size(); i++) {
+    size_t instance = static_cast<size_t>(page_ids[i]) % num_instances_;
+    per_instance[instance].push_back(page_ids[i]);
+    positions[instance].push_back(i);
+  }
+  std::vector<Page *> pages(page_ids.size());
+  for (size_t i = 0; i < num_instances_; i++) {
+    if (per_instance[i].empty()) {
+      continue;
+    }
+    std::vector<Page *> fetched = instances_[i]->FetchPages(per_instance[i]);
+    for (size_t j = 0; j < fetched.size(); j++) {
+      pages[positions[i][j]] = fetched[j];
+    }
+  }
+  return pages;
+}
+
+bool ParallelBufferPoolManager::UnpinPage(page_id_t page_id, bool is_dirty) {
+  return GetInstance(page_id)->UnpinPage(page_id, is_dirty);
+}
+
+bool ParallelBufferPoolManager::FlushPage(page_id_t page_id) {
+  if (page_id == INVALID_PAGE_ID) return false;
+  return GetInstance(page_id)->FlushPage(page_id);
+}
+
+// Shards are latched in index order, no other path holds more than one shard latch at a time.
+void ParallelBufferPoolManager::FlushAllPages() {
+  FlushBatch batch;
+  for (auto instance : instances_) {
+    instance->CollectFlushBatch(&batch);
+  }
+  disk_manager_->WritePages(batch.pages_);
+  disk_manager_->Sync();
+}
+
+// 1.   Allocate the page on disk, the disk manager serializes concurrent allocations.
+// 2.   Hand the page to the shard it belongs to.
+// 3.   If every frame of that shard is pinned, give the page back to the disk and return nullptr.
+Page *ParallelBufferPoolManager::NewPage(page_id_t &page_id) {
+  return InstallNewPage(page_id, disk_manager_->AllocatePage());
+}
+
+Page *ParallelBufferPoolManager::NewPageNear(page_id_t &page_id, page_id_t near_page_id) {
+  return InstallNewPage(page_id, disk_manager_->AllocatePageNear(near_page_id));
+}
+
+Page *ParallelBufferPoolManager::InstallNewPage(page_id_t &page_id, page_id_t allocated_page_id) {
+  page_id = allocated_page_id;
+  if (page_id == INVALID_PAGE_ID) {
+    return nullptr;
+  }
+  Page *result = GetInstance(page_id)->InstallNewPage(page_id);
+  if (result == nullptr) {
+    disk_manager_->DeAllocatePage(page_id);
+    page_id = INVALID_PAGE_ID;
+  }
+  return result;
+}
+
+bool ParallelBufferPoolManager::DeletePage(page_id_t page_id) { return GetInstance(page_id)->DeletePage(page_id); }
+
+size_t ParallelBufferPoolManager::GetPoolSize() {
+  size_t pool_size = 0;
+  for (auto instance : instances_) {
+    pool_size += instance->GetPoolSize();
+  }
+  return pool_size;
+}
+
+bool ParallelBufferPoolManager::ResizePool(size_t pool_size) {
+  if (pool_size < num_instances_ || (pool_size + num_instances_ - 1) / num_instances_ > BUFFER_POOL_MAX_SIZE) {
+    return false;
+  }
+  // every shard is resized even if an earlier one failed, so that as many as possible reach their size
+  bool resized = true;
+  for (size_t i = 0; i < num_instances_; i++) {
+    if (!instances_[i]->ResizePool(pool_size / num_instances_ + (i < pool_size % num_instances_ ? 1 : 0))) {
+      resized = false;
+    }
+  }
+  return resized;
+}
+
+void ParallelBufferPoolManager::SetFrameQuota(size_t frames) {
+  for (size_t i = 0; i < num_instances_; i++) {
+    instances_[i]->SetFrameQuota(frames / num_instances_ + (i < frames % num_instances_ ? 1 : 0));
+  }
+}
+
+void ParallelBufferPoolManager::SetResidencyHint(const std::vector<page_id_t> &page_ids, bool cached) {
+  std::vector<std::vector<page_id_t>> per_instance(num_instances_);
+  for (auto page_id : page_ids) {
+    per_instance[static_cast<size_t>(page_id) % num_instances_].push_back(page_id);
+  }
+  for (size_t i = 0; i < num_instances_; i++) {
+    if (!per_instance[i].empty()) {
+      instances_[i]->SetResidencyHint(per_instance[i], cached);
+    }
+  }
+}
+
+void ParallelBufferPoolManager::SetCompressedCacheSize(size_t capacity) {
+  for (auto instance : instances_) {
+    instance->SetCompressedCacheSize(capacity / num_instances_);
+  }
+}
+
+bool ParallelBufferPoolManager::IsPageFree(page_id_t page_id) { return disk_manager_->IsPageFree(page_id); }
+
+bool ParallelBufferPoolManager::CheckAllUnpinned() {
+  bool res = true;
+  for (auto instance : instances_) {
+    res = instance->CheckAllUnpinned() && res;
+  }
+  return res;
+}
+
+void ParallelBufferPoolManager::StartPageCleaner(double clean_fraction) {
+  for (auto instance : instances_) {
+    instance->StartPageCleaner(clean_fraction);
+  }
+}
+
+void ParallelBufferPoolManager::StopPageCleaner() {
+  for (auto instance : instances_) {
+    instance->StopPageCleaner();
+  }
+}
+
+uint64_t ParallelBufferPoolManager::GetForegroundWritebacks() {
+  uint64_t total = 0;
+  for (auto instance : instances_) {
+    total += instance->GetForegroundWritebacks();
+  }
+  return total;
+}
+
+uint64_t ParallelBufferPoolManager::GetBackgroundWritebacks() {
+  uint64_t total = 0;
+  for (auto instance : instances_) {
+    total += instance->GetBackgroundWritebacks();
+  }
+  return total;
+}
+
+BufferPoolStats ParallelBufferPoolManager::GetStats() {
+  BufferPoolStats stats;
+  for (auto instance : instances_) {
+    stats += instance->GetStats();
+  }
+  return stats;
+}
+
+std::map<page_owner_t, PageOwnerStats> ParallelBufferPoolManager::GetOwnerStats() {
+  std::map<page_owner_t, PageOwnerStats> owner_stats;
+  for (auto instance : instances_) {
+    for (auto &[owner, stats] : instance->GetOwnerStats()) {
+      owner_stats[owner] += stats;
+    }
+  }
+  return owner_stats;
+}
+
+void ParallelBufferPoolManager::PrefetchPages(const std::vector<page_id_t> &page_ids) {
+  std::vector<std::vector<page_id_t>> per_instance(num_instances_);
+  for (auto page_id : page_ids) {
+    per_instance[static_cast<size_t>(page_id) % num_instances_].push_back(page_id);
+  }
+  for (size_t i = 0; i < num_instances_; i++) {
+    if (!per_instance[i].empty()) {
+      instances_[i]->PrefetchPages(per_instance[i]);
+    }
+  }
+}
+
+void ParallelBufferPoolManager::PrefetchChain(page_id_t page_id, size_t count, NextPageIdReader next_page_id) {
+  if (page_id != INVALID_PAGE_ID) {
+    GetInstance(page_id)->PrefetchChain(page_id, count, next_page_id);
+  }
+}
+
+std::vector<page_id_t> ParallelBufferPoolManager::GetResidentPages() {
+  std::vector<std::vector<page_id_t>> per_instance;
+  size_t longest = 0;
+  for (auto instance : instances_) {
+    per_instance.push_back(instance->GetResidentPages());
+    longest = std::max(longest, per_instance.back().size());
+  }
+  std::vector<page_id_t> page_ids;
+  for (size_t rank = 0; rank < longest; rank++) {
+    for (auto &resident : per_instance) {
+      if (rank < resident.size()) {
+        page_ids.push_back(resident[rank]);
+      }
+    }
+  }
+  return page_ids;
+}
@@ -0,0 +1,83 @@
+#include "buffer/priority_replacer.h"
+
+PriorityReplacer::PriorityReplacer(Replacer *normal, Replacer *protect, size_t num_pages,
+                                   double max_protected_fraction)
+    : normal_(normal),
+      protect_(protect),
+      frames_(num_pages),
+      max_protected_frames_(static_cast<size_t>(max_protected_fraction * num_pages)),
+      max_protected_fraction_(max_protected_fraction) {}
+
+bool PriorityReplacer::Victim(frame_id_t *frame_id) {
+  bool found;
+  if (protected_frames_ > max_protected_frames_) {
+    found = protect_->Victim(frame_id) || normal_->Victim(frame_id);
+  } else {
+    found = normal_->Victim(frame_id) || protect_->Victim(frame_id);
+  }
+  if (found) {
+    frames_[*frame_id].evictable_ = false;
+  }
+  return found;
+}
+
+void PriorityReplacer::Pin(frame_id_t frame_id) {
+  Slot(frame_id).evictable_ = false;
+  ReplacerOf(frame_id)->Pin(frame_id);
+}
+
+void PriorityReplacer::Unpin(frame_id_t frame_id) {
+  Slot(frame_id).evictable_ = true;
+  ReplacerOf(frame_id)->Unpin(frame_id);
+}
+
+void PriorityReplacer::Remove(frame_id_t frame_id) {
+  Slot(frame_id).evictable_ = false;
+  ReplacerOf(frame_id)->Remove(frame_id);
+}
+
+void PriorityReplacer::Resize(size_t num_pages) {
+  for (size_t i = num_pages; i < frames_.size(); i++) {
+    if (frames_[i].protected_) {
+      protected_frames_--;
+    }
+  }
+  frames_.resize(num_pages);
+  max_protected_frames_ = static_cast<size_t>(max_protected_fraction_ * num_pages);
+  normal_->Resize(num_pages);
+  protect_->Resize(num_pages);
+}
+
+std::vector<frame_id_t> PriorityReplacer::GetFramesByPriority() {
+  std::vector<frame_id_t> frames = protect_->GetFramesByPriority();
+  std::vector<frame_id_t> normal = normal_->GetFramesByPriority();
+  frames.insert(frames.end(), normal.begin(), normal.end());
+  return frames;
+}
+
+size_t PriorityReplacer::Size() { return normal_->Size() + protect_->Size(); }
+
+void PriorityReplacer::SetProtected(frame_id_t frame_id, bool is_protected) {
+  FrameClass &frame = Slot(frame_id);
+  if (frame.protected_ == is_protected) {
+    return;
+  }
+  Replacer *from = ReplacerOf(frame_id);
+  from->Remove(frame_id);
+  frame.protected_ = is_protected;
+  if (is_protected) {
+    protected_frames_++;
+  } else {
+    protected_frames_--;
+  }
+  if (frame.evictable_) {
+    ReplacerOf(frame_id)->Unpin(frame_id);
+  }
+}
+
+PriorityReplacer::FrameClass &PriorityReplacer::Slot(frame_id_t frame_id) {
+  if (static_cast<size_t>(frame_id) >= frames_.size()) {
+    frames_.resize(frame_id + 1);
+  }
+  return frames_[frame_id];
+}
@@ -0,0 +1,23 @@
+#include "buffer/read_ahead.h"
+
+void ReadAhead::Advance(page_id_t next_page_id) {
+  if (buffer_pool_manager_ == nullptr || next_page_id_ == nullptr) {
+    return;
+  }
+  pages_scanned_++;
+  if (requested_ahead_ > 0) {
+    requested_ahead_--;
+  }
+
+  size_t window = buffer_pool_manager_->GetReadAheadWindow();
+  if (window == 0 || next_page_id == INVALID_PAGE_ID || pages_scanned_ < READ_AHEAD_TRIGGER) {
+    return;
+  }
+  // refill once half of the window has been consumed
+  if (requested_ahead_ > window / 2) {
+    return;
+  }
+  // the pool walks the pages still in flight again, they cost no reads and lead it to the end of the window
+  buffer_pool_manager_->PrefetchChain(next_page_id, window, next_page_id_);
+  requested_ahead_ = window;
+}
@@ -0,0 +1,178 @@
+#include <algorithm>
+#include <chrono>
+
+#include "buffer/shared_buffer_pool.h"
+
+SharedBufferPool::SharedBufferPool(size_t pool_size, int interval_ms)
+    : pool_size_(pool_size), interval_ms_(interval_ms) {
+  if (interval_ms_ > 0) {
+    running_ = true;
+    rebalance_thread_ = std::thread(&SharedBufferPool::RunRebalancer, this);
+  }
+}
+
+SharedBufferPool::~SharedBufferPool() {
+  {
+    std::scoped_lock<std::mutex> lock(latch_);
+    running_ = false;
+  }
+  rebalance_cv_.notify_one();
+  if (rebalance_thread_.joinable()) {
+    rebalance_thread_.join();
+  }
+}
+
+void SharedBufferPool::Register(BufferPoolManager *bpm, size_t min_frames, size_t max_frames) {
+  std::unique_lock<std::mutex> lock(latch_);
+  ASSERT(Find(bpm) == nullptr, "Buffer pool registered twice.");
+  size_t reserved = 0;
+  for (auto &member : members_) {
+    reserved += member.quota_.min_frames_;
+  }
+  Member member{bpm, {}, bpm->GetStats().fetches_};
+  member.quota_.min_frames_ = std::min(min_frames, pool_size_ - reserved);
+  member.quota_.max_frames_ = std::max(max_frames == 0 ? pool_size_ : max_frames, member.quota_.min_frames_);
+  members_.push_back(member);
+  Distribution distribution = Distribute();
+  lock.unlock();
+  Apply(distribution);
+}
+
+void SharedBufferPool::Unregister(BufferPoolManager *bpm) {
+  std::unique_lock<std::mutex> lock(latch_);
+  auto it = std::find_if(members_.begin(), members_.end(), [bpm](const Member &member) { return member.bpm_ == bpm; });
+  if (it == members_.end()) {
+    return;
+  }
+  members_.erase(it);
+  Distribution distribution = Distribute();
+  lock.unlock();
+  Apply(distribution);
+}
+
+bool SharedBufferPool::SetLimits(BufferPoolManager *bpm, size_t min_frames, size_t max_frames) {
+  std::unique_lock<std::mutex> lock(latch_);
+  Member *target = Find(bpm);
+  if (target == nullptr || min_frames > max_frames) {
+    return false;
+  }
+  size_t reserved = min_frames;
+  for (auto &member : members_) {
+    if (&member != target) {
+      reserved += member.quota_.min_frames_;
+    }
+  }
+  if (reserved > pool_size_) {
+    return false;
+  }
+  target->quota_.min_frames_ = min_frames;
+  target->quota_.max_frames_ = max_frames;
+  Distribution distribution = Distribute();
+  lock.unlock();
+  Apply(distribution);
+  return true;
+}
+
+SharedBufferPoolQuota SharedBufferPool::GetQuota(BufferPoolManager *bpm) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  Member *member = Find(bpm);
+  return member == nullptr ? SharedBufferPoolQuota() : member->quota_;
+}
+
+void SharedBufferPool::Rebalance() {
+  std::unique_lock<std::mutex> lock(latch_);
+  for (auto &member : members_) {
+    uint64_t fetches = member.bpm_->GetStats().fetches_;
+    double interval_load = static_cast<double>(fetches - member.last_fetches_);
+    member.last_fetches_ = fetches;
+    member.quota_.load_ =
+        SHARED_BUFFER_POOL_LOAD_WEIGHT * interval_load + (1 - SHARED_BUFFER_POOL_LOAD_WEIGHT) * member.quota_.load_;
+  }
+  Distribution distribution = Distribute();
+  lock.unlock();
+  Apply(distribution);
+}
+
+SharedBufferPool::Member *SharedBufferPool::Find(BufferPoolManager *bpm) {
+  for (auto &member : members_) {
+    if (member.bpm_ == bpm) {
+      return &member;
+    }
+  }
+  return nullptr;
+}
+
+// 1.   Every pool gets its minimum.
+// 2.   The frames left are split in proportion to the load of the pools below their maximum. A pool counts with one
+//      fetch more than it had, so that pools without load split what nobody else wants. Shares that hit a maximum
+//      are cut, and the frames cut off are split again among the other pools.
+// 3.   Frames lost to rounding go to the busiest pools, one each.
+SharedBufferPool::Distribution SharedBufferPool::Distribute() {
+  size_t left = pool_size_;
+  std::vector<Member *> open;
+  for (auto &member : members_) {
+    member.quota_.frames_ = member.quota_.min_frames_;
+    left -= member.quota_.frames_;
+    if (member.quota_.frames_ < member.quota_.max_frames_) {
+      open.push_back(&member);
+    }
+  }
+  std::sort(open.begin(), open.end(), [](Member *a, Member *b) { return a->quota_.load_ > b->quota_.load_; });
+  while (left > 0 && !open.empty()) {
+    double total_load = 0;
+    for (auto member : open) {
+      total_load += member->quota_.load_ + 1;
+    }
+    size_t to_split = left;
+    std::vector<Member *> still_open;
+    for (auto member : open) {
+      auto share = static_cast<size_t>(to_split * (member->quota_.load_ + 1) / total_load);
+      share = std::min({share, left, member->quota_.max_frames_ - member->quota_.frames_});
+      member->quota_.frames_ += share;
+      left -= share;
+      if (member->quota_.frames_ < member->quota_.max_frames_) {
+        still_open.push_back(member);
+      }
+    }
+    // every pool took its full share, so whatever is left was lost to rounding
+    if (still_open.size() == open.size()) {
+      for (size_t i = 0; left > 0 && i < still_open.size(); i++) {
+        still_open[i]->quota_.frames_++;
+        left--;
+      }
+      break;
+    }
+    open = std::move(still_open);
+  }
+  Distribution distribution;
+  distribution.generation_ = ++generation_;
+  for (auto &member : members_) {
+    distribution.frames_.emplace_back(member.bpm_, member.quota_.frames_);
+  }
+  return distribution;
+}
+
+void SharedBufferPool::Apply(const Distribution &distribution) {
+  // shrinking a pool writes back its evicted pages, so the quotas are set without the latch
+  std::scoped_lock<std::mutex> lock(apply_latch_);
+  if (distribution.generation_ < applied_generation_) {
+    return;
+  }
+  applied_generation_ = distribution.generation_;
+  for (auto &[bpm, frames] : distribution.frames_) {
+    bpm->SetFrameQuota(frames);
+  }
+}
+
+void SharedBufferPool::RunRebalancer() {
+  std::unique_lock<std::mutex> lock(latch_);
+  while (running_) {
+    rebalance_cv_.wait_for(lock, std::chrono::milliseconds(interval_ms_));
+    if (!running_) {
+      break;
+    }
+    lock.unlock();
+    Rebalance();
+    lock.lock();
+  }
+}
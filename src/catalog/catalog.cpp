@@ -1,5 +1,7 @@
 #include "catalog/catalog.h"
 
+#include <algorithm>
+
 void CatalogMeta::SerializeTo(char *buf) const {
   char *p = buf;
 
@@ -105,25 +107,14 @@ CatalogManager::CatalogManager(BufferPoolManager *buffer_pool_manager, LockManag
     char *table = page->GetData();
 
     catalog_meta_ = CatalogMeta::DeserializeFrom(table, heap_);
+    buffer_pool_manager->UnpinPage(CATALOG_META_PAGE_ID, false);
     next_index_id_ = catalog_meta_->GetNextIndexId();
     next_table_id_ = catalog_meta_->GetNextTableId();
 
     for (auto item : catalog_meta_->table_meta_pages_) {
       // 如果逻辑页号正确的话
       if (item.second >= 0) {
-        TableInfo *tableInfo;
-        TableMetadata *meta = nullptr;
-        meta->DeserializeFrom(table, meta, heap_);
-
-        page = buffer_pool_manager->FetchPage(item.second);
-        table = page->GetData();
-        tableInfo = TableInfo::Create(heap_);
-        TableHeap *table_heap =
-            TableHeap::Create(buffer_pool_manager_, meta->GetSchema(), nullptr, log_manager_, lock_manager_, heap_);
-        tableInfo->Init(meta, table_heap);
-        table_names_[meta->GetTableName()] = meta->GetTableId();
-        tables_[meta->GetTableId()] = tableInfo;
-        index_names_.insert({meta->GetTableName(), unordered_map<std::string, index_id_t>()});
+        LoadTable(item.first, item.second);
       }
     }
 
@@ -134,9 +125,14 @@ CatalogManager::CatalogManager(BufferPoolManager *buffer_pool_manager, LockManag
         page = buffer_pool_manager->FetchPage(item.second);
         table = page->GetData();
         IndexMetadata::DeserializeFrom(table, meta, heap_);
+        buffer_pool_manager->UnpinPage(item.second, false);
         TableInfo *tableInfo = tables_[meta->GetTableId()];
         IndexInfo *indexInfo = IndexInfo::Create(heap_);
         indexInfo->Init(meta, tableInfo, buffer_pool_manager_);
+        indexInfo->GetIndex()->SetOwner(IndexOwner(meta->GetIndexId()));
+        if (meta->IsCached()) {
+          indexInfo->GetIndex()->SetCached(true);
+        }
         index_names_[tableInfo->GetTableName()][meta->GetIndexName()] = meta->GetIndexId();
         indexes_[meta->GetIndexId()] = indexInfo;
       }
@@ -148,6 +144,7 @@ CatalogManager::~CatalogManager() { delete heap_; }
 
 dberr_t CatalogManager::CreateTable(const string &table_name, TableSchema *schema, Transaction *txn,
                                     TableInfo *&table_info) {
+  if (buffer_pool_manager_->RejectWrite("create table")) return DB_FAILED;
   if (table_names_.count(table_name) > 0) return DB_INDEX_ALREADY_EXIST;
 
   table_id_t tableId = next_table_id_++;
@@ -157,10 +154,12 @@ dberr_t CatalogManager::CreateTable(const string &table_name, TableSchema *schem
   catalog_meta_->table_meta_pages_[tableId] = pageId;
   catalog_meta_->table_meta_pages_[next_table_id_] = -1;
 
-  TableMetadata *table_meta = TableMetadata::Create(tableId, table_name, pageId, schema, heap_);
   TableHeap *table_heap = TableHeap::Create(buffer_pool_manager_, schema, txn, log_manager_, lock_manager_, heap_);
+  TableMetadata *table_meta =
+      TableMetadata::Create(tableId, table_name, table_heap->GetFirstPageId(), schema, heap_);
   table_info = TableInfo::Create(heap_);
   table_info->Init(table_meta, table_heap);
+  table_heap->SetOwner(TableOwner(tableId));
 
   table_names_[table_name] = tableId;
   tables_[tableId] = table_info;
@@ -171,13 +170,8 @@ dberr_t CatalogManager::CreateTable(const string &table_name, TableSchema *schem
   table_meta->SerializeTo(meta);
   char *p = new_table_page->GetData();
   memcpy(p, meta, len);
-
-  len = catalog_meta_->GetSerializedSize();
-  char buf[len + 1];
-  catalog_meta_->SerializeTo(buf);
-  p = buffer_pool_manager_->FetchPage(0)->GetData();
-  memset(p, 0, PAGE_SIZE);
-  memcpy(p, buf, len);
+  buffer_pool_manager_->UnpinPage(pageId, true);
+  FlushCatalogMetaPage();
 
   if (table_heap != nullptr) return DB_SUCCESS;
   return DB_FAILED;
@@ -201,6 +195,7 @@ dberr_t CatalogManager::GetTables(vector<TableInfo *> &tables) const {
 dberr_t CatalogManager::CreateIndex(const std::string &table_name, const string &index_name,
                                     const std::vector<std::string> &index_keys, Transaction *txn,
                                     IndexInfo *&index_info) {
+  if (buffer_pool_manager_->RejectWrite("create index")) return DB_FAILED;
   if (index_names_.count(table_name) > 0) return DB_TABLE_NOT_EXIST;
 
   auto item = index_names_[table_name];
@@ -224,6 +219,7 @@ dberr_t CatalogManager::CreateIndex(const std::string &table_name, const string
 
   index_info = IndexInfo::Create(heap_);
   index_info->Init(index_meta_data_ptr, tableInfo, buffer_pool_manager_);
+  index_info->GetIndex()->SetOwner(IndexOwner(indexId));
 
   index_names_[table_name][index_name] = indexId;
   indexes_[indexId] = index_info;
@@ -238,13 +234,8 @@ dberr_t CatalogManager::CreateIndex(const std::string &table_name, const string
   index_meta_data_ptr->SerializeTo(meta);
   char *p = new_index_page->GetData();
   memcpy(p, meta, len);
-
-  len = catalog_meta_->GetSerializedSize();
-  char cmeta[len + 1];
-  catalog_meta_->SerializeTo(cmeta);
-  p = buffer_pool_manager_->FetchPage(0)->GetData();
-  memset(p, 0, PAGE_SIZE);
-  memcpy(p, cmeta, len);
+  buffer_pool_manager_->UnpinPage(pageId, true);
+  FlushCatalogMetaPage();
 
   return DB_SUCCESS;
 }
@@ -278,31 +269,35 @@ dberr_t CatalogManager::GetTableIndexes(const std::string &table_name, std::vect
 }
 
 dberr_t CatalogManager::DropTable(const string &table_name) {
+  if (buffer_pool_manager_->RejectWrite("drop table")) return DB_FAILED;
   auto tableItem = table_names_.find(table_name);
   if (tableItem == table_names_.end()) return DB_TABLE_NOT_EXIST;
   table_id_t tid = tableItem->second;
 
+  // DropIndex erases from index_names_[table_name], so drop from a copy of the names
   auto indexItem = index_names_.find(table_name);
-  for (const auto &item : indexItem->second) {
-    DropIndex(table_name, item.first);
+  if (indexItem != index_names_.end()) {
+    std::vector<std::string> index_names;
+    for (const auto &item : indexItem->second) {
+      index_names.push_back(item.first);
+    }
+    for (const auto &index_name : index_names) {
+      DropIndex(table_name, index_name);
+    }
   }
 
+  tables_[tid]->GetTableHeap()->FreeHeap();
   index_names_.erase(table_name);
   tables_.erase(tid);
   page_id_t page_id = catalog_meta_->table_meta_pages_[tid];
   catalog_meta_->table_meta_pages_.erase(tid);
   buffer_pool_manager_->DeletePage(page_id);
   table_names_.erase(table_name);
-  auto len = catalog_meta_->GetSerializedSize();
-  char meta[len + 1];
-  catalog_meta_->SerializeTo(meta);
-  char *p = buffer_pool_manager_->FetchPage(0)->GetData();
-  memset(p, 0, PAGE_SIZE);
-  memcpy(p, meta, len);
-  return DB_SUCCESS;
+  return FlushCatalogMetaPage();
 }
 
 dberr_t CatalogManager::DropIndex(const string &table_name, const string &index_name) {
+  if (buffer_pool_manager_->RejectWrite("drop index")) return DB_FAILED;
   // ASSERT(false, "Not Implemented yet");
   auto tableItem = index_names_.find(table_name);
   if (tableItem == index_names_.end()) return DB_TABLE_NOT_EXIST;
@@ -313,26 +308,159 @@ dberr_t CatalogManager::DropIndex(const string &table_name, const string &index_
   page_id_t page_id = catalog_meta_->index_meta_pages_[index_id];
   catalog_meta_->index_meta_pages_.erase(index_id);
   tableItem->second.erase(index_name);
+  indexes_[index_id]->GetIndex()->Destroy();
   indexes_.erase(index_id);
   buffer_pool_manager_->DeletePage(page_id);
 
-  uint32_t len = catalog_meta_->GetSerializedSize();
-  char meta[len + 1];
-  catalog_meta_->SerializeTo(meta);
-  char *p = buffer_pool_manager_->FetchPage(0)->GetData();
-  memset(p, 0, PAGE_SIZE);
-  memcpy(p, meta, len);
+  return FlushCatalogMetaPage();
+}
+
+dberr_t CatalogManager::SetTableCached(const std::string &table_name, bool indexes, bool cached) {
+  if (buffer_pool_manager_->RejectWrite("alter table cache")) return DB_FAILED;
+  auto tableItem = table_names_.find(table_name);
+  if (tableItem == table_names_.end()) return DB_TABLE_NOT_EXIST;
+  table_id_t tid = tableItem->second;
+
+  if (!indexes) {
+    tables_[tid]->SetCached(cached);
+    return FlushTableMetaPage(tid);
+  }
+
+  std::vector<IndexInfo *> indexes_of_table;
+  dberr_t err = GetTableIndexes(table_name, indexes_of_table);
+  if (err != DB_SUCCESS) return err;
+  for (auto index_info : indexes_of_table) {
+    index_info->SetCached(cached);
+    page_id_t page_id = catalog_meta_->index_meta_pages_[index_info->GetIndexMeta()->GetIndexId()];
+    Page *page = buffer_pool_manager_->FetchPage(page_id);
+    if (page == nullptr) return DB_FAILED;
+    index_info->GetIndexMeta()->SerializeTo(page->GetData());
+    buffer_pool_manager_->UnpinPage(page_id, true);
+  }
   return DB_SUCCESS;
 }
 
+// 1.   Collect the pages of every table heap, highest page id first.
+// 2.   Move each page down until there is no free page below it, see TableHeap::RelocatePage.
+// 3.   Re-insert the index entries of the rows on a moved page with their new row ids.
+size_t CatalogManager::CompactTables() {
+  if (buffer_pool_manager_->RejectWrite("table compaction")) {
+    return 0;
+  }
+  std::vector<std::pair<page_id_t, TableInfo *>> pages;
+  for (const auto &item : tables_) {
+    for (auto page_id : item.second->GetTableHeap()->GetPageIds()) {
+      pages.emplace_back(page_id, item.second);
+    }
+  }
+  std::sort(pages.begin(), pages.end(), [](const auto &a, const auto &b) { return a.first > b.first; });
+
+  size_t moved = 0;
+  for (auto &[page_id, table_info] : pages) {
+    TableHeap *table_heap = table_info->GetTableHeap();
+    page_id_t new_page_id;
+    if (!table_heap->RelocatePage(page_id, new_page_id)) {
+      break;
+    }
+    moved++;
+    // a new head of the heap is recorded in the table metadata, which the heap is loaded from
+    if (table_heap->GetFirstPageId() != table_info->GetRootPageId()) {
+      table_info->GetTableMeta()->SetFirstPageId(table_heap->GetFirstPageId());
+      FlushTableMetaPage(table_info->GetTableId());
+    }
+    std::vector<IndexInfo *> indexes;
+    if (GetTableIndexes(table_info->GetTableName(), indexes) != DB_SUCCESS || indexes.empty()) {
+      continue;
+    }
+    std::vector<RowId> rids;
+    auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(new_page_id));
+    page->RLatch();
+    RowId rid;
+    for (bool found = page->GetFirstTupleRid(&rid); found; found = page->GetNextTupleRid(rid, &rid)) {
+      rids.push_back(rid);
+    }
+    page->RUnlatch();
+    buffer_pool_manager_->UnpinPage(new_page_id, false);
+    for (auto &new_rid : rids) {
+      Row row(new_rid);
+      if (!table_heap->GetTuple(&row, nullptr)) {
+        continue;
+      }
+      for (auto index_info : indexes) {
+        std::vector<Field> index_fields;
+        for (auto column : index_info->GetIndexKeySchema()->GetColumns()) {
+          uint32_t column_index;
+          if (table_info->GetSchema()->GetColumnIndex(column->GetName(), column_index) == DB_SUCCESS) {
+            index_fields.push_back(*row.GetField(column_index));
+          }
+        }
+        Row key(index_fields);
+        index_info->GetIndex()->RemoveEntry(key, RowId(page_id, new_rid.GetSlotNum()), nullptr);
+        index_info->GetIndex()->InsertEntry(key, new_rid, nullptr);
+      }
+    }
+  }
+  return moved;
+}
+
+std::string CatalogManager::GetOwnerName(page_owner_t owner) const {
+  if (owner == INVALID_PAGE_OWNER) {
+    return "other";
+  }
+  if (owner % 2 == 1) {
+    table_id_t table_id = (owner - 1) / 2;
+    auto table = tables_.find(table_id);
+    if (table == tables_.end()) {
+      return "table #" + std::to_string(table_id);
+    }
+    return "table " + table->second->GetTableName();
+  }
+  index_id_t index_id = (owner - 2) / 2;
+  auto index = indexes_.find(index_id);
+  if (index == indexes_.end()) {
+    return "index #" + std::to_string(index_id);
+  }
+  return "index " + index->second->GetIndexName() + " on " + index->second->GetTableInfo()->GetTableName();
+}
+
 dberr_t CatalogManager::FlushCatalogMetaPage() const {
-  // ASSERT(false, "Not Implemented yet");
-  return DB_FAILED;
+  Page *page = buffer_pool_manager_->FetchPage(CATALOG_META_PAGE_ID);
+  if (page == nullptr) return DB_FAILED;
+  memset(page->GetData(), 0, PAGE_SIZE);
+  catalog_meta_->SerializeTo(page->GetData());
+  buffer_pool_manager_->UnpinPage(CATALOG_META_PAGE_ID, true);
+  return DB_SUCCESS;
+}
+
+dberr_t CatalogManager::FlushTableMetaPage(const table_id_t table_id) {
+  page_id_t page_id = catalog_meta_->table_meta_pages_[table_id];
+  Page *page = buffer_pool_manager_->FetchPage(page_id);
+  if (page == nullptr) return DB_FAILED;
+  tables_[table_id]->GetTableMeta()->SerializeTo(page->GetData());
+  buffer_pool_manager_->UnpinPage(page_id, true);
+  return DB_SUCCESS;
 }
 
 dberr_t CatalogManager::LoadTable(const table_id_t table_id, const page_id_t page_id) {
-  // ASSERT(false, "Not Implemented yet");
-  return DB_FAILED;
+  Page *page = buffer_pool_manager_->FetchPage(page_id);
+  if (page == nullptr) return DB_FAILED;
+  TableMetadata *meta = nullptr;
+  TableMetadata::DeserializeFrom(page->GetData(), meta, heap_);
+  buffer_pool_manager_->UnpinPage(page_id, false);
+
+  // the heap is loaded from the first page recorded in the metadata
+  TableInfo *tableInfo = TableInfo::Create(heap_);
+  TableHeap *table_heap = TableHeap::Create(buffer_pool_manager_, meta->GetFirstPageId(), meta->GetSchema(),
+                                            log_manager_, lock_manager_, heap_);
+  tableInfo->Init(meta, table_heap);
+  table_heap->SetOwner(TableOwner(table_id));
+  if (meta->IsCached()) {
+    table_heap->SetCached(true);
+  }
+  table_names_[meta->GetTableName()] = table_id;
+  tables_[table_id] = tableInfo;
+  index_names_.insert({meta->GetTableName(), unordered_map<std::string, index_id_t>()});
+  return DB_SUCCESS;
 }
 
 dberr_t CatalogManager::LoadIndex(const index_id_t index_id, const page_id_t page_id) {
@@ -17,8 +17,9 @@ uint32_t IndexMetadata::SerializeTo(char *buf) const {
 
   uint32_t len = index_name_.size();
   memcpy(p, &len, sizeof(uint32_t));
+  p += sizeof(uint32_t);
   MACH_WRITE_STRING(p, index_name_);
-  p += (len + sizeof(uint32_t));
+  p += len;
 
   MACH_WRITE_TO(table_id_t, p, GetTableId());
   p += sizeof(uint32_t);
@@ -32,6 +33,9 @@ uint32_t IndexMetadata::SerializeTo(char *buf) const {
     p += sizeof(uint32_t);
   }
 
+  MACH_WRITE_UINT32(p, cached_ ? 1 : 0);
+  p += sizeof(uint32_t);
+
   return p - buf;
 }
 
@@ -39,7 +43,7 @@ uint32_t IndexMetadata::GetSerializedSize() const {
   uint32_t res = 0;
   uint32_t len = index_name_.size();
   uint32_t keymapSize = key_map_.size();
-  res = len + sizeof(uint32_t) * keymapSize + sizeof(uint32_t) * 5;
+  res = len + sizeof(uint32_t) * keymapSize + sizeof(uint32_t) * 6;
   return res;
 }
 
@@ -73,6 +77,10 @@ uint32_t IndexMetadata::DeserializeFrom(char *buf, IndexMetadata *&index_meta, M
     key_map.push_back(tmp);
   }
 
+  bool cached = MACH_READ_UINT32(p) != 0;
+  p += sizeof(uint32_t);
+
   index_meta = IndexMetadata::Create(index_id, index_name, table_id, key_map, heap);
+  index_meta->SetCached(cached);
   return p - buf;
 }
\ No newline at end of file
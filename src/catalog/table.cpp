@@ -13,8 +13,9 @@ uint32_t TableMetadata::SerializeTo(char *buf) const {
   // 写入表名
   uint32_t len = table_name_.size();
   memcpy(p, &len, sizeof(uint32_t));
+  p += sizeof(uint32_t);
   MACH_WRITE_STRING(p, table_name_);
-  p += (len + sizeof(uint32_t));
+  p += len;
 
   // 写入要存储的root page id
   MACH_WRITE_UINT32(p, root_page_id_);
@@ -23,13 +24,17 @@ uint32_t TableMetadata::SerializeTo(char *buf) const {
   // 写入整个表
   p += schema_->SerializeTo(p);
 
+  // 写入是否常驻缓冲池
+  MACH_WRITE_UINT32(p, cached_ ? 1 : 0);
+  p += sizeof(uint32_t);
+
   return p - buf;
 }
 
 uint32_t TableMetadata::GetSerializedSize() const {
   uint32_t res = 0;
   uint32_t len = table_name_.size();
-  res = 4 * sizeof(uint32_t) + len + schema_->GetSerializedSize();
+  res = 5 * sizeof(uint32_t) + len + schema_->GetSerializedSize();
   return res;
 }
 
@@ -63,9 +68,14 @@ uint32_t TableMetadata::DeserializeFrom(char *buf, TableMetadata *&table_meta, M
 
   p += schema->DeserializeFrom(p, schema, heap);
 
+  // 是否常驻缓冲池
+  bool cached = MACH_READ_UINT32(p) != 0;
+  p += sizeof(uint32_t);
+
   // 将我们创造出来的表放到heap中进行管理
   void *mem = heap->Allocate(sizeof(TableMetadata));
   table_meta = new (mem) TableMetadata(table_id, table_name, root_page_id, schema);
+  table_meta->SetCached(cached);
 
   return p - buf;
 }
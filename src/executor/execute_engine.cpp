@@ -1,6 +1,8 @@
 #include "executor/execute_engine.h"
 #include <time.h>
 #include <algorithm>
+#include <fstream>
+#include <iomanip>
 #include <vector>
 #include "glog/logging.h"
 #include "parser/minisql_lex.h"
@@ -51,6 +53,16 @@ dberr_t ExecuteEngine::Execute(pSyntaxNode ast, ExecuteContext *context) {
       return ExecuteExecfile(ast, context);
     case kNodeQuit:
       return ExecuteQuit(ast, context);
+    case kNodeShowBufferStatus:
+      return ExecuteShowBufferStatus(ast, context);
+    case kNodeSetVariable:
+      return ExecuteSetVariable(ast, context);
+    case kNodeAlterTableCache:
+      return ExecuteAlterTableCache(ast, context);
+    case kNodeShrinkDB:
+      return ExecuteShrinkDatabase(ast, context);
+    case kNodeShowIOStatus:
+      return ExecuteShowIOStatus(ast, context);
     default:
       break;
   }
@@ -61,7 +73,8 @@ dberr_t ExecuteEngine::ExecuteCreateDatabase(pSyntaxNode ast, ExecuteContext *co
 #ifdef ENABLE_EXECUTE_DEBUG
   LOG(INFO) << "ExecuteCreateDatabase" << std::endl;
 #endif
-  DBStorageEngine* db = new DBStorageEngine(ast->child_->val_);
+  DBStorageEngine* db = new DBStorageEngine(ast->child_->val_, true, DEFAULT_BUFFER_POOL_SIZE, ReplacerType::kLRU, 1,
+                                            &shared_pool_);
   //����mapӳ������
   dbs_[ast->child_->val_]=db;
   //cout<<"ExecuteCreateDatabase SUCCESS!"<<endl;
@@ -1220,4 +1233,247 @@ dberr_t ExecuteEngine::ExecuteQuit(pSyntaxNode ast, ExecuteContext *context) {
   ASSERT(ast->type_ == kNodeQuit, "Unexpected node type.");
   context->flag_quit_ = true;
   return DB_SUCCESS;
-}
\ No newline at end of file
+}
+
+dberr_t ExecuteEngine::ExecuteShowBufferStatus(pSyntaxNode ast, ExecuteContext *context) {
+#ifdef ENABLE_EXECUTE_DEBUG
+  LOG(INFO) << "ExecuteShowBufferStatus" << std::endl;
+#endif
+  auto it = dbs_.find(current_db_);
+  if (it == dbs_.end()) {
+    cout << "No Database Selected!" << endl;
+    return DB_FAILED;
+  }
+  BufferPoolStats stats = it->second->bpm_->GetStats();
+  auto row = [](const char *name, uint64_t value) { cout << left << setw(24) << name << value << endl; };
+  cout << "------Buffer Pool------" << endl;
+  row("pool size", stats.pool_size_);
+  row("frame quota", stats.frame_quota_);
+  row("resident pages", stats.resident_pages_);
+  row("  normal", stats.resident_pages_ - stats.cached_resident_pages_);
+  row("  cached", stats.cached_resident_pages_);
+  row("pinned frames", stats.pinned_frames_);
+  row("pinned high water", stats.pinned_high_water_);
+  row("fetches", stats.fetches_);
+  row("hits", stats.hits_);
+  row("misses", stats.misses_);
+  row("failed fetches", stats.failed_fetches_);
+  row("evictions", stats.evictions_);
+  row("cached evictions", stats.cached_evictions_);
+  row("foreground writebacks", stats.foreground_writebacks_);
+  row("background writebacks", stats.background_writebacks_);
+  row("new pages", stats.new_pages_);
+  row("deleted pages", stats.deleted_pages_);
+  double hit_ratio = stats.fetches_ == 0 ? 0 : 100.0 * stats.hits_ / stats.fetches_;
+  cout << left << setw(24) << "hit ratio" << fixed << setprecision(2) << hit_ratio << "%" << defaultfloat << endl;
+  if (stats.compressed_capacity_ == 0) {
+    return DB_SUCCESS;
+  }
+  cout << "---Compressed Cache---" << endl;
+  row("capacity", stats.compressed_capacity_);
+  row("pages", stats.compressed_pages_);
+  row("bytes", stats.compressed_bytes_);
+  row("lookups", stats.compressed_lookups_);
+  row("hits", stats.compressed_hits_);
+  row("rejects", stats.compressed_rejects_);
+  row("evictions", stats.compressed_evictions_);
+  double compressed_hit_ratio =
+      stats.compressed_lookups_ == 0 ? 0 : 100.0 * stats.compressed_hits_ / stats.compressed_lookups_;
+  double compression_ratio = stats.compressed_bytes_ == 0
+                                 ? 0
+                                 : static_cast<double>(stats.compressed_pages_) * PAGE_SIZE / stats.compressed_bytes_;
+  cout << left << setw(24) << "hit ratio" << fixed << setprecision(2) << compressed_hit_ratio << "%" << endl;
+  cout << left << setw(24) << "compression ratio" << compression_ratio << defaultfloat << endl;
+  return DB_SUCCESS;
+}
+
+dberr_t ExecuteEngine::ExecuteSetVariable(pSyntaxNode ast, ExecuteContext *context) {
+#ifdef ENABLE_EXECUTE_DEBUG
+  LOG(INFO) << "ExecuteSetVariable" << std::endl;
+#endif
+  string name = ast->child_->val_;
+  string value = ast->child_->next_->val_;
+  if (name != "buffer_pool_size" && name != "compressed_cache_size" && name != "buffer_pool_min" &&
+      name != "buffer_pool_max") {
+    cout << "Unknown Variable " << name << "!" << endl;
+    return DB_FAILED;
+  }
+  auto it = dbs_.find(current_db_);
+  if (it == dbs_.end()) {
+    cout << "No Database Selected!" << endl;
+    return DB_FAILED;
+  }
+  char *end = nullptr;
+  if (name == "compressed_cache_size") {
+    long long capacity = strtoll(value.c_str(), &end, 10);
+    if (*end != '\0' || capacity < 0) {
+      cout << "Invalid Compressed Cache Size " << value << "!" << endl;
+      return DB_FAILED;
+    }
+    it->second->bpm_->SetCompressedCacheSize(static_cast<size_t>(capacity));
+    cout << "Compressed cache resized to " << capacity << " bytes." << endl;
+    return DB_SUCCESS;
+  }
+  if (name == "buffer_pool_min" || name == "buffer_pool_max") {
+    long long frames = strtoll(value.c_str(), &end, 10);
+    SharedBufferPoolQuota quota = shared_pool_.GetQuota(it->second->bpm_);
+    size_t min_frames = name == "buffer_pool_min" ? static_cast<size_t>(frames) : quota.min_frames_;
+    size_t max_frames = name == "buffer_pool_max" ? static_cast<size_t>(frames) : quota.max_frames_;
+    if (*end != '\0' || frames < 0 || !shared_pool_.SetLimits(it->second->bpm_, min_frames, max_frames)) {
+      cout << "Invalid Frame Limit " << value << "!" << endl;
+      return DB_FAILED;
+    }
+    cout << "Buffer pool limited to " << min_frames << ".." << max_frames << " frames, quota now "
+         << shared_pool_.GetQuota(it->second->bpm_).frames_ << " frames." << endl;
+    return DB_SUCCESS;
+  }
+  // a shared pool is sized to the whole budget and filled up to its quota, resizing it would break the budget
+  if (it->second->shared_pool_ != nullptr) {
+    cout << "Buffer Pool Shares The Frame Budget, Set buffer_pool_min Or buffer_pool_max Instead!" << endl;
+    return DB_FAILED;
+  }
+  long long pool_size = strtoll(value.c_str(), &end, 10);
+  if (*end != '\0' || pool_size <= 0) {
+    cout << "Invalid Buffer Pool Size " << value << "!" << endl;
+    return DB_FAILED;
+  }
+  // a shrink gives up on pages that stay pinned, the pool may then have been resized in part
+  if (!it->second->bpm_->ResizePool(static_cast<size_t>(pool_size))) {
+    cout << "Buffer Pool Not Resized To " << value << ", Now " << it->second->bpm_->GetPoolSize() << " Frames!" << endl;
+    return DB_FAILED;
+  }
+  cout << "Buffer pool resized to " << it->second->bpm_->GetPoolSize() << " frames." << endl;
+  return DB_SUCCESS;
+}
+
+dberr_t ExecuteEngine::ExecuteAlterTableCache(pSyntaxNode ast, ExecuteContext *context) {
+#ifdef ENABLE_EXECUTE_DEBUG
+  LOG(INFO) << "ExecuteAlterTableCache" << std::endl;
+#endif
+  auto it = dbs_.find(current_db_);
+  if (it == dbs_.end()) {
+    cout << "No Database Selected!" << endl;
+    return DB_FAILED;
+  }
+  string table_name = ast->child_->val_;
+  bool indexes = ast->child_->next_ != nullptr;
+  bool cached = string(ast->val_) == "cache";
+  dberr_t err = it->second->catalog_mgr_->SetTableCached(table_name, indexes, cached);
+  if (err == DB_TABLE_NOT_EXIST) {
+    cout << "Table " << table_name << " Not Exist!" << endl;
+    return err;
+  }
+  if (err != DB_SUCCESS) {
+    return err;
+  }
+  cout << (indexes ? "Indexes of table " : "Table ") << table_name << (cached ? " cached." : " no longer cached.")
+       << endl;
+  return DB_SUCCESS;
+}
+
+dberr_t ExecuteEngine::ExecuteShrinkDatabase(pSyntaxNode ast, ExecuteContext *context) {
+#ifdef ENABLE_EXECUTE_DEBUG
+  LOG(INFO) << "ExecuteShrinkDatabase" << std::endl;
+#endif
+  auto it = dbs_.find(current_db_);
+  if (it == dbs_.end()) {
+    cout << "No Database Selected!" << endl;
+    return DB_FAILED;
+  }
+  int64_t released = it->second->Shrink();
+  cout << "Database " << current_db_ << " shrunk by " << released / PAGE_SIZE << " pages, now "
+       << it->second->disk_mgr_->GetFileSize() / PAGE_SIZE << " pages." << endl;
+  return DB_SUCCESS;
+}
+
+namespace {
+
+/** Write a latency histogram as a JSON object, in nanoseconds. */
+void WriteLatencyJson(ostream &out, const LatencyHistogram &latency) {
+  out << "{\"p50\": " << latency.Percentile(0.5) << ", \"p99\": " << latency.Percentile(0.99)
+      << ", \"p999\": " << latency.Percentile(0.999) << ", \"buckets\": [";
+  for (size_t bucket = 0; bucket < LatencyHistogram::BUCKETS; bucket++) {
+    out << (bucket == 0 ? "" : ", ") << latency.buckets_[bucket];
+  }
+  out << "]}";
+}
+
+/** @return a string as a JSON string literal */
+string JsonString(const string &value) {
+  string result = "\"";
+  for (char c : value) {
+    if (c == '"' || c == '\\') {
+      result += '\\';
+    }
+    result += c;
+  }
+  return result + "\"";
+}
+
+}  // namespace
+
+// 1.   Print the physical I/O of the database file, with the percentiles of the read and write latencies.
+// 2.   Print the pages every table and index read and wrote through the buffer pool, the busiest reader first.
+// 3.   With a file name, also write both to the file as JSON.
+dberr_t ExecuteEngine::ExecuteShowIOStatus(pSyntaxNode ast, ExecuteContext *context) {
+#ifdef ENABLE_EXECUTE_DEBUG
+  LOG(INFO) << "ExecuteShowIOStatus" << std::endl;
+#endif
+  auto it = dbs_.find(current_db_);
+  if (it == dbs_.end()) {
+    cout << "No Database Selected!" << endl;
+    return DB_FAILED;
+  }
+  DiskIOStats stats = it->second->disk_mgr_->GetIOStats();
+  std::vector<std::pair<page_owner_t, PageOwnerStats>> owners;
+  for (auto &owner : it->second->bpm_->GetOwnerStats()) {
+    owners.emplace_back(owner);
+  }
+  std::stable_sort(owners.begin(), owners.end(),
+                   [](const auto &a, const auto &b) { return a.second.reads_ > b.second.reads_; });
+
+  auto row = [](const char *name, uint64_t value) { cout << left << setw(24) << name << value << endl; };
+  auto latency_row = [](const char *name, const LatencyHistogram &latency) {
+    cout << left << setw(24) << name << fixed << setprecision(1) << latency.Percentile(0.5) / 1000.0 << " / "
+         << latency.Percentile(0.99) / 1000.0 << " / " << latency.Percentile(0.999) / 1000.0 << defaultfloat << endl;
+  };
+  cout << "-------Disk I/O-------" << endl;
+  row("reads", stats.reads_);
+  row("read bytes", stats.read_bytes_);
+  latency_row("read p50/p99/p999 us", stats.read_latency_);
+  row("writes", stats.writes_);
+  row("written bytes", stats.written_bytes_);
+  latency_row("write p50/p99/p999 us", stats.write_latency_);
+  cout << "---Page I/O by Object---" << endl;
+  cout << left << setw(40) << "object" << setw(12) << "reads" << "writes" << endl;
+  for (auto &[owner, owner_stats] : owners) {
+    cout << left << setw(40) << it->second->catalog_mgr_->GetOwnerName(owner) << setw(12) << owner_stats.reads_
+         << owner_stats.writes_ << endl;
+  }
+
+  if (ast->child_ == nullptr) {
+    return DB_SUCCESS;
+  }
+  string file_name = ast->child_->val_;
+  ofstream out(file_name);
+  out << "{\"database\": " << JsonString(current_db_) << ", \"page_size\": " << PAGE_SIZE << ",\n";
+  out << " \"disk\": {\"reads\": " << stats.reads_ << ", \"read_bytes\": " << stats.read_bytes_
+      << ", \"writes\": " << stats.writes_ << ", \"written_bytes\": " << stats.written_bytes_ << ",\n";
+  out << "  \"read_latency_ns\": ";
+  WriteLatencyJson(out, stats.read_latency_);
+  out << ",\n  \"write_latency_ns\": ";
+  WriteLatencyJson(out, stats.write_latency_);
+  out << "},\n \"objects\": [";
+  for (size_t i = 0; i < owners.size(); i++) {
+    string name = it->second->catalog_mgr_->GetOwnerName(owners[i].first);
+    out << (i == 0 ? "\n" : ",\n") << "  {\"name\": " << JsonString(name) << ", \"reads\": " << owners[i].second.reads_
+        << ", \"writes\": " << owners[i].second.writes_ << "}";
+  }
+  out << "]}" << endl;
+  if (!out) {
+    cout << "Failed To Write " << file_name << "!" << endl;
+    return DB_FAILED;
+  }
+  cout << "I/O status written to " << file_name << "." << endl;
+  return DB_SUCCESS;
+}
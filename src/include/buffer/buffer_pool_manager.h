@@ -1,57 +1,326 @@
 #ifndef MINISQL_BUFFER_POOL_MANAGER_H
 #define MINISQL_BUFFER_POOL_MANAGER_H
 
-#include <list>
-#include <mutex>
-#include <unordered_map>
+#include <atomic>
+#include <map>
+#include <string>
+#include <vector>
 
-#include "buffer/lru_replacer.h"
+#include "buffer/replacer.h"
 #include "page/page.h"
-#include "page/disk_file_meta_page.h"
 #include "storage/disk_manager.h"
 
 using namespace std;
 
+/**
+ * Snapshot of the counters of a buffer pool, see BufferPoolManager::GetStats. The counters are cumulative since the
+ * pool was created.
+ */
+struct BufferPoolStats {
+  size_t pool_size_{0};                // number of frames
+  size_t frame_quota_{0};              // frames the pool may fill, see SetFrameQuota
+  size_t resident_pages_{0};           // frames holding a page
+  size_t cached_resident_pages_{0};    // frames holding a page with a residency hint, see SetResidencyHint
+  size_t pinned_frames_{0};            // frames pinned right now
+  size_t pinned_high_water_{0};        // most frames pinned at the same time
+  uint64_t fetches_{0};                // FetchPage calls
+  uint64_t hits_{0};                   // fetches of a resident page
+  uint64_t misses_{0};                 // fetches of a page that was not resident
+  uint64_t failed_fetches_{0};         // FetchPage and NewPage calls that failed because every frame was pinned
+  uint64_t evictions_{0};              // pages evicted to make room for another one
+  uint64_t cached_evictions_{0};       // evicted pages that had a residency hint
+  uint64_t foreground_writebacks_{0};  // dirty victims written back on the FetchPage/NewPage path
+  uint64_t background_writebacks_{0};  // dirty pages written back by the page cleaner
+  uint64_t new_pages_{0};              // successful NewPage calls
+  uint64_t deleted_pages_{0};          // successful DeletePage calls
+  size_t compressed_capacity_{0};      // bytes the compressed page cache may take, 0 if it is disabled
+  size_t compressed_pages_{0};         // pages held by the compressed page cache
+  size_t compressed_bytes_{0};         // bytes those pages take compressed
+  uint64_t compressed_lookups_{0};     // misses that looked in the compressed page cache
+  uint64_t compressed_hits_{0};        // misses served from the compressed page cache instead of the disk
+  uint64_t compressed_rejects_{0};     // evicted pages that did not compress well enough to be cached
+  uint64_t compressed_evictions_{0};   // compressed pages dropped to make room for newer ones
+
+  /** Add the counters of another pool, used to sum up the shards of a parallel pool. */
+  BufferPoolStats &operator+=(const BufferPoolStats &other) {
+    pool_size_ += other.pool_size_;
+    frame_quota_ += other.frame_quota_;
+    resident_pages_ += other.resident_pages_;
+    cached_resident_pages_ += other.cached_resident_pages_;
+    pinned_frames_ += other.pinned_frames_;
+    pinned_high_water_ += other.pinned_high_water_;
+    fetches_ += other.fetches_;
+    hits_ += other.hits_;
+    misses_ += other.misses_;
+    failed_fetches_ += other.failed_fetches_;
+    evictions_ += other.evictions_;
+    cached_evictions_ += other.cached_evictions_;
+    foreground_writebacks_ += other.foreground_writebacks_;
+    background_writebacks_ += other.background_writebacks_;
+    new_pages_ += other.new_pages_;
+    deleted_pages_ += other.deleted_pages_;
+    compressed_capacity_ += other.compressed_capacity_;
+    compressed_pages_ += other.compressed_pages_;
+    compressed_bytes_ += other.compressed_bytes_;
+    compressed_lookups_ += other.compressed_lookups_;
+    compressed_hits_ += other.compressed_hits_;
+    compressed_rejects_ += other.compressed_rejects_;
+    compressed_evictions_ += other.compressed_evictions_;
+    return *this;
+  }
+};
+
+/**
+ * Page I/O of one table or index, see BufferPoolManager::GetOwnerStats. Pages read from disk on a miss or by
+ * read-ahead count as reads, compressed page cache hits do not. Pages written back count as writes when the pool
+ * writes them or hands them to the page cleaner.
+ */
+struct PageOwnerStats {
+  uint64_t reads_{0};   // pages read from disk
+  uint64_t writes_{0};  // pages written to disk
+
+  PageOwnerStats &operator+=(const PageOwnerStats &other) {
+    reads_ += other.reads_;
+    writes_ += other.writes_;
+    return *this;
+  }
+};
+
+/**
+ * Tags the pages the current thread fetches or creates with the table or index it works on, for as long as the scope
+ * lives. The buffer pool keeps the tag of every resident page and charges its disk reads and writes to that owner,
+ * including writes that happen later on behalf of another thread. A fetch outside of any scope keeps the tag the
+ * page already has. Scopes nest, the innermost one wins.
+ */
+class PageOwnerScope {
+public:
+  explicit PageOwnerScope(page_owner_t owner) : previous_(current_) { current_ = owner; }
+
+  ~PageOwnerScope() { current_ = previous_; }
+
+  PageOwnerScope(const PageOwnerScope &) = delete;
+  PageOwnerScope &operator=(const PageOwnerScope &) = delete;
+
+  /** @return the owner of the innermost scope of the calling thread, INVALID_PAGE_OWNER outside of any */
+  static page_owner_t Current() { return current_; }
+
+private:
+  page_owner_t previous_;
+  inline static thread_local page_owner_t current_{INVALID_PAGE_OWNER};
+};
+
+/**
+ * Reads the id of the page that follows a page in its chain, such as the next page of a table heap or the next leaf
+ * of a B+ tree, out of the page data. Used by BufferPoolManager::PrefetchChain.
+ */
+using NextPageIdReader = page_id_t (*)(const char *data);
+
+/**
+ * BufferPoolManager is the interface shared by the buffer pool implementations. Storage components such as
+ * TableHeap, BPlusTree and CatalogManager only use this interface, so that they work with a single instance as
+ * well as with a sharded pool.
+ */
 class BufferPoolManager {
 public:
-  explicit BufferPoolManager(size_t pool_size, DiskManager *disk_manager);
+  BufferPoolManager() = default;
 
-  ~BufferPoolManager();
+  virtual ~BufferPoolManager() = default;
+
+  /**
+   * Fetch the requested page from the buffer pool.
+   * @param page_id id of page to be fetched
+   * @return the requested page, or nullptr if every frame is pinned
+   */
+  virtual Page *FetchPage(page_id_t page_id) = 0;
+
+  /**
+   * Fetch a batch of pages, each one as FetchPage does, but read all the misses from disk with one submission
+   * instead of one blocking read after the other. Meant for batched index lookups.
+   * @param page_ids ids of the pages, may repeat
+   * @return the pinned pages in the order of page_ids, nullptr for a page that found no free frame
+   */
+  virtual std::vector<Page *> FetchPages(const std::vector<page_id_t> &page_ids) = 0;
 
-  Page *FetchPage(page_id_t page_id);
+  /**
+   * Unpin the target page from the buffer pool.
+   * @param page_id id of page to be unpinned
+   * @param is_dirty true if the page should be marked as dirty, false otherwise
+   * @return false if the page pin count is <= 0 before this call, true otherwise
+   */
+  virtual bool UnpinPage(page_id_t page_id, bool is_dirty) = 0;
 
-  bool UnpinPage(page_id_t page_id, bool is_dirty);
+  /**
+   * Flush the target page to disk.
+   * @param page_id id of page to be flushed, cannot be INVALID_PAGE_ID
+   * @return false if the page could not be found in the page table, true otherwise
+   */
+  virtual bool FlushPage(page_id_t page_id) = 0;
 
-  bool FlushPage(page_id_t page_id);
+  /**
+   * Write every dirty page to disk and mark it clean, together with the page cleaner copies that are not on disk
+   * yet. The writes are sorted and coalesced, and the batch ends with a single fsync, so everything written before
+   * the call returns is durable. Used at shutdown and for checkpoints.
+   */
+  virtual void FlushAllPages() = 0;
 
-  Page *NewPage(page_id_t &page_id);
+  /**
+   * Create a new page in the buffer pool.
+   * @param[out] page_id id of created page
+   * @return nullptr if no new pages could be created, otherwise pointer to new page
+   */
+  virtual Page *NewPage(page_id_t &page_id) = 0;
 
-  bool DeletePage(page_id_t page_id);
+  /**
+   * Create a new page close to the other pages of its table or index, see DiskManager::AllocatePageNear.
+   * @param[out] page_id id of created page
+   * @param near_page_id the last page created for the same object, INVALID_PAGE_ID for the first page of an object
+   * @return nullptr if no new pages could be created, otherwise pointer to new page
+   */
+  virtual Page *NewPageNear(page_id_t &page_id, page_id_t near_page_id) = 0;
 
-  bool IsPageFree(page_id_t page_id);
+  /**
+   * Delete a page from the buffer pool and deallocate it on disk.
+   * @param page_id id of page to be deleted
+   * @return false if the page exists but could not be deleted, true if the page didn't exist or deletion succeeded
+   */
+  virtual bool DeletePage(page_id_t page_id) = 0;
 
-  bool CheckAllUnpinned();
+  /**
+   * @return true if the page is not allocated on disk
+   */
+  virtual bool IsPageFree(page_id_t page_id) = 0;
 
-private:
   /**
-   * Allocate new page (operations like create index/table) For now just keep an increasing counter
+   * Only used for debug
+   * @return true if no page in the pool is pinned
    */
-  page_id_t AllocatePage();
+  virtual bool CheckAllUnpinned() = 0;
+
+  /** @return the total number of frames in the buffer pool */
+  virtual size_t GetPoolSize() = 0;
 
   /**
-   * Deallocate page (operations like drop index/table) Need bitmap in header page for tracking pages
+   * Grow or shrink the buffer pool while it is in use. Growing adds empty frames to the free list. Shrinking writes
+   * back and evicts the unpinned pages held by the frames that go away and waits up to RESIZE_PIN_TIMEOUT_MS until
+   * the pinned ones are unpinned, keeping its size if they are not.
+   * @param pool_size the new total number of frames
+   * @return false if the size is 0 or larger than the pool can grow to, or if pages stayed pinned, see GetPoolSize
    */
-  void DeallocatePage(page_id_t page_id);
+  virtual bool ResizePool(size_t pool_size) = 0;
 
+  /**
+   * Limit the number of frames the pool fills without changing its size. A pool at its quota replaces one of its own
+   * pages on a miss instead of taking a free frame, a pool above it evicts unpinned pages until it fits. Pinned
+   * pages stay, the next call evicts them once they are unpinned. Used by SharedBufferPool to move memory between
+   * the databases that share it.
+   * @param frames the number of frames the pool may fill, at least 1
+   */
+  virtual void SetFrameQuota(size_t frames) = 0;
 
-private:
-  size_t pool_size_;                                        // number of pages in buffer pool
-  Page *pages_;                                             // array of pages
-  DiskManager *disk_manager_;                               // pointer to the disk manager.
-  std::unordered_map<page_id_t, frame_id_t> page_table_;    // to keep track of pages
-  Replacer *replacer_;                                      // to find an unpinned page for replacement
-  std::list<frame_id_t> free_list_;                         // to find a free page for replacement
-  recursive_mutex latch_;                                   // to protect shared data structure
+  /**
+   * Give pages a residency hint, used for the pages of tables and indexes marked CACHE. Resident pages with the hint
+   * are protected from eviction and only evicted when no other page can be, or when they take more than
+   * CACHED_PAGES_MAX_FRACTION of the pool. The hint is kept for pages that are not resident and applies once they
+   * are read in, it is dropped when the page is deleted.
+   * @param page_ids ids of the pages
+   * @param cached true to give the pages the hint, false to take it away
+   */
+  virtual void SetResidencyHint(const std::vector<page_id_t> &page_ids, bool cached) = 0;
+
+  /**
+   * Size the compressed page cache, the second tier that keeps clean evicted pages compressed in memory and serves
+   * misses on them without a disk read. Shrinking drops the oldest compressed pages.
+   * @param capacity bytes the compressed pages may take, 0 to disable the cache
+   */
+  virtual void SetCompressedCacheSize(size_t capacity) = 0;
+
+  /**
+   * Start the background page cleaner, which writes dirty unpinned pages ahead of eviction so that FetchPage and
+   * NewPage rarely have to write a victim back themselves.
+   * @param clean_fraction fraction of the evictable frames the cleaner tries to keep clean
+   */
+  virtual void StartPageCleaner(double clean_fraction = PAGE_CLEANER_CLEAN_FRACTION) = 0;
+
+  /** Stop the background page cleaner and wait for its pending writes. */
+  virtual void StopPageCleaner() = 0;
+
+  /** @return number of dirty victims written back on the FetchPage/NewPage path */
+  virtual uint64_t GetForegroundWritebacks() = 0;
+
+  /** @return number of dirty pages written back by the page cleaner */
+  virtual uint64_t GetBackgroundWritebacks() = 0;
+
+  /**
+   * The counters are kept with relaxed atomics and may be read while the pool is in use, so the snapshot is not
+   * necessarily consistent across counters.
+   * @return the counters of the buffer pool
+   */
+  virtual BufferPoolStats GetStats() = 0;
+
+  /**
+   * @return the pages read and written so far per owner tag, see PageOwnerScope. I/O of untagged pages, such as the
+   * catalog pages, is counted under INVALID_PAGE_OWNER.
+   */
+  virtual std::map<page_owner_t, PageOwnerStats> GetOwnerStats() = 0;
+
+  /**
+   * Asynchronously read pages into unpinned frames ahead of a scan. Pages that are already resident or queued are
+   * skipped. A FetchPage of a queued page reads it itself, a FetchPage of a page that is being read waits for that
+   * read instead of issuing a second one.
+   * @param page_ids ids of the pages the caller expects to fetch soon
+   */
+  virtual void PrefetchPages(const std::vector<page_id_t> &page_ids) = 0;
+
+  /**
+   * Asynchronously read the pages of a page chain ahead of a scan. The pool reads page_id, takes the id of the next
+   * page from its data and goes on from there until count pages have been visited, the chain ends or it leads to a
+   * free page. Pages of the chain that are already resident are not read again, but the chain is followed through
+   * them.
+   * @param page_id first page of the chain to read
+   * @param count number of pages to visit at most
+   * @param next_page_id reads the id of the next page out of the data of a page
+   */
+  virtual void PrefetchChain(page_id_t page_id, size_t count, NextPageIdReader next_page_id) = 0;
+
+  /**
+   * @return the ids of the resident pages, the page the pool would evict last first: the pinned pages, then the
+   * evictable ones in replacer priority order
+   */
+  virtual std::vector<page_id_t> GetResidentPages() = 0;
+
+  /** @return true if the pages of the pool cannot be written, see MappedBufferPoolManager */
+  virtual bool IsReadOnly() = 0;
+
+  /**
+   * Check a write to the database of the pool before it touches a page, writing into a page of a read-only pool
+   * faults. TableHeap, BPlusTree and CatalogManager check their writes with it.
+   * @param operation what is written, for the log
+   * @return true if the pool is read-only and the write is rejected
+   */
+  bool RejectWrite(const char *operation);
+
+  /**
+   * Save the resident page set to a sidecar file, so that the next start can warm the pool up with it.
+   * @param file_name the sidecar file, overwritten
+   * @return false if the file could not be written
+   */
+  bool SaveResidentPages(const std::string &file_name);
+
+  /**
+   * Read back a resident page set saved by SaveResidentPages.
+   * @param file_name the sidecar file
+   * @return the page ids, the hottest page first, empty if the file does not exist or is damaged
+   */
+  static std::vector<page_id_t> LoadResidentPages(const std::string &file_name);
+
+  /** @return number of pages scans read ahead of themselves, 0 if read-ahead is disabled */
+  size_t GetReadAheadWindow() const { return read_ahead_window_.load(std::memory_order_relaxed); }
+
+  /** Set the number of pages scans read ahead of themselves, 0 to disable read-ahead. */
+  void SetReadAheadWindow(size_t window) { read_ahead_window_.store(window, std::memory_order_relaxed); }
+
+protected:
+  std::atomic<size_t> read_ahead_window_{READ_AHEAD_WINDOW};  // see ReadAhead
 };
 
 #endif  // MINISQL_BUFFER_POOL_MANAGER_H
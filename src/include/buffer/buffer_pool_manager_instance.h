@@ -0,0 +1,341 @@
+#ifndef MINISQL_BUFFER_POOL_MANAGER_INSTANCE_H
+#define MINISQL_BUFFER_POOL_MANAGER_INSTANCE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "buffer/buffer_pool_manager.h"
+#include "buffer/clock_replacer.h"
+#include "buffer/compressed_page_cache.h"
+#include "buffer/frame_arena.h"
+#include "buffer/lru_k_replacer.h"
+#include "buffer/lru_replacer.h"
+#include "buffer/priority_replacer.h"
+#include "page/page.h"
+#include "page/disk_file_meta_page.h"
+#include "storage/disk_manager.h"
+
+using namespace std;
+
+/**
+ * Pages collected for one FlushAllPages batch, see BufferPoolManagerInstance::CollectFlushBatch.
+ */
+struct FlushBatch {
+  std::vector<std::pair<page_id_t, const char *>> pages_;  // pages to write, pointing into frames or copies_
+  std::vector<std::unique_ptr<char[]>> copies_;            // page cleaner copies taken over by the batch
+  std::vector<std::unique_lock<std::mutex>> latches_;      // held until the batch has been written
+};
+
+/**
+ * A page queued for the prefetch thread, see BufferPoolManagerInstance::PrefetchPages and PrefetchChain.
+ */
+struct PrefetchRequest {
+  page_id_t page_id_;               // page to read
+  page_owner_t owner_;              // owner tag of the thread that asked for it
+  size_t chain_left_;               // pages of the chain still to visit after this one, 0 for a single page
+  NextPageIdReader next_page_id_;   // reads the next page of the chain, nullptr for a single page
+};
+
+/**
+ * BufferPoolManagerInstance is a single buffer pool with its own frames, page table, replacer and free list.
+ * Every public operation takes the instance latch, so an instance may be shared between threads. The frames live in
+ * a FrameArena, the book-keeping information of a frame is accessed through the arena by frame id.
+ *
+ * The optional page cleaner thread copies dirty unpinned pages under the latch, marks them clean and writes the
+ * copies afterwards in page id order and in batches without holding the latch. Until a copy is on disk it stays in
+ * pending_writebacks_, and any operation that would race with it (reading the page back, writing a newer version,
+ * deleting it) first settles it through SettleWriteback.
+ *
+ * Read-ahead requests are served by a prefetch thread, started on the first PrefetchPages or PrefetchChain call. It
+ * reads the queued pages in batches with one DiskManager::ReadPages call, without holding the latch, and installs
+ * them unpinned, unless a page was fetched, created or deleted in the meantime. A chain is read together with the
+ * pages that follow its page on disk as far as it runs through them. Where it leaves the batch, the next page is
+ * queued through chain_pool_, which is the parallel pool for a shard, since the next page may belong to another
+ * shard. A page that was free when it was queued can be allocated later and already have a stale frame, which NewPage
+ * drops.
+ *
+ * Every frame carries the owner tag of its page, see PageOwnerScope. The tag is set when the page is read in or
+ * created and updated by every fetch inside a scope, and the disk reads and writes of the page are charged to it.
+ *
+ * The replacer keeps two classes of frames, see PriorityReplacer. A frame is put into the protected class whenever
+ * it is bound to a page in cached_pages_, the pages with a residency hint.
+ *
+ * Clean pages that leave the frames, evicted victims as well as the pages of retired frames, go to the optional
+ * compressed page cache. A miss, including a read-ahead, takes the page from there before it reads the disk, and a
+ * page id that is deleted or reallocated is dropped from it.
+ *
+ * The frame quota caps the frames in use below the pool size, so that databases sharing a SharedBufferPool can be
+ * given more or less memory without resizing. Frames given up to meet a smaller quota go back to the free list and
+ * their memory back to the operating system.
+ *
+ * ResizePool keeps frame ids stable: the arena reserves room for BUFFER_POOL_MAX_SIZE frames, growing appends
+ * frames and shrinking retires the frames at the end. While a shrink waits for pinned pages, retiring_from_ keeps
+ * the frames past the new size out of the free list and the replacer. A shrink that is still waiting after
+ * RESIZE_PIN_TIMEOUT_MS gives up, logs the pinned pages and hands the retired frames back, see CancelShrink.
+ */
+class BufferPoolManagerInstance : public BufferPoolManager {
+public:
+  /**
+   * Create a stand-alone buffer pool.
+   * @param pool_size the number of frames in the pool
+   * @param disk_manager the disk manager
+   * @param replacer_type the replacement policy
+   */
+  explicit BufferPoolManagerInstance(size_t pool_size, DiskManager *disk_manager,
+                                     ReplacerType replacer_type = ReplacerType::kLRU);
+
+  /**
+   * Create one shard of a parallel buffer pool. The shard only holds pages with page_id % num_instances ==
+   * instance_index.
+   * @param pool_size the number of frames in this shard
+   * @param num_instances the number of shards in the parallel buffer pool
+   * @param instance_index the index of this shard
+   * @param disk_manager the disk manager
+   * @param replacer_type the replacement policy
+   */
+  BufferPoolManagerInstance(size_t pool_size, uint32_t num_instances, uint32_t instance_index,
+                            DiskManager *disk_manager, ReplacerType replacer_type = ReplacerType::kLRU);
+
+  ~BufferPoolManagerInstance() override;
+
+  Page *FetchPage(page_id_t page_id) override;
+
+  std::vector<Page *> FetchPages(const std::vector<page_id_t> &page_ids) override;
+
+  bool UnpinPage(page_id_t page_id, bool is_dirty) override;
+
+  bool FlushPage(page_id_t page_id) override;
+
+  void FlushAllPages() override;
+
+  Page *NewPage(page_id_t &page_id) override;
+
+  Page *NewPageNear(page_id_t &page_id, page_id_t near_page_id) override;
+
+  bool DeletePage(page_id_t page_id) override;
+
+  bool IsPageFree(page_id_t page_id) override;
+
+  bool CheckAllUnpinned() override;
+
+  size_t GetPoolSize() override;
+
+  bool ResizePool(size_t pool_size) override;
+
+  void SetFrameQuota(size_t frames) override;
+
+  void SetResidencyHint(const std::vector<page_id_t> &page_ids, bool cached) override;
+
+  void SetCompressedCacheSize(size_t capacity) override;
+
+  void StartPageCleaner(double clean_fraction = PAGE_CLEANER_CLEAN_FRACTION) override;
+
+  void StopPageCleaner() override;
+
+  uint64_t GetForegroundWritebacks() override { return foreground_writebacks_.load(std::memory_order_relaxed); }
+
+  uint64_t GetBackgroundWritebacks() override { return background_writebacks_.load(std::memory_order_relaxed); }
+
+  BufferPoolStats GetStats() override;
+
+  std::map<page_owner_t, PageOwnerStats> GetOwnerStats() override;
+
+  void PrefetchPages(const std::vector<page_id_t> &page_ids) override;
+
+  void PrefetchChain(page_id_t page_id, size_t count, NextPageIdReader next_page_id) override;
+
+  std::vector<page_id_t> GetResidentPages() override;
+
+  bool IsReadOnly() override { return false; }
+
+  /**
+   * Bring a page that has just been allocated on disk into the pool, zeroed and pinned, without reading it.
+   * Used by ParallelBufferPoolManager, which allocates page ids itself and routes them to their shard.
+   * @param page_id id of the allocated page, must belong to this instance
+   * @return nullptr if every frame is pinned
+   */
+  Page *InstallNewPage(page_id_t page_id);
+
+  /**
+   * Add the dirty pages of this instance and the page cleaner copies that are not on disk yet to a flush batch, and
+   * mark the pages clean. Used by FlushAllPages, and by ParallelBufferPoolManager to flush all shards as one batch.
+   * The batch keeps the latch and the writeback latch of the instance, so that neither the frames nor the cleaner
+   * copies change, and no page in the batch is read back from disk, until the batch has been written and destroyed.
+   * @param[out] batch the batch to add the pages to
+   */
+  void CollectFlushBatch(FlushBatch *batch);
+
+  /**
+   * Set the pool that queues the next page of a chain on behalf of the prefetch thread. ParallelBufferPoolManager
+   * sets itself for its shards before any read-ahead starts.
+   */
+  void SetChainPool(BufferPoolManager *chain_pool) { chain_pool_ = chain_pool; }
+
+  /**
+   * Stop the prefetch thread for good, dropping the queued pages. Later read-ahead requests are ignored. Called by
+   * the destructor, and by ParallelBufferPoolManager for all shards before it deletes any, because the prefetch
+   * thread of a shard may queue pages of a chain on other shards.
+   */
+  void StopPrefetcher();
+
+private:
+  /**
+   * Allocate new page (operations like create index/table) For now just keep an increasing counter
+   */
+  page_id_t AllocatePage();
+
+  /**
+   * Deallocate page (operations like drop index/table) Need bitmap in header page for tracking pages
+   */
+  void DeallocatePage(page_id_t page_id);
+
+  /**
+   * The part of FetchPage that runs before the disk read: pin the page if it is resident, otherwise bind it to a
+   * frame and take it from the compressed page cache if it is there. Must be called with the latch held.
+   * @param page_id id of the page
+   * @param lock the held latch, released while waiting for a prefetch of the page
+   * @param[out] read set to true if the caller still has to read the page into the returned frame
+   * @return the pinned page, nullptr if every frame is pinned
+   */
+  Page *PinPage(page_id_t page_id, std::unique_lock<std::mutex> *lock, bool *read);
+
+  /**
+   * Pick a frame to hold a new page, from the free list first and then from the replacer.
+   * A victim frame is written back if dirty and removed from the page table.
+   * @param[out] frame_id id of the acquired frame
+   * @return false if every frame is pinned
+   */
+  bool AcquireFrame(frame_id_t *frame_id);
+
+  /**
+   * Take a victim frame from the replacer, write its page back if dirty, offer it to the compressed page cache and
+   * remove it from the page table. The frame keeps its metadata for the caller to overwrite.
+   * @param[out] frame_id id of the victim frame
+   * @return false if every frame is pinned
+   */
+  bool EvictFrame(frame_id_t *frame_id);
+
+  /**
+   * Settle a page cleaner copy of page_id that is not on disk yet. Only takes writeback_latch_, callers other than
+   * the prefetch thread hold the latch.
+   * @param page_id id of the page
+   * @param write_back true to write the pending copy now, false to drop it because a newer version of the page is
+   * about to be written or the page is being deleted
+   */
+  void SettleWriteback(page_id_t page_id, bool write_back);
+
+  /** Main loop of the page cleaner thread. */
+  void RunPageCleaner();
+
+  /**
+   * Give up a shrink to pool_size frames whose pages stayed pinned: log them and make the frames past pool_size
+   * usable again. Must be called with the latch held.
+   */
+  void CancelShrink(size_t pool_size, const std::vector<page_id_t> &pinned);
+
+  /**
+   * Copy dirty unpinned pages into pending_writebacks_ and mark them clean, until clean_fraction_ of the
+   * evictable frames are clean. Must be called with the latch held.
+   */
+  void CollectDirtyPages();
+
+  /**
+   * Write pending_writebacks_ to disk in page id order, PAGE_CLEANER_WRITE_BATCH pages per DiskManager::WritePages
+   * call. Called without the latch.
+   */
+  void WritePendingPages();
+
+  /**
+   * Forget whatever the pool holds for a page id that has just been allocated: a queued prefetch, or a copy the
+   * prefetch thread read while the page was still free. Must be called with the latch held.
+   */
+  void DropStalePage(page_id_t page_id);
+
+  /**
+   * Increment a counter that is only written with the latch held. A plain relaxed load and store is enough for a
+   * single writer and, unlike fetch_add, is not a locked instruction.
+   */
+  static void Count(std::atomic<uint64_t> &counter, int64_t delta = 1) {
+    counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+  }
+
+  /**
+   * Put a frame that no longer holds a page back on the free list, unless a shrink is retiring it. Must be called
+   * with the latch held.
+   */
+  void ReleaseFrame(frame_id_t frame_id);
+
+  /**
+   * Bind a frame to a page in the page table and put it into the replacer class of the page. Must be called with
+   * the latch held.
+   */
+  void BindFrame(frame_id_t frame_id, page_id_t page_id);
+
+  /** Charge the writeback of the page held by a frame to its owner. Must be called with the latch held. */
+  void ChargeWrite(frame_id_t frame_id) { owner_stats_[frames_.Owner(frame_id)].writes_++; }
+
+  /** Account for a frame whose pin count went from 0 to 1. Must be called with the latch held. */
+  void FramePinned();
+
+  /** Main loop of the prefetch thread. */
+  void RunPrefetcher();
+
+private:
+  size_t pool_size_;                                        // number of pages in buffer pool
+  uint32_t num_instances_;                                  // number of shards in the parallel buffer pool
+  uint32_t instance_index_;                                 // index of this shard
+  FrameArena frames_;                                       // frame payloads and metadata, indexed by frame id
+  DiskManager *disk_manager_;                               // pointer to the disk manager.
+  std::unordered_map<page_id_t, frame_id_t> page_table_;    // to keep track of pages
+  PriorityReplacer *replacer_;                              // to find an unpinned page for replacement
+  std::unordered_set<page_id_t> cached_pages_;              // pages with a residency hint
+  CompressedPageCache compressed_cache_;                    // second tier for clean evicted pages
+  std::list<frame_id_t> free_list_;                         // to find a free page for replacement
+  std::mutex latch_;                                        // to protect shared data structure
+  std::mutex resize_latch_;                                 // serializes ResizePool calls
+  std::condition_variable unpin_cv_;                        // wakes a shrink waiting for pinned frames
+  size_t retiring_from_;                                    // first frame a shrink in progress retires
+  size_t frame_quota_;                                      // frames the pool may fill, see SetFrameQuota
+
+  std::mutex writeback_latch_;                              // held while a pending copy is written to disk
+  std::map<page_id_t, std::unique_ptr<char[]>> pending_writebacks_;  // cleaned copies not on disk yet
+  std::thread cleaner_thread_;                              // background page cleaner
+  std::condition_variable cleaner_cv_;                      // wakes the cleaner on demand or on stop
+  bool cleaner_running_{false};                             // protected by latch_
+  double clean_fraction_{PAGE_CLEANER_CLEAN_FRACTION};      // target fraction of clean evictable frames
+  std::atomic<uint64_t> foreground_writebacks_{0};          // dirty victims written on the demand path
+  std::atomic<uint64_t> background_writebacks_{0};          // pages written by the cleaner
+
+  std::atomic<uint64_t> fetches_{0};                        // counters reported by GetStats, written under latch_
+  std::atomic<uint64_t> hits_{0};
+  std::atomic<uint64_t> misses_{0};
+  std::atomic<uint64_t> failed_fetches_{0};
+  std::atomic<uint64_t> evictions_{0};
+  std::atomic<uint64_t> cached_evictions_{0};
+  std::atomic<uint64_t> new_pages_{0};
+  std::atomic<uint64_t> deleted_pages_{0};
+  std::atomic<uint64_t> resident_pages_{0};
+  std::atomic<uint64_t> cached_resident_pages_{0};
+  std::atomic<uint64_t> pinned_frames_{0};
+  std::atomic<uint64_t> pinned_high_water_{0};
+  std::unordered_map<page_owner_t, PageOwnerStats> owner_stats_;  // page I/O per owner tag, protected by latch_
+
+  std::deque<PrefetchRequest> prefetch_queue_;             // pages waiting for the prefetch thread
+  std::unordered_set<page_id_t> prefetching_;               // queued or being read, erased to cancel a prefetch
+  std::unordered_set<page_id_t> prefetch_reading_;          // pages the prefetch thread is reading right now
+  std::thread prefetch_thread_;                             // background read-ahead
+  std::condition_variable prefetch_cv_;                     // wakes the prefetch thread and threads waiting on it
+  bool prefetch_running_{false};                            // protected by latch_
+  bool prefetch_stopped_{false};                            // set by StopPrefetcher, protected by latch_
+  BufferPoolManager *chain_pool_{this};                     // queues the next page of a chain, see SetChainPool
+};
+
+#endif  // MINISQL_BUFFER_POOL_MANAGER_INSTANCE_H
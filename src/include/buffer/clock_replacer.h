@@ -0,0 +1,58 @@
+#ifndef MINISQL_CLOCK_REPLACER_H
+#define MINISQL_CLOCK_REPLACER_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+#include "buffer/replacer.h"
+#include "common/config.h"
+
+/**
+ * ClockReplacer implements the CLOCK (second chance) replacement policy.
+ *
+ * Every frame owns an evictable flag and a reference bit. Pin and Unpin only flip these bits, which is less work
+ * than moving a frame in a list. The clock hand is only moved by Victim, which sweeps the frames, clears the reference
+ * bits it passes and evicts the first evictable frame whose bit is already clear. The bits are atomic, so the
+ * replacer is also safe to call without an outer lock, see replacer_concurrency_benchmark.
+ *
+ * Inside a buffer pool that does not make hits concurrent: BufferPoolManagerInstance looks up and pins a page under
+ * its own latch and calls the replacer, through PriorityReplacer, under that latch too. Hits on one pool instance are
+ * serialized whatever the policy, see pool_hit_concurrency_benchmark.
+ */
+class ClockReplacer : public Replacer {
+ public:
+  /**
+   * Create a new ClockReplacer.
+   * @param num_pages the maximum number of pages the ClockReplacer will be required to store
+   */
+  explicit ClockReplacer(size_t num_pages);
+
+  ~ClockReplacer() override = default;
+
+  bool Victim(frame_id_t *frame_id) override;
+
+  void Pin(frame_id_t frame_id) override;
+
+  void Unpin(frame_id_t frame_id) override;
+
+  void Resize(size_t num_pages) override;
+
+  std::vector<frame_id_t> GetFramesByPriority() override;
+
+  size_t Size() override;
+
+ private:
+  struct Slot {
+    std::atomic<bool> evictable_{false};
+    std::atomic<bool> referenced_{false};
+  };
+
+  size_t num_pages_;
+  std::unique_ptr<Slot[]> slots_;  // clock slots indexed by frame id
+  std::atomic<size_t> size_{0};
+  std::mutex latch_;               // serializes the clock hand
+  size_t hand_{0};
+};
+
+#endif  // MINISQL_CLOCK_REPLACER_H
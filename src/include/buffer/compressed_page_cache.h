@@ -0,0 +1,103 @@
+#ifndef MINISQL_COMPRESSED_PAGE_CACHE_H
+#define MINISQL_COMPRESSED_PAGE_CACHE_H
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+#include "common/config.h"
+#include "common/macros.h"
+
+/**
+ * CompressedPageCache is the optional second tier of a buffer pool instance. Clean pages evicted from the frames are
+ * compressed with LZCodec and kept here, so that a later miss on them costs a decompression instead of a disk read.
+ *
+ * The tier is exclusive: a page that is found here is handed back to the pool and removed, and a page is only
+ * inserted when it leaves the pool clean, so a cached page always matches what is on disk. Pages that compress to
+ * more than COMPRESSED_CACHE_MAX_RATIO of their size are not worth the space and are rejected.
+ *
+ * The compressed pages together take at most capacity bytes, the least recently inserted ones are dropped first.
+ * Not thread safe, the owning instance calls it with its latch held. The counters are relaxed atomics written by
+ * that single writer, so GetStats may read them without the latch.
+ */
+class CompressedPageCache {
+public:
+  DISALLOW_COPY_AND_MOVE(CompressedPageCache)
+
+  /** @param capacity bytes the compressed pages may take, 0 disables the cache */
+  explicit CompressedPageCache(size_t capacity = 0) : capacity_(capacity) {}
+
+  ~CompressedPageCache() = default;
+
+  /**
+   * Compress a clean page and keep it, replacing an older copy of the same page.
+   * @param page_id id of the page
+   * @param data PAGE_SIZE bytes of the page
+   * @return false if the cache is disabled or the page does not compress well enough
+   */
+  bool Insert(page_id_t page_id, const char *data);
+
+  /**
+   * Look up a page, decompress it and remove it from the cache.
+   * @param page_id id of the page
+   * @param[out] data PAGE_SIZE bytes for the page
+   * @return false if the page is not cached
+   */
+  bool Take(page_id_t page_id, char *data);
+
+  /** Forget a page that is about to change on disk or be deallocated. */
+  void Erase(page_id_t page_id);
+
+  /** Change the capacity, dropping the oldest pages until they fit. 0 disables the cache and empties it. */
+  void SetCapacity(size_t capacity);
+
+  size_t GetCapacity() const { return capacity_; }
+
+  /** @return number of pages held */
+  uint64_t GetPages() const { return pages_.load(std::memory_order_relaxed); }
+
+  /** @return bytes the compressed pages take */
+  uint64_t GetBytes() const { return bytes_.load(std::memory_order_relaxed); }
+
+  /** @return number of Take calls */
+  uint64_t GetLookups() const { return lookups_.load(std::memory_order_relaxed); }
+
+  /** @return number of Take calls that found the page */
+  uint64_t GetHits() const { return hits_.load(std::memory_order_relaxed); }
+
+  /** @return number of pages rejected by Insert because they did not compress well enough */
+  uint64_t GetRejects() const { return rejects_.load(std::memory_order_relaxed); }
+
+  /** @return number of pages dropped to make room for newer ones */
+  uint64_t GetEvictions() const { return evictions_.load(std::memory_order_relaxed); }
+
+private:
+  struct Entry {
+    std::unique_ptr<char[]> data_;          // the compressed page
+    size_t size_;                           // size of the compressed page
+    std::list<page_id_t>::iterator order_;  // position in order_
+  };
+
+  /** Remove an entry and give its bytes back. */
+  void RemoveEntry(std::unordered_map<page_id_t, Entry>::iterator it);
+
+  /** Drop the oldest pages until at most target bytes are used. */
+  void ShrinkTo(size_t target);
+
+  static void Count(std::atomic<uint64_t> &counter, int64_t delta = 1) {
+    counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+  }
+
+  size_t capacity_;                                // bytes the compressed pages may take
+  std::unordered_map<page_id_t, Entry> entries_;   // compressed pages by page id
+  std::list<page_id_t> order_;                     // page ids, the oldest insertion first
+  std::atomic<uint64_t> pages_{0};
+  std::atomic<uint64_t> bytes_{0};
+  std::atomic<uint64_t> lookups_{0};
+  std::atomic<uint64_t> hits_{0};
+  std::atomic<uint64_t> rejects_{0};
+  std::atomic<uint64_t> evictions_{0};
+};
+
+#endif  // MINISQL_COMPRESSED_PAGE_CACHE_H
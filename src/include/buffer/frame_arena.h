@@ -0,0 +1,93 @@
+#ifndef MINISQL_FRAME_ARENA_H
+#define MINISQL_FRAME_ARENA_H
+
+#include "common/config.h"
+#include "common/macros.h"
+#include "page/page.h"
+
+/**
+ * FrameArena holds the frames of one buffer pool.
+ *
+ * The payloads of all frames are a single anonymous mapping, page aligned and, with huge pages enabled, aligned to
+ * FRAME_ARENA_HUGE_PAGE_SIZE and advised for transparent huge pages, so that a large pool costs a few TLB entries
+ * instead of one per frame. Aligned payloads are also what direct I/O needs.
+ *
+ * The book-keeping information of the frames is kept as one array per field, indexed by frame id, so that a sweep
+ * over the pin counts or the dirty flags of the whole pool reads contiguous memory. The Page objects handed out by
+ * the buffer pool only point into the arena.
+ *
+ * Address space for max_frames frames is reserved up front and only committed as the arena grows, so Resize never
+ * moves a frame and pages handed out stay valid.
+ */
+class FrameArena {
+public:
+  DISALLOW_COPY_AND_MOVE(FrameArena)
+
+  /**
+   * Map the frames of a pool. Throws std::bad_alloc if the mapping fails.
+   * @param num_frames the number of frames
+   * @param huge_pages true to back the payloads with transparent huge pages where the kernel allows it
+   * @param max_frames the number of frames the arena can grow to, at least num_frames
+   */
+  FrameArena(size_t num_frames, bool huge_pages, size_t max_frames = 0);
+
+  ~FrameArena();
+
+  /**
+   * Grow or shrink the arena. New frames are empty and zeroed. The frames past a smaller size must not hold a page,
+   * their memory is given back to the operating system. Throws std::bad_alloc if the memory cannot be committed.
+   * @param num_frames the new number of frames, at most GetMaxFrames()
+   */
+  void Resize(size_t num_frames);
+
+  /**
+   * Give the memory of an empty frame back to the operating system, it reads as zeros when the frame is used again.
+   * Does nothing for an arena backed by huge pages, which would have to be split.
+   */
+  void Discard(frame_id_t frame_id);
+
+  /** @return the page bound to a frame */
+  inline Page *GetPage(frame_id_t frame_id) { return &pages_[frame_id]; }
+
+  /** @return the payload of a frame */
+  inline char *GetData(frame_id_t frame_id) { return data_ + static_cast<size_t>(frame_id) * PAGE_SIZE; }
+
+  /** @return the id of the page held by a frame */
+  inline page_id_t &PageId(frame_id_t frame_id) { return page_ids_[frame_id]; }
+
+  /** @return the pin count of a frame */
+  inline int &PinCount(frame_id_t frame_id) { return pin_counts_[frame_id]; }
+
+  /** @return the dirty flag of a frame */
+  inline bool &IsDirty(frame_id_t frame_id) { return is_dirty_[frame_id]; }
+
+  /** @return the table or index the page held by a frame belongs to, see PageOwnerScope */
+  inline page_owner_t &Owner(frame_id_t frame_id) { return owners_[frame_id]; }
+
+  /** @return the number of frames */
+  inline size_t GetNumFrames() const { return num_frames_; }
+
+  /** @return the number of frames the arena can grow to */
+  inline size_t GetMaxFrames() const { return max_frames_; }
+
+  /** @return true if the payloads were advised for transparent huge pages */
+  inline bool UsesHugePages() const { return huge_pages_; }
+
+private:
+  /** Make the elements [from, to) of an array in the reservation readable and writable. */
+  static void Commit(void *array, size_t element_size, size_t from, size_t to);
+
+  size_t num_frames_{0};
+  size_t max_frames_;
+  bool huge_pages_{false};
+  char *mapping_;                              // start of the reservation, before alignment
+  size_t mapping_size_;                        // length of the reservation
+  char *data_;                                 // payload of frame 0
+  Page *pages_;                                // pages bound to the frames
+  page_id_t *page_ids_;                        // page held by each frame
+  int *pin_counts_;                            // pin count of each frame
+  bool *is_dirty_;                             // dirty flag of each frame
+  page_owner_t *owners_;                       // owner tag of each frame
+};
+
+#endif  // MINISQL_FRAME_ARENA_H
@@ -0,0 +1,70 @@
+#ifndef MINISQL_LRU_K_REPLACER_H
+#define MINISQL_LRU_K_REPLACER_H
+
+#include <deque>
+#include <mutex>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "buffer/replacer.h"
+#include "common/config.h"
+
+/**
+ * LRUKReplacer implements the LRU-K replacement policy.
+ *
+ * The backward k-distance of a frame is the time since its k-th most recent access. The victim is the evictable
+ * frame with the largest backward k-distance. Frames with fewer than k accesses have an infinite distance and are
+ * evicted first, oldest first access first, so pages touched once by a sequential scan cannot push out pages that
+ * are accessed repeatedly, such as B+ tree inner pages.
+ */
+class LRUKReplacer : public Replacer {
+ public:
+  /**
+   * Create a new LRUKReplacer.
+   * @param num_pages the maximum number of pages the LRUKReplacer will be required to store
+   * @param k number of accesses kept per frame
+   */
+  explicit LRUKReplacer(size_t num_pages, size_t k = LRUK_REPLACER_K);
+
+  ~LRUKReplacer() override = default;
+
+  bool Victim(frame_id_t *frame_id) override;
+
+  /** Records an access to the frame and makes it non-evictable. */
+  void Pin(frame_id_t frame_id) override;
+
+  void Unpin(frame_id_t frame_id) override;
+
+  void Remove(frame_id_t frame_id) override;
+
+  std::vector<frame_id_t> GetFramesByPriority() override;
+
+  size_t Size() override;
+
+ private:
+  using Entry = std::pair<uint64_t, frame_id_t>;
+
+  /** Per frame access history, the most recent k access timestamps. */
+  struct FrameHistory {
+    std::deque<uint64_t> accesses_;
+    bool evictable_{false};
+  };
+
+  /** @return the key ordering this frame among the evictable frames of the same class */
+  Entry KeyOf(frame_id_t frame_id) const;
+
+  /** @return the set holding this frame while it is evictable */
+  std::set<Entry> &SetOf(frame_id_t frame_id);
+
+  void Forget(frame_id_t frame_id);
+
+  std::mutex latch_;
+  size_t k_;
+  uint64_t current_timestamp_{0};
+  std::vector<FrameHistory> frames_;  // access history indexed by frame id
+  std::set<Entry> history_;           // evictable frames with less than k accesses, by first access
+  std::set<Entry> cache_;             // evictable frames with k accesses, by k-th most recent access
+};
+
+#endif  // MINISQL_LRU_K_REPLACER_H
@@ -14,6 +14,9 @@ using namespace std;
 
 /**
  * LRUReplacer implements the Least Recently Used replacement policy.
+ *
+ * Unpinned frames are kept in an intrusive doubly linked list whose nodes live in a frame-indexed array,
+ * so Pin, Unpin and Victim are all constant time and never allocate.
  */
 class LRUReplacer : public Replacer {
  public:
@@ -34,14 +37,26 @@ class LRUReplacer : public Replacer {
 
   void Unpin(frame_id_t frame_id) override;
 
+  std::vector<frame_id_t> GetFramesByPriority() override;
+
   size_t Size() override;
 
  private:
-  // add your own private member variables here
-  std::list<frame_id_t> lru_list_;
-  size_t max_num_pages;
-  //std::list<frame_id_t>::iterator begin_;
-  //std::list<frame_id_t>::iterator end_;
+  /** List node of a frame, linked by frame id. */
+  struct Node {
+    frame_id_t prev_{INVALID_FRAME_ID};
+    frame_id_t next_{INVALID_FRAME_ID};
+    bool in_list_{false};
+  };
+
+  /** Unlink a frame from the list, the caller must make sure it is in the list. */
+  void Unlink(frame_id_t frame_id);
+
+  std::mutex latch_;
+  std::vector<Node> nodes_;              // list nodes indexed by frame id
+  frame_id_t head_{INVALID_FRAME_ID};    // least recently unpinned frame, the next victim
+  frame_id_t tail_{INVALID_FRAME_ID};    // most recently unpinned frame
+  size_t size_{0};
 };
 
-#endif  // MINISQL_LRU_REPLACER_H
\ No newline at end of file
+#endif  // MINISQL_LRU_REPLACER_H
@@ -0,0 +1,38 @@
+#ifndef MINISQL_LZ_CODEC_H
+#define MINISQL_LZ_CODEC_H
+
+#include <cstddef>
+
+/**
+ * LZCodec is a small LZ77 byte compressor in the spirit of LZ4, fast enough to run on the eviction path of the
+ * buffer pool. Pages full of fixed width char columns, padding and zeroed free space compress several times.
+ *
+ * The compressed stream is a list of sequences. A sequence starts with a token byte whose high nibble is the number
+ * of literals and whose low nibble is the match length minus LZ_MIN_MATCH. A nibble of 15 is followed by bytes of
+ * 255 and one final byte smaller than 255 that add up to the rest of the length. The literals come next, then the
+ * offset of the match as two little endian bytes. The last sequence only has literals and ends the stream.
+ */
+class LZCodec {
+public:
+  /**
+   * Compress a block. Blocks are at most 64KB, matches can reach back 65535 bytes.
+   * @param src the block
+   * @param size size of the block
+   * @param[out] dst buffer for the compressed block
+   * @param capacity size of dst
+   * @return size of the compressed block, 0 if it does not fit into capacity bytes
+   */
+  static size_t Compress(const char *src, size_t size, char *dst, size_t capacity);
+
+  /**
+   * Decompress a block written by Compress.
+   * @param src the compressed block
+   * @param size size of the compressed block
+   * @param[out] dst buffer for the block
+   * @param capacity size of the block, which must fill dst exactly
+   * @return false if the compressed block is damaged or does not decompress to exactly capacity bytes
+   */
+  static bool Decompress(const char *src, size_t size, char *dst, size_t capacity);
+};
+
+#endif  // MINISQL_LZ_CODEC_H
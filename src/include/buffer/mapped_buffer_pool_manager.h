@@ -0,0 +1,112 @@
+#ifndef MINISQL_MAPPED_BUFFER_POOL_MANAGER_H
+#define MINISQL_MAPPED_BUFFER_POOL_MANAGER_H
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+
+/**
+ * MappedBufferPoolManager serves a database opened read-only, see DiskManager. It has no frames and copies nothing:
+ * FetchPage returns a page whose data points into the read-only mapping of the file, so the pages are cached once by
+ * the OS page cache and shared by every process that maps the same file.
+ *
+ * A page exists while it is pinned, it is dropped when its pin count goes back to 0. NewPage, DeletePage and dirty
+ * unpins are rejected. The mapping is read-only, so writing into the data of a fetched page faults.
+ */
+class MappedBufferPoolManager : public BufferPoolManager {
+public:
+  /**
+   * Create a new MappedBufferPoolManager.
+   * @param disk_manager the disk manager of a database opened read-only
+   */
+  explicit MappedBufferPoolManager(DiskManager *disk_manager);
+
+  ~MappedBufferPoolManager() override = default;
+
+  /** @return the page inside the mapping, nullptr if it lies past the end of the file */
+  Page *FetchPage(page_id_t page_id) override;
+
+  std::vector<Page *> FetchPages(const std::vector<page_id_t> &page_ids) override;
+
+  /** A dirty unpin is logged and unpins the page without marking it dirty. */
+  bool UnpinPage(page_id_t page_id, bool is_dirty) override;
+
+  /** There is nothing to write, @return true if the page is pinned */
+  bool FlushPage(page_id_t page_id) override;
+
+  void FlushAllPages() override {}
+
+  /** Rejected, @return nullptr */
+  Page *NewPage(page_id_t &page_id) override;
+
+  /** Rejected, @return nullptr */
+  Page *NewPageNear(page_id_t &page_id, page_id_t near_page_id) override { return NewPage(page_id); }
+
+  /** Rejected, @return false */
+  bool DeletePage(page_id_t page_id) override;
+
+  bool IsPageFree(page_id_t page_id) override;
+
+  bool CheckAllUnpinned() override;
+
+  /** @return 0, the pool has no frames */
+  size_t GetPoolSize() override { return 0; }
+
+  /** @return false, the pool has no frames */
+  bool ResizePool(size_t pool_size) override { return false; }
+
+  void SetFrameQuota(size_t frames) override {}
+
+  /** The OS page cache decides which pages stay, the hint is ignored. */
+  void SetResidencyHint(const std::vector<page_id_t> &page_ids, bool cached) override {}
+
+  void SetCompressedCacheSize(size_t capacity) override {}
+
+  void StartPageCleaner(double clean_fraction = PAGE_CLEANER_CLEAN_FRACTION) override {}
+
+  void StopPageCleaner() override {}
+
+  uint64_t GetForegroundWritebacks() override { return 0; }
+
+  uint64_t GetBackgroundWritebacks() override { return 0; }
+
+  /** A fetch of a page that is not pinned yet counts as a miss, although it costs no copy either. */
+  BufferPoolStats GetStats() override;
+
+  /** @return nothing, the pages are read by the OS page cache and never written */
+  std::map<page_owner_t, PageOwnerStats> GetOwnerStats() override { return {}; }
+
+  /** Advises the OS to read the pages into its page cache. */
+  void PrefetchPages(const std::vector<page_id_t> &page_ids) override;
+
+  /**
+   * Advises the OS to read the first page of the chain. The ids of the pages after it are only known once that page
+   * is in memory, and reading them here would block the scan on the very reads the advice is meant to hide.
+   */
+  void PrefetchChain(page_id_t page_id, size_t count, NextPageIdReader next_page_id) override;
+
+  /** @return the pinned pages */
+  std::vector<page_id_t> GetResidentPages() override;
+
+  /** @return true, the pages point into the read-only mapping */
+  bool IsReadOnly() override { return true; }
+
+private:
+  /** A pinned page and its book-keeping information. */
+  struct MappedPage {
+    page_id_t page_id_;
+    int pin_count_{0};
+    bool is_dirty_{false};
+    std::unique_ptr<Page> page_;
+  };
+
+  DiskManager *disk_manager_;
+  std::mutex latch_;
+  std::unordered_map<page_id_t, std::unique_ptr<MappedPage>> pages_;  // the pinned pages
+  BufferPoolStats stats_;                                             // counters, protected by latch_
+};
+
+#endif  // MINISQL_MAPPED_BUFFER_POOL_MANAGER_H
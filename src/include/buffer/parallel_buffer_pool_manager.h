@@ -0,0 +1,112 @@
+#ifndef MINISQL_PARALLEL_BUFFER_POOL_MANAGER_H
+#define MINISQL_PARALLEL_BUFFER_POOL_MANAGER_H
+
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "buffer/buffer_pool_manager_instance.h"
+
+/**
+ * ParallelBufferPoolManager splits the buffer pool into independent BufferPoolManagerInstance shards, each with
+ * its own latch, page table, replacer and free list. A page always lives in shard page_id % num_instances, so
+ * threads working on different pages rarely contend on the same latch.
+ *
+ * New page ids are handed out by the disk manager in increasing order, so consecutive NewPage calls land on
+ * consecutive shards in round-robin fashion.
+ */
+class ParallelBufferPoolManager : public BufferPoolManager {
+public:
+  /**
+   * Create a new ParallelBufferPoolManager.
+   * @param num_instances the number of shards
+   * @param pool_size the number of frames in each shard
+   * @param disk_manager the disk manager
+   * @param replacer_type the replacement policy of every shard
+   */
+  ParallelBufferPoolManager(size_t num_instances, size_t pool_size, DiskManager *disk_manager,
+                            ReplacerType replacer_type = ReplacerType::kLRU);
+
+  ~ParallelBufferPoolManager() override;
+
+  Page *FetchPage(page_id_t page_id) override;
+
+  /** Every shard reads its misses with its own batch. */
+  std::vector<Page *> FetchPages(const std::vector<page_id_t> &page_ids) override;
+
+  bool UnpinPage(page_id_t page_id, bool is_dirty) override;
+
+  bool FlushPage(page_id_t page_id) override;
+
+  /** Collects the dirty pages of all shards into one batch, so that the writes are sorted and synced once. */
+  void FlushAllPages() override;
+
+  Page *NewPage(page_id_t &page_id) override;
+
+  Page *NewPageNear(page_id_t &page_id, page_id_t near_page_id) override;
+
+  bool DeletePage(page_id_t page_id) override;
+
+  bool IsPageFree(page_id_t page_id) override;
+
+  bool CheckAllUnpinned() override;
+
+  size_t GetPoolSize() override;
+
+  /**
+   * Every shard gets pool_size / num_instances frames, the first pool_size % num_instances one more, so that the
+   * shards add up to pool_size. Returns false if a shard could not be resized, the others keep their new size then.
+   */
+  bool ResizePool(size_t pool_size) override;
+
+  /** Every shard gets an equal part of the quota. */
+  void SetFrameQuota(size_t frames) override;
+
+  void SetResidencyHint(const std::vector<page_id_t> &page_ids, bool cached) override;
+
+  /** Every shard gets capacity / num_instances bytes. */
+  void SetCompressedCacheSize(size_t capacity) override;
+
+  /** Start one page cleaner per shard. */
+  void StartPageCleaner(double clean_fraction = PAGE_CLEANER_CLEAN_FRACTION) override;
+
+  void StopPageCleaner() override;
+
+  uint64_t GetForegroundWritebacks() override;
+
+  uint64_t GetBackgroundWritebacks() override;
+
+  /** The counters of all shards summed up, the pinned high-water mark is the sum of the marks of the shards. */
+  BufferPoolStats GetStats() override;
+
+  /** The I/O of every owner summed up over the shards. */
+  std::map<page_owner_t, PageOwnerStats> GetOwnerStats() override;
+
+  void PrefetchPages(const std::vector<page_id_t> &page_ids) override;
+
+  /** Queues the chain on the shard of its first page, the shards queue every next page on the shard it belongs to. */
+  void PrefetchChain(page_id_t page_id, size_t count, NextPageIdReader next_page_id) override;
+
+  /** The resident pages of the shards interleaved by rank, the hottest page of every shard first. */
+  std::vector<page_id_t> GetResidentPages() override;
+
+  bool IsReadOnly() override { return false; }
+
+private:
+  /**
+   * Put a page that was just allocated into its shard, or deallocate it again if the shard has no free frame.
+   * @param[out] page_id the allocated page id, INVALID_PAGE_ID if the page could not be created
+   */
+  Page *InstallNewPage(page_id_t &page_id, page_id_t allocated_page_id);
+
+  /** @return the shard responsible for page_id */
+  BufferPoolManagerInstance *GetInstance(page_id_t page_id) {
+    return instances_[static_cast<size_t>(page_id) % num_instances_];
+  }
+
+  size_t num_instances_;                               // number of shards
+  size_t pool_size_;                                   // initial number of frames in each shard
+  DiskManager *disk_manager_;                          // pointer to the disk manager.
+  std::vector<BufferPoolManagerInstance *> instances_;  // shards, indexed by page_id % num_instances_
+};
+
+#endif  // MINISQL_PARALLEL_BUFFER_POOL_MANAGER_H
@@ -0,0 +1,86 @@
+#ifndef MINISQL_PRIORITY_REPLACER_H
+#define MINISQL_PRIORITY_REPLACER_H
+
+#include <memory>
+#include <vector>
+
+#include "buffer/replacer.h"
+#include "common/config.h"
+
+/**
+ * PriorityReplacer splits the frames of a buffer pool into two classes, each kept by its own replacer of the same
+ * policy. Frames holding pages of tables and indexes marked CACHE are protected, all other frames are normal.
+ *
+ * Victims come from the normal class. A protected frame is only evicted when no normal frame is evictable, or when
+ * the protected frames take more than max_protected_fraction of the pool, so a cached table cannot crowd out
+ * everything else either.
+ *
+ * The class of a frame is set by the buffer pool when it binds a page to the frame. The replacer remembers which
+ * frames are evictable, so that changing the class of an unpinned frame moves it to the other replacer. Only
+ * called with the latch of the buffer pool held.
+ */
+class PriorityReplacer : public Replacer {
+public:
+  /**
+   * Create a new PriorityReplacer.
+   * @param normal replacer of the normal frames, owned by the PriorityReplacer
+   * @param protect replacer of the protected frames, owned by the PriorityReplacer
+   * @param num_pages the number of frames
+   * @param max_protected_fraction fraction of the frames the protected class may take before it loses its priority
+   */
+  PriorityReplacer(Replacer *normal, Replacer *protect, size_t num_pages,
+                   double max_protected_fraction = CACHED_PAGES_MAX_FRACTION);
+
+  ~PriorityReplacer() override = default;
+
+  bool Victim(frame_id_t *frame_id) override;
+
+  void Pin(frame_id_t frame_id) override;
+
+  void Unpin(frame_id_t frame_id) override;
+
+  void Remove(frame_id_t frame_id) override;
+
+  void Resize(size_t num_pages) override;
+
+  /** The protected frames first, each class in the priority order of its replacer. */
+  std::vector<frame_id_t> GetFramesByPriority() override;
+
+  size_t Size() override;
+
+  /**
+   * Move a frame to the protected or to the normal class. An evictable frame stays evictable.
+   * @param frame_id the id of the frame
+   * @param is_protected true for the protected class
+   */
+  void SetProtected(frame_id_t frame_id, bool is_protected);
+
+  /** @return true if the frame is in the protected class */
+  bool IsProtected(frame_id_t frame_id) const {
+    return static_cast<size_t>(frame_id) < frames_.size() && frames_[frame_id].protected_;
+  }
+
+  /** @return number of frames in the protected class, pinned or not */
+  size_t GetProtectedFrames() const { return protected_frames_; }
+
+private:
+  struct FrameClass {
+    bool protected_{false};
+    bool evictable_{false};
+  };
+
+  /** @return the replacer of the class of a frame */
+  Replacer *ReplacerOf(frame_id_t frame_id) { return IsProtected(frame_id) ? protect_.get() : normal_.get(); }
+
+  /** Make sure frame_id has a slot in frames_. */
+  FrameClass &Slot(frame_id_t frame_id);
+
+  std::unique_ptr<Replacer> normal_;   // frames of the normal class
+  std::unique_ptr<Replacer> protect_;  // frames of the protected class
+  std::vector<FrameClass> frames_;     // class of every frame, indexed by frame id
+  size_t protected_frames_{0};         // frames whose class is protected
+  size_t max_protected_frames_;        // protected frames beyond this lose their priority
+  double max_protected_fraction_;
+};
+
+#endif  // MINISQL_PRIORITY_REPLACER_H
@@ -0,0 +1,38 @@
+#ifndef MINISQL_READ_AHEAD_H
+#define MINISQL_READ_AHEAD_H
+
+#include "buffer/buffer_pool_manager.h"
+#include "common/config.h"
+
+/**
+ * ReadAhead asks the buffer pool to prefetch the pages a scan is about to walk along its page chain. The ids of those
+ * pages are only known from the chain itself, so the pool follows it, see BufferPoolManager::PrefetchChain: it reads
+ * the next page of the scan, takes the id of the page after it from its data and so on, up to the window.
+ *
+ * Read-ahead starts once the scan has moved through READ_AHEAD_TRIGGER pages, so a lookup that touches one or two
+ * pages does not read the rest of the chain. The window is refilled once the scan has consumed half of it, so a
+ * steady scan always has between half a window and a full window of pages requested ahead of it.
+ */
+class ReadAhead {
+ public:
+  /**
+   * @param buffer_pool_manager the pool to prefetch into, nullptr to disable read-ahead
+   * @param next_page_id reads the id of the next page of the chain out of the data of a page
+   */
+  explicit ReadAhead(BufferPoolManager *buffer_pool_manager = nullptr, NextPageIdReader next_page_id = nullptr)
+      : buffer_pool_manager_(buffer_pool_manager), next_page_id_(next_page_id) {}
+
+  /**
+   * Tell the read-ahead that the scan moved on to the next page of its chain.
+   * @param next_page_id id of the page after the one the scan is on now, INVALID_PAGE_ID at the end of the chain
+   */
+  void Advance(page_id_t next_page_id);
+
+ private:
+  BufferPoolManager *buffer_pool_manager_;
+  NextPageIdReader next_page_id_;
+  int pages_scanned_{0};        // pages the scan has moved through
+  size_t requested_ahead_{0};   // pages requested ahead of the scan that it has not reached yet
+};
+
+#endif  // MINISQL_READ_AHEAD_H
@@ -2,8 +2,18 @@
 #define MINISQL_REPLACER_H
 
 #include <cstdio>
+#include <vector>
 #include "common/config.h"
 
+/**
+ * Replacement policies a buffer pool can be constructed with.
+ */
+enum class ReplacerType {
+  kLRU,   /** least recently used */
+  kLRUK,  /** least recently used by backward k-distance, resists sequential scans */
+  kClock, /** second chance, hits only set a reference bit */
+};
+
 /**
  * Replacer is an abstract class that tracks page usage.
  */
@@ -22,6 +32,7 @@ public:
 
   /**
    * Pins a frame, indicating that it should not be victimized until it is unpinned.
+   * The buffer pool pins a frame every time it hands the frame out, so a pin also counts as an access.
    * @param frame_id the id of the frame to pin
    */
   virtual void Pin(frame_id_t frame_id) = 0;
@@ -32,6 +43,25 @@ public:
    */
   virtual void Unpin(frame_id_t frame_id) = 0;
 
+  /**
+   * Drops a frame whose page has been deleted, together with any access history kept for it.
+   * @param frame_id the id of the frame to remove
+   */
+  virtual void Remove(frame_id_t frame_id) { Pin(frame_id); }
+
+  /**
+   * Change the number of frames the replacer tracks, called when the buffer pool is resized. Frames at or past a
+   * smaller size must have been removed. Must not run concurrently with any other call.
+   * @param num_pages the new number of frames
+   */
+  virtual void Resize(size_t num_pages) {}
+
+  /**
+   * @return the evictable frames, the frame the policy would evict last first. Used to save the hot set of a buffer
+   * pool across restarts.
+   */
+  virtual std::vector<frame_id_t> GetFramesByPriority() = 0;
+
   /** @return the number of elements in the replacer that can be victimized */
   virtual size_t Size() = 0;
 };
@@ -0,0 +1,117 @@
+#ifndef MINISQL_SHARED_BUFFER_POOL_H
+#define MINISQL_SHARED_BUFFER_POOL_H
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "common/config.h"
+#include "common/macros.h"
+
+/**
+ * Frame quota of one database in a SharedBufferPool, see SharedBufferPool::GetQuota.
+ */
+struct SharedBufferPoolQuota {
+  size_t min_frames_{0};  // frames the database always gets
+  size_t max_frames_{0};  // frames the database never gets more of
+  size_t frames_{0};      // quota set by the last rebalance
+  double load_{0};        // average fetches per rebalance interval
+};
+
+/**
+ * SharedBufferPool is the frame budget of all open databases. Each database keeps the buffer pool of its own file,
+ * so a page is found by the database it belongs to and its page id, but the frames those pools fill add up to at
+ * most pool_size: every pool gets a quota, see BufferPoolManager::SetFrameQuota, and Rebalance moves quota from idle
+ * databases to busy ones.
+ *
+ * A database always gets its minimum and never more than its maximum. The frames left above the minimums are handed
+ * out in proportion to the load of each database, a moving average of its fetches per interval, and what a database
+ * cannot take because of its maximum goes to the others. A background thread rebalances every interval_ms.
+ *
+ * A registered pool should be able to grow to its maximum, DBStorageEngine sizes it to the whole budget. The pools
+ * must be unregistered before they are deleted.
+ */
+class SharedBufferPool {
+public:
+  DISALLOW_COPY_AND_MOVE(SharedBufferPool)
+
+  /**
+   * @param pool_size the number of frames shared by the registered pools
+   * @param interval_ms how often the background thread rebalances, 0 to rebalance only on demand
+   */
+  explicit SharedBufferPool(size_t pool_size, int interval_ms = SHARED_BUFFER_POOL_INTERVAL_MS);
+
+  ~SharedBufferPool();
+
+  /**
+   * Start sharing the budget with a pool and rebalance. A minimum that does not fit next to the minimums of the
+   * other pools is cut down to what is left.
+   * @param bpm the buffer pool of a database
+   * @param min_frames frames the pool always gets
+   * @param max_frames frames the pool never gets more of, 0 for the whole budget
+   */
+  void Register(BufferPoolManager *bpm, size_t min_frames = SHARED_BUFFER_POOL_MIN_FRAMES, size_t max_frames = 0);
+
+  /** Stop sharing the budget with a pool, its frames go to the others. */
+  void Unregister(BufferPoolManager *bpm);
+
+  /**
+   * Change the minimum and maximum of a registered pool and rebalance.
+   * @return false if the pool is not registered, the minimum is larger than the maximum or the minimums of all pools
+   * would not fit into the budget
+   */
+  bool SetLimits(BufferPoolManager *bpm, size_t min_frames, size_t max_frames);
+
+  /** @return the quota of a registered pool, all zero if the pool is not registered */
+  SharedBufferPoolQuota GetQuota(BufferPoolManager *bpm);
+
+  /** Update the load of every pool and hand out the budget again. */
+  void Rebalance();
+
+  /** @return the number of frames shared by the registered pools */
+  size_t GetPoolSize() const { return pool_size_; }
+
+private:
+  struct Member {
+    BufferPoolManager *bpm_;
+    SharedBufferPoolQuota quota_;
+    uint64_t last_fetches_;  // fetches of the pool at the last rebalance
+  };
+
+  /** Quotas computed by one Distribute, numbered in the order they were computed. */
+  struct Distribution {
+    uint64_t generation_{0};
+    std::vector<std::pair<BufferPoolManager *, size_t>> frames_;
+  };
+
+  /** @return the member of a pool, nullptr if it is not registered. Must be called with the latch held. */
+  Member *Find(BufferPoolManager *bpm);
+
+  /** Compute the quotas. Must be called with the latch held, the quotas are applied by Apply after releasing it. */
+  Distribution Distribute();
+
+  /**
+   * Set the quotas of a distribution, unless those of a later one are set already. A pool that is unregistered after
+   * its quota was computed is still alive then: Unregister applies the later distribution before it returns.
+   */
+  void Apply(const Distribution &distribution);
+
+  /** Main loop of the rebalance thread. */
+  void RunRebalancer();
+
+  size_t pool_size_;
+  int interval_ms_;
+  std::vector<Member> members_;   // registered pools
+  std::mutex latch_;              // protects members_ and generation_
+  uint64_t generation_{0};        // number of the last distribution computed
+  std::mutex apply_latch_;        // held while the quotas are applied, protects applied_generation_
+  uint64_t applied_generation_{0};
+  std::thread rebalance_thread_;  // background rebalancing
+  std::condition_variable rebalance_cv_;
+  bool running_{false};           // protected by latch_
+};
+
+#endif  // MINISQL_SHARED_BUFFER_POOL_H
@@ -63,6 +63,8 @@ private:
 /**
  * Catalog manager
  *
+ * Creating, dropping and altering tables and indexes fails with DB_FAILED in a read-only database, see
+ * BufferPoolManager::RejectWrite.
  */
 class CatalogManager {
 public:
@@ -89,9 +91,41 @@ public:
 
   dberr_t DropIndex(const std::string &table_name, const std::string &index_name);
 
+  /**
+   * Mark a table, or all indexes of a table, resident in the buffer pool (ALTER TABLE ... CACHE). The flag is saved
+   * in the table or index metadata, so it is applied again when the catalog is loaded.
+   * @param table_name name of the table
+   * @param indexes true for the indexes of the table, false for the table itself
+   * @param cached true to keep the pages resident, false to make them ordinary again
+   */
+  dberr_t SetTableCached(const std::string &table_name, bool indexes, bool cached);
+
+  /**
+   * Move the pages of every table heap, from the highest page id down, into the lowest free pages of the database, so
+   * that the free pages gather at its end for DiskManager::Shrink. The index entries of the moved rows are pointed at
+   * their new row ids. Index and catalog pages are not moved. Must not run concurrently with other statements.
+   * @return number of pages moved
+   */
+  size_t CompactTables();
+
+  /** @return the page owner tag of a table, see PageOwnerScope. Tables get odd tags and indexes even ones. */
+  static page_owner_t TableOwner(table_id_t table_id) { return table_id * 2 + 1; }
+
+  /** @return the page owner tag of an index, see PageOwnerScope */
+  static page_owner_t IndexOwner(index_id_t index_id) { return index_id * 2 + 2; }
+
+  /**
+   * @return the name of the table or index with an owner tag, such as "table t" or "index idx on t", a placeholder
+   * with the id for one that was dropped, and "other" for INVALID_PAGE_OWNER
+   */
+  std::string GetOwnerName(page_owner_t owner) const;
+
 private:
   dberr_t FlushCatalogMetaPage() const;
 
+  /** Write the metadata of a table back to its metadata page */
+  dberr_t FlushTableMetaPage(const table_id_t table_id);
+
   dberr_t LoadTable(const table_id_t table_id, const page_id_t page_id);
 
   dberr_t LoadIndex(const index_id_t index_id, const page_id_t page_id);
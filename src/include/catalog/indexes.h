@@ -32,6 +32,11 @@ public:
 
   inline index_id_t GetIndexId() const { return index_id_; }
 
+  /** @return true if the index was marked resident with ALTER TABLE ... INDEXES CACHE */
+  inline bool IsCached() const { return cached_; }
+
+  inline void SetCached(bool cached) { cached_ = cached; }
+
 private:
   IndexMetadata() = delete;
 
@@ -44,6 +49,7 @@ private:
   std::string index_name_;
   table_id_t table_id_;
   std::vector<uint32_t> key_map_;  /** The mapping of index key to tuple key */
+  bool cached_{false};
 };
 
 /**
@@ -77,6 +83,16 @@ public:
 
   inline TableInfo *GetTableInfo() const { return table_info_; }
 
+  inline IndexMetadata *GetIndexMeta() const { return meta_data_; }
+
+  inline bool IsCached() const { return meta_data_->IsCached(); }
+
+  /** Mark the index resident in the buffer pool or not, see Index::SetCached. */
+  void SetCached(bool cached) {
+    meta_data_->SetCached(cached);
+    index_->SetCached(cached);
+  }
+
 private:
   explicit IndexInfo() : meta_data_{nullptr}, index_{nullptr}, table_info_{nullptr},
                          key_schema_{nullptr}, heap_(new SimpleMemHeap()) {}
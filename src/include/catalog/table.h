@@ -26,8 +26,16 @@ class TableMetadata {
 
   inline uint32_t GetFirstPageId() const { return root_page_id_; }
 
+  /** Point the metadata at a new first page of the table heap, e.g. after CatalogManager::CompactTables moved it */
+  inline void SetFirstPageId(page_id_t page_id) { root_page_id_ = page_id; }
+
   inline Schema *GetSchema() const { return schema_; }
 
+  /** @return true if the table was marked resident with ALTER TABLE ... CACHE */
+  inline bool IsCached() const { return cached_; }
+
+  inline void SetCached(bool cached) { cached_ = cached; }
+
  private:
   TableMetadata() = delete;
 
@@ -39,6 +47,7 @@ class TableMetadata {
   std::string table_name_;
   page_id_t root_page_id_;
   Schema *schema_;
+  bool cached_{false};
 };
 
 /**
@@ -70,6 +79,16 @@ class TableInfo {
 
   inline page_id_t GetRootPageId() const { return table_meta_->root_page_id_; }
 
+  inline TableMetadata *GetTableMeta() const { return table_meta_; }
+
+  inline bool IsCached() const { return table_meta_->IsCached(); }
+
+  /** Mark the table resident in the buffer pool or not, see TableHeap::SetCached. */
+  void SetCached(bool cached) {
+    table_meta_->SetCached(cached);
+    table_heap_->SetCached(cached);
+  }
+
  private:
   explicit TableInfo() : heap_(new SimpleMemHeap()){};
 
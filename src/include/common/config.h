@@ -8,13 +8,48 @@ static constexpr int INVALID_PAGE_ID = -1;           // invalid page id
 static constexpr int INVALID_FRAME_ID = -1;          // invalid transaction id
 static constexpr int INVALID_TXN_ID = -1;            // invalid transaction id
 static constexpr int INVALID_LSN = -1;               // invalid log sequence number
+static constexpr uint32_t INVALID_PAGE_OWNER = 0;    // page I/O not charged to a table or index
 
 static constexpr int META_PAGE_ID = 0;               // physical page id of the disk file meta info
 static constexpr int CATALOG_META_PAGE_ID = 0;       // logical page id of the catalog meta data
 static constexpr int INDEX_ROOTS_PAGE_ID = 1;        // logical page id of the index roots
 
-static constexpr int PAGE_SIZE = 4096;               // size of a data page in byte
+// set by the MINISQL_PAGE_SIZE CMake option
+#ifndef MINISQL_PAGE_SIZE
+#define MINISQL_PAGE_SIZE 4096
+#endif
+static constexpr int PAGE_SIZE = MINISQL_PAGE_SIZE;  // size of a data page in byte
+// the physical page ids of a group of extents and its directory page have to fit in a page_id_t, see DiskManager
+static_assert(PAGE_SIZE >= 4096 && PAGE_SIZE <= 32768 && (PAGE_SIZE & (PAGE_SIZE - 1)) == 0,
+              "PAGE_SIZE must be 4096, 8192, 16384 or 32768.");
 static constexpr int DEFAULT_BUFFER_POOL_SIZE = 1024;// default size of buffer pool
+static constexpr int BUFFER_POOL_MAX_SIZE = (1 << 30) / PAGE_SIZE * 4;  // frames a pool instance can grow to, 4 GB
+static constexpr int RESIZE_PIN_TIMEOUT_MS = 1000;  // how long shrinking a pool waits for its pinned pages
+static constexpr int LRUK_REPLACER_K = 2;            // default k of the lru-k replacement policy
+static constexpr double CACHED_PAGES_MAX_FRACTION = 0.8;  // frames pages of CACHE tables may take before losing priority
+static constexpr double PAGE_CLEANER_CLEAN_FRACTION = 0.25;  // fraction of evictable frames the page cleaner keeps clean
+static constexpr int PAGE_CLEANER_INTERVAL_MS = 10;  // how often the page cleaner wakes up without demand
+static constexpr size_t PAGE_CLEANER_WRITE_BATCH = 32;  // pages the page cleaner writes with one batch
+static constexpr bool PAGE_CLEANER_ENABLED = true;  // DBStorageEngine runs the page cleaner of a writable database
+static constexpr int READ_AHEAD_WINDOW = 0;          // pages read ahead of a scan along its page chain, 0 = off
+static constexpr int READ_AHEAD_TRIGGER = 2;         // pages a scan moves through before read-ahead starts
+static constexpr size_t PREFETCH_BATCH_PAGES = 64;   // pages the prefetch thread reads with one batch
+static constexpr bool BUFFER_POOL_HUGE_PAGES = true; // back buffer pool frames with transparent huge pages
+static constexpr size_t FRAME_ARENA_HUGE_PAGE_SIZE = 2 << 20;  // alignment of a frame arena that uses huge pages
+static constexpr size_t COMPRESSED_CACHE_SIZE = 0;   // bytes of compressed evicted pages a pool keeps, 0 disables
+static constexpr double COMPRESSED_CACHE_MAX_RATIO = 0.75;  // pages that compress worse are not cached
+static constexpr bool DISK_MANAGER_DIRECT_IO = false;  // bypass the OS page cache with O_DIRECT, see DiskManager
+static constexpr size_t DISK_IO_ALIGNMENT = 4096;     // alignment of O_DIRECT buffers, offsets and lengths
+static constexpr bool DISK_MANAGER_PAGE_RUNS = true;   // allocate the pages of an object together, see AllocatePageNear
+static constexpr int64_t DISK_SEGMENT_SIZE = 1 << 30;  // bytes of a segment file of a database, 0 for one file
+static constexpr bool DISK_MANAGER_PUNCH_HOLES = true;  // give the disk blocks of deallocated pages back at Sync
+static constexpr bool ASYNC_IO_USE_IO_URING = true;   // batched page I/O through io_uring where the kernel has it
+static constexpr size_t ASYNC_IO_QUEUE_DEPTH = 64;    // requests of a batch in flight at most
+static constexpr size_t ASYNC_IO_THREADS = 4;         // threads issuing batched I/O without io_uring
+static constexpr size_t SHARED_BUFFER_POOL_SIZE = 4096;  // frames shared by the buffer pools of all open databases
+static constexpr size_t SHARED_BUFFER_POOL_MIN_FRAMES = 16;  // default minimum frame quota of a database
+static constexpr int SHARED_BUFFER_POOL_INTERVAL_MS = 100;  // how often the frame quotas follow the load
+static constexpr double SHARED_BUFFER_POOL_LOAD_WEIGHT = 0.5;  // weight of the last interval in the load average
 
 static constexpr uint32_t FIELD_NULL_LEN = UINT32_MAX;
 static constexpr uint32_t VARCHAR_MAX_LEN = PAGE_SIZE / 2;    // max length of varchar
@@ -28,5 +63,6 @@ using lsn_t = int32_t;
 using column_id_t = uint32_t;
 using index_id_t = uint32_t;
 using table_id_t = uint32_t;
+using page_owner_t = uint32_t;
 
 #endif  // MINISQL_CONFIG_H
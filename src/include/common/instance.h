@@ -1,10 +1,16 @@
 #ifndef MINISQL_INSTANCE_H
 #define MINISQL_INSTANCE_H
 
+#include <algorithm>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "buffer/buffer_pool_manager.h"
+#include "buffer/buffer_pool_manager_instance.h"
+#include "buffer/mapped_buffer_pool_manager.h"
+#include "buffer/parallel_buffer_pool_manager.h"
+#include "buffer/shared_buffer_pool.h"
 #include "catalog/catalog.h"
 #include "common/config.h"
 #include "common/dberr.h"
@@ -12,15 +18,46 @@
 
 class DBStorageEngine {
  public:
-  explicit DBStorageEngine(std::string db_name, bool init = true, uint32_t buffer_pool_size = DEFAULT_BUFFER_POOL_SIZE)
-      : db_file_name_(std::move(db_name)), init_(init) {
+  /**
+   * Open a database. With a shared pool the buffer pool is sized to the whole budget of the shared pool and only
+   * fills the frames of its quota, buffer_pool_size is ignored then.
+   *
+   * A read-only database maps the existing file and has no buffer pool of its own, see MappedBufferPoolManager. Every
+   * write to it is rejected, and the pool settings and the shared pool are ignored.
+   *
+   * A writable database runs the page cleaner of its buffer pool while it is open, see PAGE_CLEANER_ENABLED.
+   */
+  explicit DBStorageEngine(std::string db_name, bool init = true, uint32_t buffer_pool_size = DEFAULT_BUFFER_POOL_SIZE,
+                           ReplacerType replacer_type = ReplacerType::kLRU, uint32_t num_instances = 1,
+                           SharedBufferPool *shared_pool = nullptr, bool read_only = false)
+      : db_file_name_(std::move(db_name)),
+        init_(init),
+        shared_pool_(read_only ? nullptr : shared_pool),
+        read_only_(read_only) {
+    ASSERT(!(init_ && read_only_), "A read-only database cannot be initialized.");
     // Init database file if needed
     if (init_) {
       remove(db_file_name_.c_str());
+      remove(GetWarmupFileName().c_str());
     }
     // Initialize components
-    disk_mgr_ = new DiskManager(db_file_name_);
-    bpm_ = new BufferPoolManager(buffer_pool_size, disk_mgr_);
+    disk_mgr_ = new DiskManager(db_file_name_, DISK_MANAGER_DIRECT_IO, read_only_);
+    if (shared_pool_ != nullptr) {
+      buffer_pool_size = shared_pool_->GetPoolSize();
+    }
+    if (read_only_) {
+      bpm_ = new MappedBufferPoolManager(disk_mgr_);
+    } else if (num_instances > 1) {
+      bpm_ = new ParallelBufferPoolManager(num_instances, buffer_pool_size / num_instances, disk_mgr_, replacer_type);
+    } else {
+      bpm_ = new BufferPoolManagerInstance(buffer_pool_size, disk_mgr_, replacer_type);
+    }
+    if (shared_pool_ != nullptr) {
+      shared_pool_->Register(bpm_);
+    }
+    if (!init_ && !read_only_) {
+      WarmUp();
+    }
     catalog_mgr_ = new CatalogManager(bpm_, nullptr, nullptr, init);
     // Allocate static page for db storage engine
     if (init) {
@@ -35,20 +72,70 @@ class DBStorageEngine {
       ASSERT(!bpm_->IsPageFree(CATALOG_META_PAGE_ID), "Invalid catalog meta page.");
       ASSERT(!bpm_->IsPageFree(INDEX_ROOTS_PAGE_ID), "Invalid header page.");
     }
+    if (PAGE_CLEANER_ENABLED && !read_only_) {
+      bpm_->StartPageCleaner();
+    }
   }
 
   ~DBStorageEngine() {
+    if (!read_only_) {
+      bpm_->StopPageCleaner();
+      bpm_->SaveResidentPages(GetWarmupFileName());
+    }
     delete catalog_mgr_;
+    if (shared_pool_ != nullptr) {
+      shared_pool_->Unregister(bpm_);
+    }
     delete bpm_;
     delete disk_mgr_;
   }
 
+  /**
+   * Write every dirty page and the disk file metadata, and make the database file durable. Shutting down does the
+   * same when the buffer pool is deleted.
+   */
+  void Checkpoint() { bpm_->FlushAllPages(); }
+
+  /**
+   * Move the table pages into the lowest free pages, see CatalogManager::CompactTables, and checkpoint, which gives
+   * the blocks of the pages freed so far back. Then truncate the free pages at the end of the database file, see
+   * DiskManager::Shrink.
+   * @return bytes the database file shrank by
+   */
+  int64_t Shrink() {
+    if (!read_only_) {
+      catalog_mgr_->CompactTables();
+    }
+    Checkpoint();
+    return disk_mgr_->Shrink();
+  }
+
+ private:
+  /** @return the sidecar file holding the resident page set of the last clean shutdown */
+  std::string GetWarmupFileName() const { return db_file_name_ + ".warmup"; }
+
+  /**
+   * Prefetch the pages that were resident at the last clean shutdown, the hottest ones that fit into the quota, in
+   * physical page order. The reads are done by the prefetch thread of the buffer pool.
+   */
+  void WarmUp() {
+    std::vector<page_id_t> page_ids = BufferPoolManager::LoadResidentPages(GetWarmupFileName());
+    page_ids.resize(std::min(page_ids.size(), bpm_->GetStats().frame_quota_));
+    // logical page ids map to physical pages in the same order
+    std::sort(page_ids.begin(), page_ids.end());
+    if (!page_ids.empty()) {
+      bpm_->PrefetchPages(page_ids);
+    }
+  }
+
  public:
   DiskManager *disk_mgr_;
   BufferPoolManager *bpm_;
   CatalogManager *catalog_mgr_;
   std::string db_file_name_;
   bool init_;
+  SharedBufferPool *shared_pool_;  // frame budget shared with the other databases, nullptr if the pool has its own
+  bool read_only_;                 // the file is mapped and never written
 };
 
 #endif  // MINISQL_INSTANCE_H
@@ -82,7 +82,18 @@ private:
 
   dberr_t ExecuteQuit(pSyntaxNode ast, ExecuteContext *context);
 
+  dberr_t ExecuteShowBufferStatus(pSyntaxNode ast, ExecuteContext *context);
+
+  dberr_t ExecuteSetVariable(pSyntaxNode ast, ExecuteContext *context);
+
+  dberr_t ExecuteAlterTableCache(pSyntaxNode ast, ExecuteContext *context);
+
+  dberr_t ExecuteShrinkDatabase(pSyntaxNode ast, ExecuteContext *context);
+
+  dberr_t ExecuteShowIOStatus(pSyntaxNode ast, ExecuteContext *context);
+
 private:
+  SharedBufferPool shared_pool_{SHARED_BUFFER_POOL_SIZE};  /** frame budget of all opened databases */
   [[maybe_unused]] std::unordered_map<std::string, DBStorageEngine *> dbs_;  /** all opened databases */
   [[maybe_unused]] std::string current_db_;  /** current database */
 };
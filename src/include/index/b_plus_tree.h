@@ -1,6 +1,7 @@
 #ifndef MINISQL_B_PLUS_TREE_H
 #define MINISQL_B_PLUS_TREE_H
 
+#include <fstream>
 #include <queue>
 #include <string>
 #include <vector>
@@ -59,13 +60,22 @@ public:
   // destroy the b plus tree
   void Destroy();
 
+  // reject a write to a tree of a read-only database, see BufferPoolManager::RejectWrite
+  bool RejectWrite(const char *operation) { return buffer_pool_manager_->RejectWrite(operation); }
+
+  // give the pages of the tree a residency hint, pages allocated later get it as well
+  void SetCached(bool cached);
+
+  // charge the page I/O of the tree, and of its iterators, to an owner tag, see PageOwnerScope
+  void SetOwner(page_owner_t owner) { owner_ = owner; }
+
   void PrintTree(std::ofstream &out) {
     if (IsEmpty()) {
       return;
     }
     out << "digraph G {" << std::endl;
     Page *root_page = buffer_pool_manager_->FetchPage(root_page_id_);
-    BPlusTreePage *node = reinterpret_cast<BPlusTreePage *>(root_page);
+    BPlusTreePage *node = reinterpret_cast<BPlusTreePage *>(root_page->GetData());
     ToGraph(node, buffer_pool_manager_, out);
     out << "}" << std::endl;
   }
@@ -95,6 +105,12 @@ private:
 
   void UpdateRootPageId(int insert_record = 0);
 
+  // append the ids of the pages of the subtree rooted at page_id
+  void CollectPageIds(page_id_t page_id, std::vector<page_id_t> *page_ids);
+
+  // give a page the tree has just allocated the residency hint of the tree
+  void HintNewPage(page_id_t page_id);
+
   /* Debug Routines for FREE!! */
   void ToGraph(BPlusTreePage *page, BufferPoolManager *bpm, std::ofstream &out) const;
 
@@ -107,6 +123,8 @@ private:
   KeyComparator comparator_;
   int leaf_max_size_;
   int internal_max_size_;
+  bool cached_{false};
+  page_owner_t owner_{INVALID_PAGE_OWNER};
 };
 
 #endif  // MINISQL_B_PLUS_TREE_H
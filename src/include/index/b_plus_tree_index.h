@@ -19,6 +19,10 @@ public:
 
   dberr_t Destroy() override;
 
+  void SetCached(bool cached) override;
+
+  void SetOwner(page_owner_t owner) override;
+
   INDEXITERATOR_TYPE GetBeginIterator();
 
   INDEXITERATOR_TYPE GetBeginIterator(const KeyType &key);
@@ -22,6 +22,19 @@ public:
 
   virtual dberr_t Destroy() = 0;
 
+  /**
+   * Give the pages of the index a residency hint in the buffer pool, see BufferPoolManager::SetResidencyHint. Pages
+   * the index allocates later get the hint as well.
+   * @param cached true to keep the index resident, false to make its pages ordinary again
+   */
+  virtual void SetCached(bool cached) = 0;
+
+  /**
+   * Charge the page I/O of the index to an owner tag, see PageOwnerScope.
+   * @param owner the tag, INVALID_PAGE_OWNER to leave the I/O unattributed
+   */
+  virtual void SetOwner(page_owner_t owner) = 0;
+
 protected:
   index_id_t index_id_;
   IndexSchema *key_schema_;
@@ -1,6 +1,7 @@
 #ifndef MINISQL_INDEX_ITERATOR_H
 #define MINISQL_INDEX_ITERATOR_H
 
+#include "buffer/read_ahead.h"
 #include "page/b_plus_tree_leaf_page.h"
 
 #define INDEXITERATOR_TYPE IndexIterator<KeyType, ValueType, KeyComparator>
@@ -12,7 +13,7 @@ public:
   explicit IndexIterator();
 
   IndexIterator(BPlusTreeLeafPage<KeyType,ValueType,KeyComparator>* leaf_node,
-                int index_,BufferPoolManager* bufferPoolManager);
+                int index_,BufferPoolManager* bufferPoolManager,page_owner_t owner=INVALID_PAGE_OWNER);
 
   ~IndexIterator();
 
@@ -33,6 +34,8 @@ private:
   BPlusTreeLeafPage<KeyType,ValueType,KeyComparator>* leaf;
   int index;
   BufferPoolManager* buffer_pool_manager_;
+  ReadAhead read_ahead_;
+  page_owner_t owner_{INVALID_PAGE_OWNER};  // see PageOwnerScope
 };
 
 
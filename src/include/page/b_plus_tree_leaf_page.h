@@ -40,6 +40,11 @@ public:
   // helper methods
   page_id_t GetNextPageId() const;
 
+  /** Read the next page id out of the raw data of a leaf page, see BufferPoolManager::PrefetchChain. */
+  static page_id_t NextPageIdOf(const char *data) {
+    return reinterpret_cast<const BPlusTreeLeafPage *>(data)->GetNextPageId();
+  }
+
   void SetNextPageId(page_id_t next_page_id);
 
   KeyType KeyAt(int index) const;
@@ -6,6 +6,10 @@
 #include "common/config.h"
 #include "common/macros.h"
 
+/**
+ * BitmapPage records which pages of an extent are allocated, one bit per page. next_free_page_ is a search hint: every
+ * page below it is allocated. Pages written before the hint was kept have it at 0, which is always true.
+ */
 template <size_t PageSize>
 class BitmapPage {
  public:
@@ -14,12 +18,34 @@ class BitmapPage {
    */
   static constexpr size_t GetMaxSupportedSize() { return 8 * MAX_CHARS; }
 
+  /** Pages of a run, the pages recorded by one 64-bit word of the bitmap. */
+  static constexpr size_t RUN_PAGES = 64;
+
+  /** @return The number of whole runs of the extent. */
+  static constexpr size_t GetRunCount() { return MAX_CHARS / sizeof(uint64_t); }
+
   /**
+   * Allocate the first free page of the extent, searching 64 pages at a time from the hint.
    * @param page_offset Index in extent of the page allocated.
    * @return true if successfully allocate a page.
    */
   bool AllocatePage(uint32_t &page_offset);
 
+  /**
+   * Allocate the first free page at or after hint in the run holding hint, or else the first free page of that run.
+   * @param hint Index in extent of a page of the run.
+   * @param page_offset Index in extent of the page allocated.
+   * @return false if the run is full.
+   */
+  bool AllocatePageInRun(uint32_t hint, uint32_t &page_offset);
+
+  /**
+   * Allocate the first page of the first run without an allocated page, starting the search at run first_run.
+   * @param page_offset Index in extent of the page allocated.
+   * @return false if no run from first_run on is empty.
+   */
+  bool AllocateEmptyRun(uint32_t first_run, uint32_t &page_offset);
+
   /**
    * @return true if successfully de-allocate a page.
    */
@@ -30,6 +56,13 @@ class BitmapPage {
    */
   [[nodiscard]] bool IsPageFree(uint32_t page_offset) const;
 
+  /**
+   * Find the last allocated page of the extent, searching 64 pages at a time from the end.
+   * @param page_offset Index in extent of the last page allocated.
+   * @return false if every page of the extent is free.
+   */
+  bool FindLastAllocated(uint32_t &page_offset) const;
+
  private:
   /**
    * check a bit(byte_index, bit_index) in bytes is free(value 0).
@@ -40,13 +73,19 @@ class BitmapPage {
    */
   [[nodiscard]] bool IsPageFreeLow(uint32_t byte_index, uint8_t bit_index) const;
 
+  /**
+   * Allocate the first free page in [from, to).
+   * @return false if every page in the range is allocated.
+   */
+  bool AllocateFirstFree(uint32_t from, uint32_t to, uint32_t &page_offset);
+
   /** Note: need to update if modify page structure. */
   static constexpr size_t MAX_CHARS = PageSize - 2 * sizeof(uint32_t);
 
  private:
   /** The space occupied by all members of the class should be equal to the PageSize */
   [[maybe_unused]] uint32_t page_allocated_;
-  [[maybe_unused]] uint32_t next_free_page_;
+  [[maybe_unused]] uint32_t next_free_page_;  // every page below it is allocated
   [[maybe_unused]] unsigned char bytes[MAX_CHARS];
 };
 
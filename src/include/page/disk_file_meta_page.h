@@ -2,18 +2,36 @@
 #define MINISQL_DISK_FILE_META_PAGE_H
 
 #include <cstdint>
+#include <limits>
 
 #include "page/bitmap_page.h"
 
-// page_size我们在测试中是512byte，实际上是4096byte，即4kb
-static constexpr page_id_t MAX_VALID_PAGE_ID = (PAGE_SIZE - 8) / 4 * BitmapPage<PAGE_SIZE>::GetMaxSupportedSize();
+// extents counted by one directory page: the meta page, and every directory page chained after it
+static constexpr uint32_t EXTENTS_PER_DIRECTORY_PAGE = (PAGE_SIZE - 12) / 4;
 
+// page_size我们在测试中是512byte，实际上是4096byte，即4kb
+// an extent takes its bitmap page, its data pages and a share of a directory page, and the physical page ids of all
+// of them have to fit in a page_id_t
+static constexpr page_id_t MAX_VALID_PAGE_ID =
+    std::numeric_limits<page_id_t>::max() / (BitmapPage<PAGE_SIZE>::GetMaxSupportedSize() + 2) *
+    BitmapPage<PAGE_SIZE>::GetMaxSupportedSize();
+
+/**
+ * The meta page counts the allocated pages and extents of the whole file, and the used pages of the first
+ * EXTENTS_PER_DIRECTORY_PAGE extents. The used pages of the extents after them are counted by directory pages with
+ * the same layout, whose num_allocated_pages_, num_extents_ and page_size_ are unused.
+ *
+ * The meta page also records the PAGE_SIZE the file was created with. Its first fields are at the same offsets for
+ * every page size, so DiskManager can tell a file of another build apart and refuse to open it.
+ */
 class DiskFileMetaPage {
  public:
   uint32_t GetExtentNums() { return num_extents_; }
 
   uint32_t GetAllocatedPages() { return num_allocated_pages_; }
 
+  uint32_t GetPageSize() { return page_size_; }
+
   uint32_t GetExtentUsedPage(uint32_t extent_id) {
     if (extent_id >= num_extents_) {
       return 0;
@@ -27,6 +45,7 @@ class DiskFileMetaPage {
   // 每个拓展分区包含了一个位图页和32704个数据页
   // 32704 = (4096-4*2)*8
   uint32_t num_extents_{0};       // each extent consists with a bit map and BIT_MAP_SIZE pages
+  uint32_t page_size_{0};         // PAGE_SIZE the file was created with, 0 for a file without pages yet
   uint32_t extent_used_page_[0];  // 零长数组，相当于一个地址标识符
 };
 
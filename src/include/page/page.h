@@ -3,6 +3,7 @@
 
 #include <cstring>
 #include <iostream>
+#include <memory>
 #include <shared_mutex>
 
 #include "common/config.h"
@@ -12,16 +13,27 @@
  * Page is the basic unit of storage within the database system. Page provides a wrapper for actual data pages being
  * held in main memory. Page also contains book-keeping information that is used by the buffer pool manager, e.g.
  * pin count, dirty flag, page id, etc.
+ *
+ * A page of a buffer pool does not own its data or its book-keeping information, it points into the frame arena of
+ * the pool, see FrameArena. A page of a read-only database points into the mapping of the file, see
+ * MappedBufferPoolManager. A page constructed on its own owns both.
  */
 class Page {
   // There is book-keeping information inside the page that should only be relevant to the buffer pool manager.
-  friend class BufferPoolManager;
+  friend class BufferPoolManagerInstance;
+  friend class FrameArena;
+  friend class MappedBufferPoolManager;
 
 public:
   DISALLOW_COPY(Page)
 
-  /** Constructor. Zeros out the page data. */
-  Page() { ResetMemory(); }
+  /** Constructor of a stand-alone page. Zeros out the page data. */
+  Page()
+      : storage_(std::make_unique<Storage>()),
+        data_(storage_->data_),
+        page_id_(&storage_->page_id_),
+        pin_count_(&storage_->pin_count_),
+        is_dirty_(&storage_->is_dirty_) {}
 
   /** Default destructor. */
   ~Page() = default;
@@ -30,13 +42,13 @@ public:
   inline char *GetData() { return data_; }
 
   /** @return the page id of this page */
-  inline page_id_t GetPageId() { return page_id_; }
+  inline page_id_t GetPageId() { return *page_id_; }
 
   /** @return the pin count of this page */
-  inline int GetPinCount() { return pin_count_; }
+  inline int GetPinCount() { return *pin_count_; }
 
   /** @return true if the page in memory has been modified from the page on disk, false otherwise */
-  inline bool IsDirty() { return is_dirty_; }
+  inline bool IsDirty() { return *is_dirty_; }
 
   /** Acquire the page write latch. */
   inline void WLatch() { rwlatch_.WLock(); }
@@ -65,17 +77,31 @@ protected:
   static constexpr size_t OFFSET_LSN = 4;
 
 private:
+  /** Data and book-keeping information of a stand-alone page. */
+  struct Storage {
+    char data_[PAGE_SIZE]{};
+    page_id_t page_id_{INVALID_PAGE_ID};
+    int pin_count_{0};
+    bool is_dirty_{false};
+  };
+
+  /** Constructor of a buffer pool page, bound to one frame of a FrameArena. */
+  Page(char *data, page_id_t *page_id, int *pin_count, bool *is_dirty)
+      : data_(data), page_id_(page_id), pin_count_(pin_count), is_dirty_(is_dirty) {}
+
   /** Zeroes out the data that is held within the page. */
   inline void ResetMemory() { memset(data_, OFFSET_PAGE_START, PAGE_SIZE); }
 
+  /** Storage of a stand-alone page, null for a buffer pool page. */
+  std::unique_ptr<Storage> storage_;
   /** The actual data that is stored within a page. */
-  char data_[PAGE_SIZE]{};
+  char *data_;
   /** The ID of this page. */
-  page_id_t page_id_ = INVALID_PAGE_ID;
+  page_id_t *page_id_;
   /** The pin count of this page. */
-  int pin_count_ = 0;
+  int *pin_count_;
   /** True if the page is dirty, i.e. it is different from its corresponding page on disk. */
-  bool is_dirty_ = false;
+  bool *is_dirty_;
   /** Page latch. */
   ReaderWriterLatch rwlatch_;
 };
@@ -7,6 +7,8 @@
   int yyerror(char* error);
 %}
 
+%define api.header.include {"parser/minisql_yacc.h"}
+
 %union {
 	pSyntaxNode syntax_node;
 }
@@ -17,6 +19,7 @@
 %token <syntax_node> ON FROM WHERE INTO SET VALUES PRIMARY KEY UNIQUE
 %token <syntax_node> CHAR INT FLOAT AND OR NOT IS FLAGNULL
 %token <syntax_node> IDENTIFIER STRING NUMBER EQ NE LE GE
+%token <syntax_node> BUFFER STATUS ALTER CACHE NOCACHE SHRINK IO
 
 %type <syntax_node> start sql
 %type <syntax_node> sql_create_database sql_drop_database sql_show_databases sql_use_database
@@ -28,6 +31,8 @@
 %type <syntax_node> connector where_conditions where_condition
 %type <syntax_node> sql_insert sql_delete sql_update update_values update_value
 %type <syntax_node> sql_quit sql_exec_file
+%type <syntax_node> sql_show_buffer_status sql_set_variable sql_alter_table_cache sql_shrink_database
+%type <syntax_node> sql_show_io_status any_identifier
 
 %%
 
@@ -58,17 +63,49 @@ sql:
   | sql_trx_rollback { $$ = $1; }
   | sql_quit { $$ = $1; }
   | sql_exec_file { $$ = $1; }
+  | sql_show_buffer_status { $$ = $1; }
+  | sql_set_variable { $$ = $1; }
+  | sql_alter_table_cache { $$ = $1; }
+  | sql_shrink_database { $$ = $1; }
+  | sql_show_io_status { $$ = $1; }
+  ;
+
+any_identifier:
+  IDENTIFIER {
+    $$ = $1;
+  }
+  | BUFFER {
+    $$ = CreateSyntaxNode(kNodeIdentifier, "buffer");
+  }
+  | STATUS {
+    $$ = CreateSyntaxNode(kNodeIdentifier, "status");
+  }
+  | ALTER {
+    $$ = CreateSyntaxNode(kNodeIdentifier, "alter");
+  }
+  | CACHE {
+    $$ = CreateSyntaxNode(kNodeIdentifier, "cache");
+  }
+  | NOCACHE {
+    $$ = CreateSyntaxNode(kNodeIdentifier, "nocache");
+  }
+  | SHRINK {
+    $$ = CreateSyntaxNode(kNodeIdentifier, "shrink");
+  }
+  | IO {
+    $$ = CreateSyntaxNode(kNodeIdentifier, "io");
+  }
   ;
 
 sql_create_database:
-  CREATE DATABASE IDENTIFIER {
+  CREATE DATABASE any_identifier {
     $$ = CreateSyntaxNode(kNodeCreateDB, NULL);
     SyntaxNodeAddChildren($$, $3);
   }
   ;
 
 sql_drop_database:
-  DROP DATABASE IDENTIFIER {
+  DROP DATABASE any_identifier {
     $$ = CreateSyntaxNode(kNodeDropDB, NULL);
     SyntaxNodeAddChildren($$, $3);
   }
@@ -81,7 +118,7 @@ sql_show_databases:
   ;
 
 sql_use_database:
-  USE IDENTIFIER {
+  USE any_identifier {
     $$ = CreateSyntaxNode(kNodeUseDB, NULL);
     SyntaxNodeAddChildren($$, $2);
   }
@@ -94,7 +131,7 @@ sql_show_tables:
   ;
 
 sql_create_table:
-  CREATE TABLE IDENTIFIER '(' column_definition_list ')' {
+  CREATE TABLE any_identifier '(' column_definition_list ')' {
     $$ = CreateSyntaxNode(kNodeCreateTable, NULL);
     pSyntaxNode list_node = CreateSyntaxNode(kNodeColumnDefinitionList, NULL);
     SyntaxNodeAddChildren(list_node, $5);
@@ -104,11 +141,11 @@ sql_create_table:
   ;
 
 column_list:
-  IDENTIFIER ',' column_list {
+  any_identifier ',' column_list {
     $$ = $1;
     SyntaxNodeAddSibling($$, $3);
   }
-  | IDENTIFIER {
+  | any_identifier {
     $$ = $1;
   }
   ;
@@ -128,12 +165,12 @@ column_definition_list:
   ;
 
 column_definition:
-  IDENTIFIER column_type UNIQUE {
+  any_identifier column_type UNIQUE {
     $$ = CreateSyntaxNode(kNodeColumnDefinition, "unique");
     SyntaxNodeAddChildren($$, $1);
     SyntaxNodeAddChildren($$, $2);
   }
-  | IDENTIFIER column_type {
+  | any_identifier column_type {
     $$ = CreateSyntaxNode(kNodeColumnDefinition, NULL);
     SyntaxNodeAddChildren($$, $1);
     SyntaxNodeAddChildren($$, $2);
@@ -154,14 +191,14 @@ column_type:
   ;
 
 sql_drop_table:
-  DROP TABLE IDENTIFIER {
+  DROP TABLE any_identifier {
     $$ = CreateSyntaxNode(kNodeDropTable, NULL);
     SyntaxNodeAddChildren($$, $3);
   }
   ;
 
 sql_create_index:
-  CREATE INDEX IDENTIFIER ON IDENTIFIER '(' column_list ')' {
+  CREATE INDEX any_identifier ON any_identifier '(' column_list ')' {
     $$ = CreateSyntaxNode(kNodeCreateIndex, NULL);
     SyntaxNodeAddChildren($$, $3);
     SyntaxNodeAddChildren($$, $5);
@@ -169,7 +206,7 @@ sql_create_index:
     SyntaxNodeAddChildren(index_keys_node, $7);
     SyntaxNodeAddChildren($$, index_keys_node);
   }
-  | CREATE INDEX IDENTIFIER ON IDENTIFIER '(' column_list ')' USING IDENTIFIER {
+  | CREATE INDEX any_identifier ON any_identifier '(' column_list ')' USING IDENTIFIER {
       $$ = CreateSyntaxNode(kNodeCreateIndex, NULL);
       SyntaxNodeAddChildren($$, $3);
       SyntaxNodeAddChildren($$, $5);
@@ -183,7 +220,7 @@ sql_create_index:
   ;
 
 sql_drop_index:
-  DROP INDEX IDENTIFIER {
+  DROP INDEX any_identifier {
     $$ = CreateSyntaxNode(kNodeDropIndex, NULL);
     SyntaxNodeAddChildren($$, $3);
   }
@@ -196,12 +233,12 @@ sql_show_indexes:
   ;
 
 sql_select:
-  SELECT select_columns FROM IDENTIFIER {
+  SELECT select_columns FROM any_identifier {
     $$ = CreateSyntaxNode(kNodeSelect, NULL);
     SyntaxNodeAddChildren($$, $2);
     SyntaxNodeAddChildren($$, $4);
   }
-  | SELECT select_columns FROM IDENTIFIER WHERE where_conditions {
+  | SELECT select_columns FROM any_identifier WHERE where_conditions {
     $$ = CreateSyntaxNode(kNodeSelect, NULL);
     SyntaxNodeAddChildren($$, $2);
     SyntaxNodeAddChildren($$, $4);
@@ -242,7 +279,7 @@ connector:
   ;
 
 where_condition:
-  IDENTIFIER operator column_value {
+  any_identifier operator column_value {
     $$ = $2;
     SyntaxNodeAddChildren($$, $1);
     SyntaxNodeAddChildren($$, $3);
@@ -289,7 +326,7 @@ operator:
   ;
 
 sql_insert:
-  INSERT INTO IDENTIFIER VALUES '(' column_values ')' {
+  INSERT INTO any_identifier VALUES '(' column_values ')' {
     $$ = CreateSyntaxNode(kNodeInsert, NULL);
     SyntaxNodeAddChildren($$, $3);
     pSyntaxNode col_val_node = CreateSyntaxNode(kNodeColumnValues, NULL);
@@ -309,11 +346,11 @@ column_values:
   ;
 
 sql_delete:
-  DELETE FROM IDENTIFIER {
+  DELETE FROM any_identifier {
     $$ = CreateSyntaxNode(kNodeDelete, NULL);
     SyntaxNodeAddChildren($$, $3);
   }
-  | DELETE FROM IDENTIFIER WHERE where_conditions {
+  | DELETE FROM any_identifier WHERE where_conditions {
     $$ = CreateSyntaxNode(kNodeDelete, NULL);
     SyntaxNodeAddChildren($$, $3);
     pSyntaxNode condition_node = CreateSyntaxNode(kNodeConditions, NULL);
@@ -323,14 +360,14 @@ sql_delete:
   ;
 
 sql_update:
-  UPDATE IDENTIFIER SET update_values {
+  UPDATE any_identifier SET update_values {
     $$ = CreateSyntaxNode(kNodeUpdate, NULL);
     SyntaxNodeAddChildren($$, $2);
     pSyntaxNode upd_values_node = CreateSyntaxNode(kNodeUpdateValues, NULL);
     SyntaxNodeAddChildren(upd_values_node, $4);
     SyntaxNodeAddChildren($$, upd_values_node);
   }
-  | UPDATE IDENTIFIER SET update_values WHERE where_conditions {
+  | UPDATE any_identifier SET update_values WHERE where_conditions {
     $$ = CreateSyntaxNode(kNodeUpdate, NULL);
     SyntaxNodeAddChildren($$, $2);
     // update values
@@ -355,7 +392,7 @@ update_values:
   ;
 
 update_value:
-  IDENTIFIER EQ column_value {
+  any_identifier EQ column_value {
     $$ = CreateSyntaxNode(kNodeUpdateValue, NULL);
     SyntaxNodeAddChildren($$, $1);
     SyntaxNodeAddChildren($$, $3);
@@ -393,6 +430,57 @@ sql_exec_file:
   }
   ;
 
+sql_show_buffer_status:
+  SHOW BUFFER STATUS {
+    $$ = CreateSyntaxNode(kNodeShowBufferStatus, NULL);
+  }
+  ;
+
+sql_set_variable:
+  SET IDENTIFIER EQ NUMBER {
+    $$ = CreateSyntaxNode(kNodeSetVariable, NULL);
+    SyntaxNodeAddChildren($$, $2);
+    SyntaxNodeAddChildren($$, $4);
+  }
+  ;
+
+sql_alter_table_cache:
+  ALTER TABLE any_identifier CACHE {
+    $$ = CreateSyntaxNode(kNodeAlterTableCache, "cache");
+    SyntaxNodeAddChildren($$, $3);
+  }
+  | ALTER TABLE any_identifier NOCACHE {
+    $$ = CreateSyntaxNode(kNodeAlterTableCache, "nocache");
+    SyntaxNodeAddChildren($$, $3);
+  }
+  | ALTER TABLE any_identifier INDEXES CACHE {
+    $$ = CreateSyntaxNode(kNodeAlterTableCache, "cache");
+    SyntaxNodeAddChildren($$, $3);
+    SyntaxNodeAddChildren($$, CreateSyntaxNode(kNodeIdentifier, "indexes"));
+  }
+  | ALTER TABLE any_identifier INDEXES NOCACHE {
+    $$ = CreateSyntaxNode(kNodeAlterTableCache, "nocache");
+    SyntaxNodeAddChildren($$, $3);
+    SyntaxNodeAddChildren($$, CreateSyntaxNode(kNodeIdentifier, "indexes"));
+  }
+  ;
+
+sql_shrink_database:
+  SHRINK DATABASE {
+    $$ = CreateSyntaxNode(kNodeShrinkDB, NULL);
+  }
+  ;
+
+sql_show_io_status:
+  SHOW IO STATUS {
+    $$ = CreateSyntaxNode(kNodeShowIOStatus, NULL);
+  }
+  | SHOW IO STATUS INTO STRING {
+    $$ = CreateSyntaxNode(kNodeShowIOStatus, NULL);
+    SyntaxNodeAddChildren($$, $5);
+  }
+  ;
+
 %%
 int yyerror(char* error) {
 	MinisqlParserSetError(error);
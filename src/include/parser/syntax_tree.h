@@ -43,7 +43,12 @@ typedef enum {
   kNodeIndexType, /** type of index */
   kNodeTrxBegin, /** begin transaction command */
   kNodeTrxCommit, /** commit transaction command */
-  kNodeTrxRollback /** rollback transaction command */
+  kNodeTrxRollback, /** rollback transaction command */
+  kNodeShowBufferStatus, /** show buffer status command */
+  kNodeSetVariable, /** set variable command, contains the variable identifier and its value */
+  kNodeAlterTableCache, /** alter table cache command, "cache" or "nocache", contains the table and maybe "indexes" */
+  kNodeShrinkDB, /** shrink database command */
+  kNodeShowIOStatus /** show io status command, contains the file to write the status to as JSON, if any */
 } SyntaxNodeType;
 
 /**
@@ -0,0 +1,112 @@
+#ifndef MINISQL_ASYNC_IO_H
+#define MINISQL_ASYNC_IO_H
+
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "common/config.h"
+#include "common/macros.h"
+
+/**
+ * One vectored read or write of a batch submitted to AsyncIO.
+ */
+struct AsyncIORequest {
+  bool write_{false};        // pwritev instead of preadv
+  int fd_{-1};               // file descriptor, -1 for the one of the AsyncIO
+  off_t offset_{0};          // file offset of the first buffer
+  const iovec *iov_{nullptr};
+  int iov_count_{0};
+  ssize_t result_{0};        // bytes transferred, or -errno, set when the request completes
+};
+
+/**
+ * AsyncIO runs batches of reads and writes with many requests in flight, so that a device with a deep queue serves
+ * them in parallel instead of one blocking 4 KB read at a time. A request goes to the file descriptor of the AsyncIO
+ * unless it names another one, so one batch can span the segment files of a database.
+ *
+ * On Linux the requests go through an io_uring: a batch is submitted with one io_uring_enter, and more requests are
+ * submitted as completions free up room in the ring. Where io_uring is unavailable, because the kernel is too old
+ * or a sandbox forbids it, a small pool of threads issues preadv and pwritev instead.
+ *
+ * Run returns once the whole batch has completed, but hands every completion to its callback as it arrives, on the
+ * calling thread. The ring has a single submitter, so concurrent Run calls take turns, the thread pool serves them
+ * side by side.
+ */
+class AsyncIO {
+public:
+  DISALLOW_COPY_AND_MOVE(AsyncIO)
+
+  /**
+   * @param fd the default file descriptor of the requests, owned by the caller
+   * @param queue_depth requests in flight at most
+   * @param use_io_uring false to always use the thread pool
+   */
+  explicit AsyncIO(int fd, size_t queue_depth = ASYNC_IO_QUEUE_DEPTH, bool use_io_uring = ASYNC_IO_USE_IO_URING);
+
+  ~AsyncIO();
+
+  /**
+   * Run a batch of requests and wait for all of them.
+   * @param requests the requests, result_ is set for each of them
+   * @param on_complete called with the index of every request as it completes, may be empty
+   */
+  void Run(std::vector<AsyncIORequest> &requests, const std::function<void(size_t)> &on_complete = {});
+
+  /** @return true if the requests go through an io_uring, false if through the thread pool */
+  bool UsesIOUring() const { return ring_fd_ >= 0; }
+
+private:
+  /** Completions of one Run call on the thread pool. */
+  struct Batch {
+    std::mutex latch_;
+    std::condition_variable cv_;
+    AsyncIORequest *first_;    // first request of the batch
+    std::deque<size_t> done_;  // indexes of the completed requests not handed to the callback yet
+  };
+
+  /** Set up the io_uring. @return false if the kernel does not offer one */
+  bool SetupRing();
+
+  void RunRing(std::vector<AsyncIORequest> &requests, const std::function<void(size_t)> &on_complete);
+
+  void RunThreads(std::vector<AsyncIORequest> &requests, const std::function<void(size_t)> &on_complete);
+
+  /** Main loop of a thread of the pool. */
+  void RunWorker();
+
+  int fd_;
+  size_t queue_depth_;
+
+  // io_uring, ring_fd_ is -1 without one
+  int ring_fd_{-1};
+  std::mutex ring_latch_;  // one submitter at a time
+  void *sq_ring_{nullptr};
+  size_t sq_ring_size_{0};
+  void *cq_ring_{nullptr};
+  size_t cq_ring_size_{0};
+  void *sqes_{nullptr};
+  size_t sqes_size_{0};
+  unsigned *sq_tail_{nullptr};
+  unsigned *sq_mask_{nullptr};
+  unsigned *sq_array_{nullptr};
+  unsigned *cq_head_{nullptr};
+  unsigned *cq_tail_{nullptr};
+  unsigned *cq_mask_{nullptr};
+  void *cqes_{nullptr};
+  unsigned ring_entries_{0};
+
+  // thread pool, started on the first Run without an io_uring
+  std::mutex pool_latch_;
+  std::condition_variable pool_cv_;
+  std::deque<std::pair<Batch *, AsyncIORequest *>> pool_queue_;  // requests waiting for a thread, with their batch
+  std::vector<std::thread> workers_;
+  bool pool_running_{false};  // protected by pool_latch_
+};
+
+#endif  // MINISQL_ASYNC_IO_H
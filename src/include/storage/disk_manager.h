@@ -1,27 +1,151 @@
 #ifndef DISK_MGR_H
 #define DISK_MGR_H
 
+#include <sys/uio.h>
+#include <algorithm>
+#include <array>
 #include <atomic>
-#include <fstream>
+#include <chrono>
+#include <cmath>
+#include <functional>
 #include <iostream>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <utility>
+#include <vector>
 #include "common/config.h"
 #include "common/macros.h"
 #include "page/bitmap_page.h"
 #include "page/disk_file_meta_page.h"
+#include "storage/async_io.h"
+
+/**
+ * Latency histogram with log2 buckets: bucket 0 counts operations that took less than a nanosecond, bucket b the ones
+ * that took [2^(b-1), 2^b) nanoseconds, and the last bucket everything slower.
+ */
+struct LatencyHistogram {
+  static constexpr size_t BUCKETS = 40;  // the last bucket starts at 2^38 ns, about 4.6 minutes
+
+  std::array<uint64_t, BUCKETS> buckets_{};
+
+  /** @return the bucket of a latency */
+  static size_t Bucket(uint64_t nanoseconds) {
+    size_t bucket = 0;
+    while (nanoseconds != 0 && bucket < BUCKETS - 1) {
+      nanoseconds >>= 1;
+      bucket++;
+    }
+    return bucket;
+  }
+
+  /** @return the number of operations */
+  uint64_t Count() const {
+    uint64_t count = 0;
+    for (auto bucket : buckets_) {
+      count += bucket;
+    }
+    return count;
+  }
+
+  /**
+   * @param fraction the fraction of operations that are at least as fast, such as 0.99
+   * @return the upper bound in nanoseconds of the bucket holding the percentile, by nearest rank, 0 if there were no
+   * operations
+   */
+  uint64_t Percentile(double fraction) const {
+    uint64_t count = Count();
+    if (count == 0) {
+      return 0;
+    }
+    // 0 based index of the operation at the percentile
+    auto rank = static_cast<uint64_t>(std::ceil(fraction * static_cast<double>(count)));
+    rank = std::min(std::max<uint64_t>(rank, 1), count) - 1;
+    uint64_t seen = 0;
+    size_t bucket = 0;
+    for (; bucket < BUCKETS - 1; bucket++) {
+      seen += buckets_[bucket];
+      if (seen > rank) {
+        break;
+      }
+    }
+    return uint64_t{1} << bucket;
+  }
+
+  LatencyHistogram &operator+=(const LatencyHistogram &other) {
+    for (size_t bucket = 0; bucket < BUCKETS; bucket++) {
+      buckets_[bucket] += other.buckets_[bucket];
+    }
+    return *this;
+  }
+};
+
+/**
+ * Snapshot of the physical I/O of a DiskManager, see DiskManager::GetIOStats. A read or write is one system call, or
+ * one request of a batch, so a vectored write of a run of pages counts once with the bytes of all of them. Reads past
+ * the end of the file and copies out of the read-only mapping touch no disk and are not counted. The counters are
+ * cumulative since the file was opened.
+ */
+struct DiskIOStats {
+  uint64_t reads_{0};               // read operations
+  uint64_t read_bytes_{0};          // bytes read
+  uint64_t writes_{0};              // write operations
+  uint64_t written_bytes_{0};       // bytes written
+  LatencyHistogram read_latency_;   // latency of every read operation
+  LatencyHistogram write_latency_;  // latency of every write operation
+};
 
 /**
  * DiskManager takes care of the allocation and de allocation of pages within a database. It performs the reading and
  * writing of pages to and from disk, providing a logical file layer within the context of a database management system.
  *
+ * Pages are read and written with pread and pwrite, so concurrent page I/O shares no seek position and takes no lock,
+ * only allocation does. Writes are not flushed one by one, durability is up to Sync. The file size is tracked in
+ * memory, a read past the end of the file returns a zeroed page without a syscall.
+ *
+ * The database is split into segment files of a fixed size, db_file holds the first segment and db_file.1, db_file.2
+ * and so on the ones after it. Offsets are 64 bits wide, a page never spans two segments, and a segment is created,
+ * with every segment before it, on the first write to it. A db_file larger than a segment was written as one file
+ * and is kept that way.
+ *
+ * In direct I/O mode the file is opened with O_DIRECT, so that pages are only cached by the buffer pool and not a
+ * second time by the OS page cache. The frames of the buffer pool are page aligned and go to the file as they are,
+ * other buffers are bounced through an aligned copy. Where the filesystem rejects O_DIRECT, such as tmpfs, the disk
+ * manager falls back to buffered I/O, see IsDirectIO.
+ *
+ * The bitmap pages of the extents are read once and kept in memory, allocation searches them there. Like the meta
+ * page, they are written back by Sync.
+ *
+ * A deallocated page gives its disk blocks back to the filesystem: Sync punches a hole over every run of pages freed
+ * since the last Sync and still free, after the bitmaps recording them are durable. Shrink truncates the free pages at
+ * the end of the database.
+ *
+ * Every physical read and write is counted and timed into a latency histogram, see GetIOStats.
+ *
+ * In read-only mode the file is mapped into memory instead, so that MappedBufferPoolManager can hand out pages that
+ * point into the mapping, and every process that opens the file shares one copy of it in the OS page cache. Writes,
+ * allocation and deallocation are rejected in this mode.
+ *
  * Disk page storage format: (Free Page BitMap Size = PAGE_SIZE * 8, we note it as N)
  * | Meta Page | Free Page BitMap 1 | Page 1 | Page 2 | ....
  *      | Page N | Free Page BitMap 2 | Page N+1 | ... | Page 2N | ... |
+ *
+ * The meta page counts the used pages of the first EXTENTS_PER_DIRECTORY_PAGE extents. Every further group of as many
+ * extents starts with a directory page that counts theirs, so the directory is a chain of pages at fixed places:
+ *      | Page M*N | Directory Page 1 | Free Page BitMap M+1 | Page M*N+1 | ...
  */
 class DiskManager {
  public:
-  explicit DiskManager(const std::string &db_file);
+  /**
+   * Open a database file, creating it if it does not exist. A read-only file has to exist.
+   * @param db_file the database file
+   * @param direct_io true to bypass the OS page cache with O_DIRECT where the filesystem supports it
+   * @param read_only true to map an existing file read-only, see GetMappedPage, direct_io is ignored then
+   * @param segment_size bytes of a segment file, a multiple of PAGE_SIZE, 0 to keep the database in one file
+   * @throws std::runtime_error if the file was created with another PAGE_SIZE, see DiskFileMetaPage
+   */
+  explicit DiskManager(const std::string &db_file, bool direct_io = DISK_MANAGER_DIRECT_IO, bool read_only = false,
+                       int64_t segment_size = DISK_SEGMENT_SIZE);
 
   ~DiskManager() {
     if (!closed) {
@@ -41,6 +165,27 @@ class DiskManager {
    */
   void WritePage(page_id_t logical_page_id, const char *page_data);
 
+  /**
+   * Write a batch of pages. Every run of physically contiguous pages is one vectored write, and the runs are
+   * submitted together to the asynchronous I/O engine, see AsyncIO. Does not sync, see Sync.
+   * @param pages logical page ids with the data to write for them, reordered by the call
+   */
+  void WritePages(std::vector<std::pair<page_id_t, const char *>> &pages);
+
+  /**
+   * Read a batch of pages with one submission to the asynchronous I/O engine, see AsyncIO, instead of one blocking
+   * read after the other.
+   * @param pages logical page ids with a buffer of PAGE_SIZE bytes for each
+   * @param on_read called with the index of every page as its read completes, on the calling thread, may be empty
+   */
+  void ReadPages(std::vector<std::pair<page_id_t, char *>> &pages, const std::function<void(size_t)> &on_read = {});
+
+  /**
+   * Write the disk file meta page, the changed directory and bitmap pages, and fsync every segment file, so that
+   * every write so far is durable.
+   */
+  void Sync();
+
   /**
    * Get next free page from disk
    * @return logical page id of allocated page
@@ -48,17 +193,85 @@ class DiskManager {
   page_id_t AllocatePage();
 
   /**
-   * Free this page and reset bit map
+   * Get a free page close to the other pages of the same table or index, so that scanning the object reads runs of
+   * physically contiguous pages. The page is taken from the run of RUN_PAGES pages holding near_page_id, after it if
+   * possible. When that run is full the object starts an empty run, and only when no run is empty the page is taken
+   * anywhere, see AllocatePage. Runs are not reserved, an empty run simply goes to the first object that asks.
+   * @param near_page_id the last page allocated for the object, INVALID_PAGE_ID to start a new object in an empty run
+   * @return logical page id of allocated page
+   */
+  page_id_t AllocatePageNear(page_id_t near_page_id);
+
+  /** Turn run allocation on or off, while off AllocatePageNear allocates like AllocatePage. */
+  void SetPageRuns(bool enabled) { page_runs_.store(enabled, std::memory_order_relaxed); }
+
+  /**
+   * Free this page and reset bit map. Its disk blocks are released at the next Sync, see SetPunchHoles.
    */
   void DeAllocatePage(page_id_t logical_page_id);
 
+  /** Turn hole punching on or off, while off a deallocated page keeps its disk blocks until Shrink. */
+  void SetPunchHoles(bool enabled) { punch_holes_.store(enabled, std::memory_order_relaxed); }
+
+  /** @return true if deallocated pages are punched out of the file, false if turned off or not supported */
+  bool PunchesHoles() const { return punch_holes_.load(std::memory_order_relaxed); }
+
+  /**
+   * Truncate the database after its last allocated page, removing the segment files past it. Allocated pages are not
+   * moved, so only the free pages at the end of the database are given back, see CatalogManager::CompactTables. The
+   * disk file metadata is synced. A concurrent read of a removed page reads zeros, the descriptor stays open until
+   * Close.
+   * @return bytes the database shrank by
+   */
+  int64_t Shrink();
+
   /**
    * Return whether specific logical_page_id is free
    */
   bool IsPageFree(page_id_t logical_page_id);
 
   /**
-   * Shut down the disk manager and close all the file resources.
+   * Hint the operating system that these pages will be read soon, so it can start reading them asynchronously.
+   * Physically contiguous pages are advised as one range.
+   */
+  void AdviseWillNeed(const std::vector<page_id_t> &logical_page_ids);
+
+  /** @return true if pages bypass the OS page cache, false if direct I/O was not asked for or is not supported */
+  bool IsDirectIO() const { return direct_io_.load(std::memory_order_relaxed); }
+
+  /** @return true if the file is mapped read-only and every write is rejected */
+  bool IsReadOnly() const { return read_only_; }
+
+  /**
+   * Only in read-only mode.
+   * @return the page inside the mapping of the file, nullptr if the page lies past the end of the file
+   */
+  char *GetMappedPage(page_id_t logical_page_id);
+
+  /** @return true if batches of pages go through an io_uring, false if through the thread pool of AsyncIO */
+  bool UsesIOUring() { return GetAsyncIO()->UsesIOUring(); }
+
+  /** @return bytes of a segment file, 0 if the database is one file */
+  int64_t GetSegmentSize() const { return segment_size_; }
+
+  /** @return the number of segment files of the database */
+  size_t GetSegmentCount();
+
+  /** @return bytes of the database across segments, holes included */
+  int64_t GetFileSize() const { return file_size_.load(std::memory_order_relaxed); }
+
+  /**
+   * The counters are kept with relaxed atomics and may be read while the file is in use, so the snapshot is not
+   * necessarily consistent across counters.
+   * @return the physical I/O of the file so far
+   */
+  DiskIOStats GetIOStats() const;
+
+  /** @return the number of used pages of an extent */
+  uint32_t GetExtentUsedPages(size_t extent_index);
+
+  /**
+   * Shut down the disk manager and close all the file resources, after a last Sync.
    */
   void Close();
 
@@ -72,11 +285,15 @@ class DiskManager {
 
   static constexpr size_t BITMAP_SIZE = BitmapPage<PAGE_SIZE>::GetMaxSupportedSize();
 
+  /** Number of extents of a database, limited by the physical page ids of their pages, see MAX_VALID_PAGE_ID. */
+  static constexpr size_t MAX_EXTENTS = MAX_VALID_PAGE_ID / BITMAP_SIZE;
+
+  /** Number of segment files of a database at most. */
+  static constexpr size_t MAX_SEGMENTS = 1 << 16;
+
  private:
-  /**
-   * Helper function to get disk file size
-   */
-  int GetFileSize(const std::string &file_name);
+  /** Unmap the file and close all its descriptors without a Sync, see Close. */
+  void ReleaseFiles();
 
   /**
    * Read physical page from disk
@@ -88,6 +305,69 @@ class DiskManager {
    */
   void WritePhysicalPage(page_id_t physical_page_id, const char *page_data);
 
+  /**
+   * Write a run of physically contiguous pages of one segment synchronously, continuing after short writes.
+   * @param offset offset of the run in the database, across segments
+   */
+  void WriteRun(const iovec *iov, int iov_count, int64_t offset);
+
+  /**
+   * Account for a physical read or write that started at start and has just completed.
+   * @param bytes bytes transferred by the operation
+   */
+  void RecordIO(bool write, int64_t bytes, std::chrono::steady_clock::time_point start);
+
+  /** @return the segment holding a physical page, and the offset of the page in the segment file */
+  std::pair<size_t, off_t> LocatePage(page_id_t physical_page_id) const;
+
+  /**
+   * @param create true to create the segment, and every segment before it, if it does not exist
+   * @return the file descriptor of a segment, -1 if it does not exist and was not created
+   */
+  int GetSegmentFd(size_t segment, bool create);
+
+  /** Open the segment files of the database that exist, at construction. */
+  void OpenSegments(int flags);
+
+  /** @return the name of a segment file */
+  std::string GetSegmentFileName(size_t segment) const;
+
+  /**
+   * Punch a hole over every run of pages freed since the last Sync that is still free. Must be called with
+   * db_io_latch_ held, after the bitmaps are durable.
+   */
+  void PunchFreedPages();
+
+  /** Account for the page allocated at offset of an extent. Must be called with db_io_latch_ held. */
+  page_id_t RecordAllocation(size_t extent_index, uint32_t offset);
+
+  /**
+   * @return the counter of used pages of an extent, in the meta page or a directory page read on first use. Must be
+   * called with db_io_latch_ held.
+   */
+  uint32_t &ExtentUsedPages(size_t extent_index);
+
+  /** Mark the page counting the used pages of an extent as changed. Must be called with db_io_latch_ held. */
+  void MarkDirectoryDirty(size_t extent_index);
+
+  /** @return the cached bitmap page of an extent, read on first use. Must be called with db_io_latch_ held. */
+  BitmapPage<PAGE_SIZE> *GetBitmap(size_t extent_index);
+
+  /** @return the asynchronous I/O engine of the file, set up on first use */
+  AsyncIO *GetAsyncIO();
+
+  /** Account for a write that ended at offset end. */
+  void ExtendFileSize(int64_t end);
+
+  /** @return true, after logging it, if the file is read-only and a write to it has to be rejected */
+  bool RejectWrite(const char *operation);
+
+  /** Switch to buffered I/O after the filesystem refused an O_DIRECT request. */
+  void DisableDirectIO();
+
+  /** @return true if a buffer can be used for O_DIRECT I/O as it is */
+  static bool IsAligned(const void *buffer) { return reinterpret_cast<uintptr_t>(buffer) % DISK_IO_ALIGNMENT == 0; }
+
   /**
    * Map logical page id to physical page id
    */
@@ -104,18 +384,64 @@ class DiskManager {
    */
   static page_id_t getBitmapPhyIdFromExtIndex(uint extIndex);
 
+  /**
+   * get the physical page id of the directory page that counts a group of EXTENTS_PER_DIRECTORY_PAGE extents, the
+   * meta page for group 0
+   */
+  static page_id_t getDirectoryPhyIdFromGroup(size_t group);
+
   /**
    * get the offset in a bitmap from the physical id
    */
   static uint getOffsetFromPhyId(page_id_t physical_page_id);
  private:
-  // stream to write db file
-  std::fstream db_io_;
+  // bytes of a segment file, 0 for one file
+  int64_t segment_size_{0};
+  // descriptors of the segment files, -1 past the last one, segment 0 is the db file. Segments are created under
+  // db_io_latch_, page I/O reads the descriptors without it
+  std::unique_ptr<std::atomic<int>[]> segment_fds_;
+  size_t max_segments_{1};
+  // descriptors of the segment files Shrink removed, a reader may still hold one so they are closed by Close only
+  std::vector<int> retired_fds_;
+  // whether the descriptors were opened with O_DIRECT
+  std::atomic<bool> direct_io_{false};
+  // read-only mapping of every segment file, with its size
+  bool read_only_{false};
+  std::vector<std::pair<char *, size_t>> mappings_;
+  // batched reads and writes
+  std::unique_ptr<AsyncIO> async_io_;
+  std::once_flag async_io_once_;
+  // size of the database across segments, grown by every write past its end
+  std::atomic<int64_t> file_size_{0};
   std::string file_name_;
-  // with multiple buffer pool instances, need to protect file access
+  // protects the meta page and the bitmap pages, page I/O itself needs no lock
   std::recursive_mutex db_io_latch_;
+  // bitmap pages of the extents read so far, indexed by extent, and whether they changed since the last Sync
+  std::vector<std::unique_ptr<BitmapPage<PAGE_SIZE>>> bitmaps_;
+  std::vector<bool> bitmap_dirty_;
+  // directory pages after the meta page read so far, indexed by group - 1, and whether they changed since the last Sync
+  struct PageDeleter {
+    void operator()(DiskFileMetaPage *page) const { free(page); }
+  };
+  std::vector<std::unique_ptr<DiskFileMetaPage, PageDeleter>> directories_;
+  std::vector<bool> directory_dirty_;
+  // every extent below it is full
+  size_t first_free_extent_{0};
+  // logical ids of the pages deallocated since the last Sync, see PunchFreedPages
+  std::vector<page_id_t> freed_pages_;
+  // see SetPunchHoles
+  std::atomic<bool> punch_holes_{DISK_MANAGER_PUNCH_HOLES};
+  // see AllocatePageNear
+  std::atomic<bool> page_runs_{DISK_MANAGER_PAGE_RUNS};
+  // see GetIOStats, the histograms count operations per bucket of LatencyHistogram
+  std::atomic<uint64_t> reads_{0};
+  std::atomic<uint64_t> read_bytes_{0};
+  std::atomic<uint64_t> writes_{0};
+  std::atomic<uint64_t> written_bytes_{0};
+  std::array<std::atomic<uint64_t>, LatencyHistogram::BUCKETS> read_latency_{};
+  std::array<std::atomic<uint64_t>, LatencyHistogram::BUCKETS> write_latency_{};
   bool closed{false};
-  char meta_data_[PAGE_SIZE];
+  alignas(DISK_IO_ALIGNMENT) char meta_data_[PAGE_SIZE];
 };
 
 #endif
\ No newline at end of file
@@ -26,7 +26,8 @@ class TableHeap {
   ~TableHeap() {}
 
   /**
-   * Insert a tuple into the table. If the tuple is too large (>= page_size), return false.
+   * Insert a tuple into the table. If the tuple is too large (>= page_size), return false. The writes of a table are
+   * rejected in a read-only database, see BufferPoolManager::RejectWrite.
    * @param[in/out] row Tuple Row to insert, the rid of the inserted tuple is wrapped in object row
    * @param[in] txn The transaction performing the insert
    * @return true iff the insert is successful
@@ -92,9 +93,36 @@ class TableHeap {
    */
   inline page_id_t GetFirstPageId() const { return first_page_id_; }
 
+  /**
+   * @return the ids of the pages of this table, in chain order
+   */
+  std::vector<page_id_t> GetPageIds();
+
+  /**
+   * Move a page of this table to the lowest free page of the database, if it is below the page. The tuples keep their
+   * slots, so a row id of the page only changes its page id, the caller has to update the indexes.
+   * @param page_id page of this table to move
+   * @param[out] new_page_id page it moved to
+   * @return false if there is no free page below it
+   */
+  bool RelocatePage(page_id_t page_id, page_id_t &new_page_id);
+
+  /**
+   * Give the pages of this table a residency hint in the buffer pool, see BufferPoolManager::SetResidencyHint. Pages
+   * the table allocates later get the hint as well.
+   * @param cached true to keep the table resident, false to make its pages ordinary again
+   */
+  void SetCached(bool cached);
+
+  /** Charge the page I/O of this table to an owner tag, see PageOwnerScope. */
+  void SetOwner(page_owner_t owner) { owner_ = owner; }
+
+  /** @return the owner tag the page I/O of this table is charged to */
+  inline page_owner_t GetOwner() const { return owner_; }
+
  private:
   /**
-   * create table heap and initialize first page
+   * create table heap and initialize first page, a heap without one is left empty if no page can be allocated
    */
   explicit TableHeap(BufferPoolManager *buffer_pool_manager, Schema *schema, Transaction *txn, LogManager *log_manager,
                      LockManager *lock_manager)
@@ -102,7 +130,11 @@ class TableHeap {
         schema_(schema),
         log_manager_(log_manager),
         lock_manager_(lock_manager) {
-    auto firstPage = reinterpret_cast<TablePage *>(buffer_pool_manager->NewPage(first_page_id_));
+    auto firstPage = reinterpret_cast<TablePage *>(buffer_pool_manager->NewPageNear(first_page_id_, INVALID_PAGE_ID));
+    if (firstPage == nullptr) {
+      first_page_id_ = INVALID_PAGE_ID;
+      return;
+    }
     firstPage->WLatch();
     firstPage->Init(first_page_id_, INVALID_PAGE_ID, log_manager, txn);
     firstPage->WUnlatch();
@@ -126,6 +158,8 @@ class TableHeap {
   Schema *schema_;
   [[maybe_unused]] LogManager *log_manager_;
   [[maybe_unused]] LockManager *lock_manager_;
+  bool cached_{false};
+  page_owner_t owner_{INVALID_PAGE_OWNER};
 };
 
 #endif  // MINISQL_TABLE_HEAP_H
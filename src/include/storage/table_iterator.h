@@ -1,12 +1,19 @@
 #ifndef MINISQL_TABLE_ITERATOR_H
 #define MINISQL_TABLE_ITERATOR_H
 
+#include "buffer/read_ahead.h"
 #include "common/rowid.h"
 #include "record/row.h"
 #include "transaction/transaction.h"
 
 class TableHeap;
+class TablePage;
 
+/**
+ * Iterates the rows of a table heap. The iterator keeps the page it is on pinned, and reads the rows of that page
+ * without fetching it again, so a scan pins every heap page once. See LRUKReplacer, to which every pin is an access.
+ * A copy of an iterator does not share the pin, it fetches the page again when it is advanced.
+ */
 class TableIterator {
  public:
   // you may define your own constructor based on your member variables
@@ -16,6 +23,8 @@ class TableIterator {
 
   TableIterator(const TableIterator &other);
 
+  TableIterator &operator=(const TableIterator &other);
+
   virtual ~TableIterator();
 
   bool operator==(const TableIterator &itr) const;
@@ -31,10 +40,18 @@ class TableIterator {
   TableIterator operator++(int);
 
  private:
+  /** Read the row at rid from the current page into a fresh row. */
+  void ReadRow(RowId rid);
+
+  /** Unpin the current page, if the iterator holds one. */
+  void ReleasePage();
+
   // add your own private member variables here
   TableHeap *pTableHeap;
   Transaction *pTransaction;
   Row *pRow;
+  TablePage *pPage{nullptr};  // the page of pRow, pinned while the iterator is on it
+  ReadAhead readAhead;
 };
 
 #endif  // MINISQL_TABLE_ITERATOR_H
@@ -18,18 +18,54 @@ BPLUSTREE_TYPE::BPlusTree(index_id_t index_id, BufferPoolManager *buffer_pool_ma
 
 INDEX_TEMPLATE_ARGUMENTS
 void BPLUSTREE_TYPE::Destroy() {
-  buffer_pool_manager_->UnpinPage(root_page_id_,true);
-  KeyType key{};
-  auto* leaf= FindLeafPage(key,true);
-   while(leaf->GetPageId()!=INVALID_PAGE_ID){
-     auto* leaf_node= reinterpret_cast<BPlusTreeLeafPage<KeyType,ValueType,KeyComparator>*>(leaf->GetData());
-    auto* page=buffer_pool_manager_->FetchPage(leaf_node->GetNextPageId());
-    buffer_pool_manager_->UnpinPage(leaf->GetPageId(),true);
-    buffer_pool_manager_->DeletePage(leaf->GetPageId());
-    leaf=page;
+  if (RejectWrite("index destroy")) {
+    return;
+  }
+  PageOwnerScope owner_scope(owner_);
+  if (IsEmpty()) {
+    return;
+  }
+  std::vector<page_id_t> page_ids;
+  CollectPageIds(root_page_id_, &page_ids);
+  for (auto page_id : page_ids) {
+    buffer_pool_manager_->DeletePage(page_id);
+  }
+  auto *header = reinterpret_cast<IndexRootsPage *>(buffer_pool_manager_->FetchPage(INDEX_ROOTS_PAGE_ID)->GetData());
+  header->Delete(index_id_);
+  buffer_pool_manager_->UnpinPage(INDEX_ROOTS_PAGE_ID, true);
+  root_page_id_ = INVALID_PAGE_ID;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::SetCached(bool cached) {
+  PageOwnerScope owner_scope(owner_);
+  cached_ = cached;
+  std::vector<page_id_t> page_ids;
+  if (!IsEmpty()) {
+    CollectPageIds(root_page_id_, &page_ids);
+  }
+  buffer_pool_manager_->SetResidencyHint(page_ids, cached);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::CollectPageIds(page_id_t page_id, std::vector<page_id_t> *page_ids) {
+  page_ids->push_back(page_id);
+  Page *page = buffer_pool_manager_->FetchPage(page_id);
+  auto *node = reinterpret_cast<BPlusTreePage *>(page->GetData());
+  if (!node->IsLeafPage()) {
+    auto *internal = reinterpret_cast<InternalPage *>(node);
+    for (int i = 0; i < internal->GetSize(); i++) {
+      CollectPageIds(internal->ValueAt(i), page_ids);
+    }
+  }
+  buffer_pool_manager_->UnpinPage(page_id, false);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::HintNewPage(page_id_t page_id) {
+  if (cached_) {
+    buffer_pool_manager_->SetResidencyHint({page_id}, true);
   }
-  buffer_pool_manager_->DeletePage(root_page_id_);
-  root_page_id_=INVALID_PAGE_ID;
 }
 
 /*
@@ -50,6 +86,7 @@ bool BPLUSTREE_TYPE::IsEmpty() const {
  */
 INDEX_TEMPLATE_ARGUMENTS
 bool BPLUSTREE_TYPE::GetValue(const KeyType &key, std::vector<ValueType> &result, Transaction *transaction) {
+  PageOwnerScope owner_scope(owner_);
   Page* leaf_page=FindLeafPage(key,false);
  auto* leaf=reinterpret_cast<BPlusTreeLeafPage<KeyType,ValueType,KeyComparator>*>(leaf_page->GetData());
 // auto* leaf= FindLeafPage(key,false,NULL);
@@ -82,6 +119,10 @@ bool BPLUSTREE_TYPE::GetValue(const KeyType &key, std::vector<ValueType> &result
  */
 INDEX_TEMPLATE_ARGUMENTS
 bool BPLUSTREE_TYPE::Insert(const KeyType &key, const ValueType &value, Transaction *transaction) {
+  if (RejectWrite("index insert")) {
+    return false;
+  }
+  PageOwnerScope owner_scope(owner_);
   if(IsEmpty()){
     StartNewTree(key,value);
     return true;
@@ -96,11 +137,11 @@ bool BPLUSTREE_TYPE::Insert(const KeyType &key, const ValueType &value, Transact
  */
 INDEX_TEMPLATE_ARGUMENTS
 void BPLUSTREE_TYPE::StartNewTree(const KeyType &key, const ValueType &value) {
-  Page* page=buffer_pool_manager_->NewPage(root_page_id_);
+  Page* page=buffer_pool_manager_->NewPageNear(root_page_id_,INVALID_PAGE_ID);
   vector<page_id_t> temp;
   while(root_page_id_<2){
     temp.push_back(root_page_id_);
-    page=buffer_pool_manager_->NewPage(root_page_id_);
+    page=buffer_pool_manager_->NewPageNear(root_page_id_,INVALID_PAGE_ID);
 
   }
   while(temp.size()!=0){
@@ -110,6 +151,7 @@ void BPLUSTREE_TYPE::StartNewTree(const KeyType &key, const ValueType &value) {
   }
   if(page==nullptr)
     throw runtime_error("out of memory");
+  HintNewPage(root_page_id_);
   auto root=reinterpret_cast<BPlusTreeLeafPage<KeyType,ValueType,KeyComparator>*>(page->GetData());
   UpdateRootPageId(true);
   root->Init(root_page_id_,INVALID_PAGE_ID,leaf_max_size_);
@@ -171,11 +213,11 @@ INDEX_TEMPLATE_ARGUMENTS
 template<typename N>
 N *BPLUSTREE_TYPE::Split(N *node) {
   page_id_t page_id;
-  Page* page=buffer_pool_manager_->NewPage(page_id);
+  Page* page=buffer_pool_manager_->NewPageNear(page_id,node->GetPageId());
   vector<page_id_t> temp;
   while(page_id<2){
     temp.push_back(page_id);
-    page=buffer_pool_manager_->NewPage(page_id);
+    page=buffer_pool_manager_->NewPageNear(page_id,node->GetPageId());
 
   }
   while(temp.size()!=0){
@@ -187,6 +229,7 @@ N *BPLUSTREE_TYPE::Split(N *node) {
     throw runtime_error("out of memory");
     return nullptr;
   }
+  HintNewPage(page_id);
 
   auto* new_node=reinterpret_cast<N*>(page->GetData());
   if(node->IsLeafPage()){
@@ -215,11 +258,11 @@ void BPLUSTREE_TYPE::InsertIntoParent(BPlusTreePage *old_node, const KeyType &ke
                                       Transaction *transaction) {
   if(old_node->IsRootPage()){
     //page_id_t new_root_page_id;
-    auto* new_page=buffer_pool_manager_->NewPage(root_page_id_);
+    auto* new_page=buffer_pool_manager_->NewPageNear(root_page_id_,old_node->GetPageId());
     vector<page_id_t> temp;
     while(root_page_id_<2){
       temp.push_back(root_page_id_);
-      new_page=buffer_pool_manager_->NewPage(root_page_id_);
+      new_page=buffer_pool_manager_->NewPageNear(root_page_id_,old_node->GetPageId());
 
     }
     while(temp.size()!=0){
@@ -228,6 +271,7 @@ void BPLUSTREE_TYPE::InsertIntoParent(BPlusTreePage *old_node, const KeyType &ke
       temp.pop_back();
     }
 
+    HintNewPage(root_page_id_);
     auto* new_root=reinterpret_cast<BPlusTreeInternalPage<KeyType,page_id_t ,KeyComparator>*>(new_page->GetData());
     new_root->Init(root_page_id_,INVALID_PAGE_ID,internal_max_size_);
     new_root->PopulateNewRoot(old_node->GetPageId(),key,new_node->GetPageId());
@@ -254,13 +298,13 @@ void BPLUSTREE_TYPE::InsertIntoParent(BPlusTreePage *old_node, const KeyType &ke
     }
     else {
       page_id_t page_id;
-      Page *page = buffer_pool_manager_->NewPage(page_id);
+      Page *page = buffer_pool_manager_->NewPageNear(page_id,father_node->GetPageId());
 
 
       vector<page_id_t> temp_;
       while(page_id<2){
         temp_.push_back(page_id);
-        page=buffer_pool_manager_->NewPage(page_id);
+        page=buffer_pool_manager_->NewPageNear(page_id,father_node->GetPageId());
         if (page == nullptr) {
           throw runtime_error("out of memory");
         }
@@ -271,6 +315,7 @@ void BPLUSTREE_TYPE::InsertIntoParent(BPlusTreePage *old_node, const KeyType &ke
         buffer_pool_manager_->DeletePage(temp_.back());
         temp_.pop_back();
       }
+      HintNewPage(page_id);
       auto *temp = reinterpret_cast<BPlusTreeInternalPage<KeyType, page_id_t, KeyComparator> *>(page->GetData());
       temp->Init(page_id,INVALID_PAGE_ID,internal_max_size_);
       temp->SetSize(father_node->GetSize());
@@ -327,6 +372,10 @@ void BPLUSTREE_TYPE::InsertIntoParent(BPlusTreePage *old_node, const KeyType &ke
  */
 INDEX_TEMPLATE_ARGUMENTS
 void BPLUSTREE_TYPE::Remove(const KeyType &key, Transaction *transaction) {
+  if (RejectWrite("index remove")) {
+    return;
+  }
+  PageOwnerScope owner_scope(owner_);
   if(IsEmpty())
     return;
   Page* page= FindLeafPage(key,false);
@@ -491,11 +540,12 @@ bool BPLUSTREE_TYPE::AdjustRoot(BPlusTreePage *old_root_node) {
  */
 INDEX_TEMPLATE_ARGUMENTS
 INDEXITERATOR_TYPE BPLUSTREE_TYPE::Begin() {
+  PageOwnerScope owner_scope(owner_);
   KeyType key{};
   Page* page= FindLeafPage( key,true);
   auto* leaf=reinterpret_cast<BPlusTreeLeafPage<KeyType,ValueType,KeyComparator>*>(page->GetData());
 
-  return INDEXITERATOR_TYPE(leaf,0,buffer_pool_manager_);
+  return INDEXITERATOR_TYPE(leaf,0,buffer_pool_manager_,owner_);
 }
 
 /*
@@ -505,6 +555,7 @@ INDEXITERATOR_TYPE BPLUSTREE_TYPE::Begin() {
  */
 INDEX_TEMPLATE_ARGUMENTS
 INDEXITERATOR_TYPE BPLUSTREE_TYPE::Begin(const KeyType &key) {
+  PageOwnerScope owner_scope(owner_);
   Page* page= FindLeafPage( key,false);
   auto* leaf=reinterpret_cast<BPlusTreeLeafPage<KeyType,ValueType,KeyComparator>*>(page->GetData());
 
@@ -513,7 +564,7 @@ int index=0;
     index=leaf->KeyIndex(key,comparator_);
   }
 
-  return INDEXITERATOR_TYPE(leaf,index,buffer_pool_manager_);
+  return INDEXITERATOR_TYPE(leaf,index,buffer_pool_manager_,owner_);
 
 }
 
@@ -524,6 +575,7 @@ int index=0;
  */
 INDEX_TEMPLATE_ARGUMENTS
 INDEXITERATOR_TYPE BPLUSTREE_TYPE::End() {
+  PageOwnerScope owner_scope(owner_);
 
   Page* page=buffer_pool_manager_->FetchPage((root_page_id_));
   auto* node=reinterpret_cast<BPlusTreePage*>(page->GetData());
@@ -539,7 +591,7 @@ INDEXITERATOR_TYPE BPLUSTREE_TYPE::End() {
   page=buffer_pool_manager_->FetchPage(node->GetPageId());
   auto* leaf=reinterpret_cast<BPlusTreeLeafPage<KeyType,ValueType,KeyComparator>*>(page->GetData());
 
-  return INDEXITERATOR_TYPE(leaf,index,buffer_pool_manager_);
+  return INDEXITERATOR_TYPE(leaf,index,buffer_pool_manager_,owner_);
 
 }
 
@@ -553,6 +605,7 @@ INDEXITERATOR_TYPE BPLUSTREE_TYPE::End() {
  */
 INDEX_TEMPLATE_ARGUMENTS
 Page *BPLUSTREE_TYPE::FindLeafPage(const KeyType &key, bool leftMost) {
+  PageOwnerScope owner_scope(owner_);
   if(IsEmpty())
     return nullptr;
   Page* page=buffer_pool_manager_->FetchPage((root_page_id_));
@@ -588,6 +641,8 @@ Page *BPLUSTREE_TYPE::FindLeafPage(const KeyType &key, bool leftMost) {
  */
 INDEX_TEMPLATE_ARGUMENTS
 void BPLUSTREE_TYPE::UpdateRootPageId(int insert_record) {
+  // the index roots page is shared by every index, keep it untagged
+  PageOwnerScope owner_scope(INVALID_PAGE_OWNER);
 
   Page* page=buffer_pool_manager_->FetchPage(INDEX_ROOTS_PAGE_ID);
 
@@ -26,6 +26,9 @@ dberr_t BPLUSTREE_INDEX_TYPE::InsertEntry(const Row &key, RowId row_id, Transact
 
 INDEX_TEMPLATE_ARGUMENTS
 dberr_t BPLUSTREE_INDEX_TYPE::RemoveEntry(const Row &key, RowId row_id, Transaction *txn) {
+  if (container_.RejectWrite("index remove")) {
+    return DB_FAILED;
+  }
   KeyType index_key;
   index_key.SerializeFromKey(key, key_schema_);
 
@@ -45,10 +48,23 @@ dberr_t BPLUSTREE_INDEX_TYPE::ScanKey(const Row &key, vector<RowId> &result, Tra
 
 INDEX_TEMPLATE_ARGUMENTS
 dberr_t BPLUSTREE_INDEX_TYPE::Destroy() {
+  if (container_.RejectWrite("index destroy")) {
+    return DB_FAILED;
+  }
   container_.Destroy();
   return DB_SUCCESS;
 }
 
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_INDEX_TYPE::SetCached(bool cached) {
+  container_.SetCached(cached);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_INDEX_TYPE::SetOwner(page_owner_t owner) {
+  container_.SetOwner(owner);
+}
+
 INDEX_TEMPLATE_ARGUMENTS
 INDEXITERATOR_TYPE BPLUSTREE_INDEX_TYPE::GetBeginIterator() {
   return container_.Begin();
@@ -11,10 +11,12 @@ INDEXITERATOR_TYPE::IndexIterator() {
 
 INDEX_TEMPLATE_ARGUMENTS
 INDEXITERATOR_TYPE::IndexIterator(BPlusTreeLeafPage<KeyType,ValueType,KeyComparator>* leaf_node,
-              int index_,BufferPoolManager* bufferPoolManager){
+              int index_,BufferPoolManager* bufferPoolManager,page_owner_t owner){
   leaf=leaf_node;
   index=index_;
   buffer_pool_manager_=bufferPoolManager;
+  read_ahead_=ReadAhead(bufferPoolManager,BPlusTreeLeafPage<KeyType,ValueType,KeyComparator>::NextPageIdOf);
+  owner_=owner;
 }
 
 INDEX_TEMPLATE_ARGUMENTS INDEXITERATOR_TYPE::~IndexIterator() {
@@ -34,6 +36,7 @@ INDEX_TEMPLATE_ARGUMENTS INDEXITERATOR_TYPE &INDEXITERATOR_TYPE::operator++() {
   index++;
   //find next leaf
   if(index==leaf->GetSize()&&leaf->GetNextPageId()!=INVALID_PAGE_ID){
+    PageOwnerScope owner_scope(owner_);
     page_id_t next_page_id=leaf->GetNextPageId();
     Page* page=buffer_pool_manager_->FetchPage(next_page_id);
     buffer_pool_manager_->UnpinPage(leaf->GetPageId(),false);
@@ -41,6 +44,7 @@ INDEX_TEMPLATE_ARGUMENTS INDEXITERATOR_TYPE &INDEXITERATOR_TYPE::operator++() {
     auto* next_leaf=reinterpret_cast<BPlusTreeLeafPage<KeyType,ValueType,KeyComparator>*>(page->GetData());
     index=0;
     leaf=next_leaf;
+    read_ahead_.Advance(leaf->GetNextPageId());
   }
   return *this;
 }
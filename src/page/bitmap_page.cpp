@@ -1,21 +1,87 @@
+#include <algorithm>
+#include <cstring>
+
 #include "page/bitmap_page.h"
 
+// 1.   Every page below next_free_page_ is allocated, so the search starts at the word holding it.
+// 2.   Skip full words 64 pages at a time, then find the first byte with a free page in the word from its trailing
+//      zeros. Bytes past the last whole word are looked at one by one.
+// 3.   Pages are numbered from the most significant bit of a byte, the first free page of the byte is its first 0 bit
+//      from the top.
 template <size_t PageSize>
 bool BitmapPage<PageSize>::AllocatePage(uint32_t &page_offset) {
-  for (size_t byteIndex = 0; byteIndex < MAX_CHARS; byteIndex++) {
-    if (bytes[byteIndex] != 0xFF) {
-      for (int i = 0; i < 8; ++i) {
-        if (IsPageFreeLow(byteIndex, i)) {
-          setByteIndex(bytes[byteIndex], i);
-          page_offset = byteIndex * 8 + i;
-          return true;
-        }
-      }
+  // a hint past the end can only come from a damaged page, start over then
+  size_t hint = next_free_page_ < GetMaxSupportedSize() ? next_free_page_ : 0;
+  size_t byte_index = hint / 8 / sizeof(uint64_t) * sizeof(uint64_t);
+  for (; byte_index + sizeof(uint64_t) <= MAX_CHARS; byte_index += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, bytes + byte_index, sizeof(word));
+    if (word != ~uint64_t{0}) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+      byte_index += __builtin_ctzll(~word) / 8;
+#endif
+      break;
+    }
+  }
+  while (byte_index < MAX_CHARS && bytes[byte_index] == 0xFF) {
+    byte_index++;
+  }
+  if (byte_index >= MAX_CHARS) {
+    next_free_page_ = GetMaxSupportedSize();
+    return false;
+  }
+  auto bit_index = static_cast<uint32_t>(__builtin_clz(static_cast<uint8_t>(~bytes[byte_index])) - 24);
+  setByteIndex(bytes[byte_index], bit_index);
+  page_offset = byte_index * 8 + bit_index;
+  next_free_page_ = page_offset + 1;
+  return true;
+}
+
+template <size_t PageSize>
+bool BitmapPage<PageSize>::AllocatePageInRun(uint32_t hint, uint32_t &page_offset) {
+  if (hint >= GetMaxSupportedSize()) {
+    return false;
+  }
+  uint32_t run_start = hint / RUN_PAGES * RUN_PAGES;
+  auto run_end = static_cast<uint32_t>(std::min<size_t>(run_start + RUN_PAGES, GetMaxSupportedSize()));
+  return AllocateFirstFree(hint, run_end, page_offset) || AllocateFirstFree(run_start, hint, page_offset);
+}
+
+template <size_t PageSize>
+bool BitmapPage<PageSize>::AllocateEmptyRun(uint32_t first_run, uint32_t &page_offset) {
+  for (size_t run = first_run; run < GetRunCount(); run++) {
+    uint64_t word;
+    memcpy(&word, bytes + run * sizeof(uint64_t), sizeof(word));
+    if (word == 0) {
+      return AllocateFirstFree(run * RUN_PAGES, (run + 1) * RUN_PAGES, page_offset);
     }
   }
   return false;
 }
 
+template <size_t PageSize>
+bool BitmapPage<PageSize>::AllocateFirstFree(uint32_t from, uint32_t to, uint32_t &page_offset) {
+  for (uint32_t offset = from; offset < to; offset = offset / 8 * 8 + 8) {
+    // free pages of the byte at or after offset
+    auto free = static_cast<uint8_t>(~bytes[offset / 8] & (0xFF >> (offset % 8)));
+    if (free == 0) {
+      continue;
+    }
+    uint32_t found = offset / 8 * 8 + (__builtin_clz(free) - 24);
+    if (found >= to) {
+      return false;
+    }
+    setByteIndex(bytes[found / 8], found % 8);
+    page_offset = found;
+    // the hint stays true, every page below found was allocated if it pointed at found
+    if (next_free_page_ == found) {
+      next_free_page_ = found + 1;
+    }
+    return true;
+  }
+  return false;
+}
+
 template <size_t PageSize>
 bool BitmapPage<PageSize>::DeAllocatePage(uint32_t page_offset) {
   if (IsPageFree(page_offset)) {
@@ -24,6 +90,9 @@ bool BitmapPage<PageSize>::DeAllocatePage(uint32_t page_offset) {
   size_t byteIndex = page_offset / 8;
   size_t bitIndex = page_offset % 8;
   unsetByteIndex(bytes[byteIndex], bitIndex);
+  if (page_offset < next_free_page_) {
+    next_free_page_ = page_offset;
+  }
   return true;
 }
 
@@ -32,12 +101,39 @@ bool BitmapPage<PageSize>::IsPageFree(uint32_t page_offset) const {
   size_t maxSize = GetMaxSupportedSize();
   size_t byteIndex = page_offset / 8;
   size_t bitIndex = page_offset % 8;
-  if (byteIndex >= maxSize) {
+  if (page_offset >= maxSize) {
     return false;
   }
   return IsPageFreeLow(byteIndex, bitIndex);
 }
 
+template <size_t PageSize>
+bool BitmapPage<PageSize>::FindLastAllocated(uint32_t &page_offset) const {
+  size_t byte_index = MAX_CHARS;
+  // bytes past the last whole word one by one, then whole words, then the bytes of the word with an allocated page
+  while (byte_index % sizeof(uint64_t) != 0 && bytes[byte_index - 1] == 0) {
+    byte_index--;
+  }
+  if (byte_index % sizeof(uint64_t) == 0) {
+    for (; byte_index > 0; byte_index -= sizeof(uint64_t)) {
+      uint64_t word;
+      memcpy(&word, bytes + byte_index - sizeof(uint64_t), sizeof(word));
+      if (word != 0) {
+        break;
+      }
+    }
+    while (byte_index > 0 && bytes[byte_index - 1] == 0) {
+      byte_index--;
+    }
+  }
+  if (byte_index == 0) {
+    return false;
+  }
+  // the last allocated page of the byte is its lowest set bit
+  page_offset = (byte_index - 1) * 8 + 7 - __builtin_ctz(bytes[byte_index - 1]);
+  return true;
+}
+
 template <size_t PageSize>
 bool BitmapPage<PageSize>::IsPageFreeLow(uint32_t byte_index, uint8_t bit_index) const {
   char targetByte = bytes[byte_index];
@@ -78,6 +174,8 @@ bool BitmapPage<PageSize>::IsPageFreeLow(uint32_t byte_index, uint8_t bit_index)
 // used for test
 template class BitmapPage<9>;
 
+template class BitmapPage<17>;
+
 template class BitmapPage<64>;
 
 template class BitmapPage<128>;
@@ -90,4 +188,10 @@ template class BitmapPage<1024>;
 
 template class BitmapPage<2048>;
 
-template class BitmapPage<4096>;
\ No newline at end of file
+template class BitmapPage<4096>;
+
+template class BitmapPage<8192>;
+
+template class BitmapPage<16384>;
+
+template class BitmapPage<32768>;
\ No newline at end of file
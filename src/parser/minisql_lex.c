@@ -389,35 +389,39 @@ static void yy_fatal_error(yyconst char msg[]);
   *yy_cp = '\0'; \
   (yy_c_buf_p) = yy_cp;
 
-#define YY_NUM_RULES 56
-#define YY_END_OF_BUFFER 57
+#define YY_NUM_RULES 63
+#define YY_END_OF_BUFFER 64
 /* This struct is not used in this scanner,
    but its presence is necessary. */
 struct yy_trans_info {
   flex_int32_t yy_verify;
   flex_int32_t yy_nxt;
 };
-static yyconst flex_int16_t yy_accept[175] =
+static yyconst flex_int16_t yy_accept[211] =
         {0,
-         41, 41, 57, 55, 54, 54, 55, 49, 52, 53,
-         47, 46, 41, 55, 41, 48, 50, 42, 51, 39,
-         39, 39, 39, 39, 39, 39, 39, 39, 39, 39,
-         39, 39, 39, 39, 39, 39, 39, 39, 0, 1,
-         0, 0, 41, 40, 44, 43, 45, 39, 39, 39,
-         39, 39, 39, 39, 39, 39, 39, 39, 39, 39,
-         37, 39, 39, 39, 22, 35, 39, 39, 39, 39,
-         39, 39, 39, 39, 39, 39, 39, 34, 39, 39,
-         39, 39, 39, 39, 39, 39, 39, 39, 39, 39,
-         32, 29, 36, 39, 39, 39, 39, 39, 26, 39,
-
-         39, 39, 39, 14, 39, 39, 39, 39, 31, 39,
-         39, 39, 39, 3, 39, 39, 23, 39, 39, 25,
-         38, 39, 11, 39, 39, 13, 39, 39, 39, 39,
-         39, 39, 8, 39, 39, 39, 39, 39, 33, 20,
-         39, 39, 39, 39, 18, 39, 39, 15, 39, 24,
-         9, 2, 39, 6, 39, 39, 5, 39, 39, 4,
-         19, 30, 7, 27, 39, 39, 21, 28, 39, 16,
-         12, 10, 17, 0
+         48, 48, 64, 62, 61, 61, 62, 56, 59, 60,
+         54, 53, 48, 62, 48, 55, 57, 49, 58, 46,
+         46, 46, 46, 46, 46, 46, 46, 46, 46, 46,
+         46, 46, 46, 46, 46, 46, 46, 46, 0, 1,
+         0, 0, 48, 47, 51, 50, 52, 46, 46, 46,
+         46, 46, 46, 46, 46, 46, 46, 46, 46, 46,
+         37, 46, 46, 46, 22, 35, 46, 46, 46, 46,
+         46, 46, 46, 46, 46, 46, 46, 34, 46, 46,
+         46, 46, 46, 46, 46, 46, 46, 46, 46, 46,
+         32, 29, 36, 46, 46, 46, 46, 46, 26, 46,
+
+         46, 46, 46, 14, 46, 46, 46, 46, 31, 46,
+         46, 46, 46, 3, 46, 46, 23, 46, 46, 25,
+         38, 46, 11, 46, 46, 13, 46, 46, 46, 46,
+         46, 46, 8, 46, 46, 46, 46, 46, 33, 20,
+         46, 46, 46, 46, 18, 46, 46, 15, 46, 24,
+         9, 2, 46, 6, 46, 46, 5, 46, 46, 4,
+         19, 30, 7, 27, 46, 46, 21, 28, 46, 16,
+         12, 10, 17, 46, 46, 46, 46, 46, 39, 46,
+         46, 46, 46, 46, 40, 46, 46, 46, 46, 41,
+         46, 46, 46, 46, 42, 46, 46, 46, 46, 46,
+
+         46, 43, 46, 46, 46, 46, 44, 46, 45, 0
         };
 
 static yyconst flex_int32_t yy_ec[256] =
@@ -461,118 +465,167 @@ static yyconst flex_int32_t yy_meta[43] =
          2, 2
         };
 
-static yyconst flex_int16_t yy_base[177] =
+static yyconst flex_int16_t yy_base[211] =
         {0,
-         0, 0, 188, 189, 189, 189, 39, 189, 189, 189,
-         189, 189, 33, 175, 35, 189, 33, 189, 171, 0,
-         154, 161, 24, 32, 142, 23, 29, 159, 30, 35,
-         146, 142, 147, 38, 159, 38, 158, 150, 59, 189,
-         172, 162, 42, 161, 189, 189, 189, 0, 150, 146,
-         151, 139, 145, 130, 137, 133, 141, 131, 130, 50,
-         0, 119, 123, 130, 0, 0, 131, 130, 127, 44,
-         123, 134, 126, 130, 52, 122, 127, 0, 122, 113,
-         117, 127, 126, 121, 110, 121, 122, 110, 116, 115,
-         105, 0, 0, 107, 105, 97, 104, 109, 0, 91,
-
-         101, 95, 109, 0, 96, 88, 90, 93, 0, 96,
-         85, 101, 83, 0, 95, 81, 0, 76, 81, 0,
-         0, 96, 0, 94, 92, 0, 89, 73, 73, 84,
-         85, 84, 0, 69, 82, 85, 80, 75, 0, 78,
-         63, 64, 79, 60, 60, 72, 71, 0, 57, 0,
-         0, 0, 56, 0, 62, 54, 0, 43, 63, 0,
-         0, 0, 0, 0, 60, 59, 0, 0, 52, 42,
-         0, 0, 0, 189, 87, 74
+         0, 24, 61, 369, 369, 369, 104, 369, 369, 369,
+         369, 369, 46, 47, 147, 369, 148, 369, 150, 166,
+         17, 26, 125, 190, 9, 120, 125, 29, 178, 180,
+         18, 16, 24, 191, 133, 187, 134, 128, 1, 369,
+         218, 212, 219, 226, 369, 369, 369, 2, 140, 202,
+         209, 199, 209, 196, 205, 203, 214, 207, 208, 219,
+         3, 200, 206, 215, 4, 5, 218, 219, 218, 220,
+         216, 230, 224, 230, 231, 224, 236, 6, 233, 226,
+         232, 244, 245, 242, 233, 246, 249, 239, 247, 248,
+         240, 7, 8, 244, 244, 238, 247, 254, 10, 238,
+
+         250, 246, 262, 11, 251, 245, 249, 254, 12, 259,
+         250, 268, 252, 13, 266, 254, 14, 251, 258, 15,
+         19, 275, 20, 275, 275, 21, 274, 260, 262, 275,
+         278, 279, 22, 266, 281, 286, 283, 280, 23, 285,
+         272, 275, 292, 275, 277, 291, 292, 25, 280, 27,
+         28, 30, 281, 31, 289, 283, 32, 278, 300, 33,
+         34, 35, 36, 37, 299, 300, 38, 39, 296, 289,
+         40, 41, 42, 303, 303, 304, 306, 295, 43, 308,
+         313, 296, 297, 300, 44, 308, 301, 317, 307, 45,
+         324, 323, 320, 324, 48, 316, 328, 332, 331, 327,
+
+         332, 49, 325, 331, 330, 334, 50, 332, 51, 369
         };
 
-static yyconst flex_int16_t yy_def[177] =
+static yyconst flex_int16_t yy_def[211] =
         {0,
-         174, 1, 174, 174, 174, 174, 175, 174, 174, 174,
-         174, 174, 174, 174, 174, 174, 174, 174, 174, 176,
-         176, 176, 176, 176, 176, 176, 176, 176, 176, 176,
-         176, 176, 176, 176, 176, 176, 176, 176, 175, 174,
-         175, 174, 174, 174, 174, 174, 174, 176, 176, 176,
-         176, 176, 176, 176, 176, 176, 176, 176, 176, 176,
-         176, 176, 176, 176, 176, 176, 176, 176, 176, 176,
-         176, 176, 176, 176, 176, 176, 176, 176, 176, 176,
-         176, 176, 176, 176, 176, 176, 176, 176, 176, 176,
-         176, 176, 176, 176, 176, 176, 176, 176, 176, 176,
-
-         176, 176, 176, 176, 176, 176, 176, 176, 176, 176,
-         176, 176, 176, 176, 176, 176, 176, 176, 176, 176,
-         176, 176, 176, 176, 176, 176, 176, 176, 176, 176,
-         176, 176, 176, 176, 176, 176, 176, 176, 176, 176,
-         176, 176, 176, 176, 176, 176, 176, 176, 176, 176,
-         176, 176, 176, 176, 176, 176, 176, 176, 176, 176,
-         176, 176, 176, 176, 176, 176, 176, 176, 176, 176,
-         176, 176, 176, 0, 174, 174
+         0, 1, 0, 210, 210, 210, 0, 210, 210, 210,
+         210, 210, 3, 3, 3, 210, 3, 210, 3, 0,
+         20, 20, 20, 20, 20, 20, 20, 20, 20, 20,
+         20, 20, 20, 20, 20, 20, 20, 20, 7, 210,
+         7, 3, 3, 3, 210, 210, 210, 20, 20, 20,
+         20, 20, 20, 20, 20, 20, 20, 20, 20, 20,
+         20, 20, 20, 20, 20, 20, 20, 20, 20, 20,
+         20, 20, 20, 20, 20, 20, 20, 20, 20, 20,
+         20, 20, 20, 20, 20, 20, 20, 20, 20, 20,
+         20, 20, 20, 20, 20, 20, 20, 20, 20, 20,
+
+         20, 20, 20, 20, 20, 20, 20, 20, 20, 20,
+         20, 20, 20, 20, 20, 20, 20, 20, 20, 20,
+         20, 20, 20, 20, 20, 20, 20, 20, 20, 20,
+         20, 20, 20, 20, 20, 20, 20, 20, 20, 20,
+         20, 20, 20, 20, 20, 20, 20, 20, 20, 20,
+         20, 20, 20, 20, 20, 20, 20, 20, 20, 20,
+         20, 20, 20, 20, 20, 20, 20, 20, 20, 20,
+         20, 20, 20, 20, 20, 20, 20, 20, 20, 20,
+         20, 20, 20, 20, 20, 20, 20, 20, 20, 20,
+         20, 20, 20, 20, 20, 20, 20, 20, 20, 20,
+
+         20, 20, 20, 20, 20, 20, 20, 20, 20, 0
         };
 
-static yyconst flex_int16_t yy_nxt[232] =
-        {0,
+static yyconst flex_int16_t yy_nxt[412] =
+        {3,
          4, 5, 6, 7, 8, 9, 10, 11, 12, 13,
-         14, 15, 16, 17, 18, 19, 20, 4, 21, 22,
-         23, 24, 25, 26, 20, 20, 27, 28, 20, 20,
-         29, 30, 31, 32, 33, 34, 35, 36, 37, 38,
-         20, 20, 40, 42, 43, 42, 43, 45, 46, 51,
-         54, 58, 42, 43, 55, 52, 41, 59, 53, 60,
-         70, 63, 40, 71, 61, 65, 56, 64, 73, 66,
-         74, 89, 98, 75, 104, 48, 41, 173, 105, 172,
-         99, 171, 170, 169, 168, 90, 91, 39, 39, 167,
-         166, 165, 164, 163, 162, 161, 160, 159, 158, 157,
-
-         156, 155, 154, 153, 152, 151, 150, 149, 148, 147,
-         146, 145, 144, 143, 142, 141, 140, 139, 138, 137,
-         136, 135, 134, 133, 132, 131, 130, 129, 128, 127,
-         126, 125, 124, 123, 122, 121, 120, 119, 118, 117,
-         116, 115, 114, 113, 112, 111, 110, 109, 108, 107,
-         106, 103, 102, 101, 100, 97, 96, 95, 94, 93,
-         92, 88, 87, 86, 85, 84, 83, 82, 81, 80,
-         79, 78, 44, 44, 174, 77, 76, 72, 69, 68,
-         67, 62, 57, 50, 49, 47, 44, 174, 3, 174,
-         174, 174, 174, 174, 174, 174, 174, 174, 174, 174,
-
-         174, 174, 174, 174, 174, 174, 174, 174, 174, 174,
-         174, 174, 174, 174, 174, 174, 174, 174, 174, 174,
-         174, 174, 174, 174, 174, 174, 174, 174, 174, 174,
-         174
+         14, 15, 16, 17, 18, 19, 20, 4, 186, 174,
+         191, 24, 25, 26, 20, 20, 208, 28, 20, 20,
+         196, 30, 31, 32, 33, 180, 35, 36, 37, 38,
+         20, 20, 21, 22, 23, 3, 3, 49, 50, 57,
+         27, 62, 67, 68, 29, 69, 42, 43, 44, 34,
+         210, 210, 210, 210, 210, 210, 210, 210, 210, 210,
+         210, 210, 210, 210, 210, 210, 210, 210, 210, 210,
+         210, 210, 210, 210, 210, 210, 210, 210, 210, 210,
+         210, 210, 210, 210, 210, 210, 210, 210, 210, 210,
+
+         210, 210, 210, 3, 39, 39, 39, 40, 39, 39,
+         39, 39, 39, 39, 39, 39, 39, 39, 39, 39,
+         39, 41, 39, 39, 39, 39, 39, 39, 39, 39,
+         39, 39, 39, 39, 39, 39, 39, 39, 39, 39,
+         39, 39, 39, 39, 39, 39, 3, 3, 58, 3,
+         51, 72, 76, 77, 59, 60, 52, 42, 43, 53,
+         61, 78, 45, 46, 47, 3, 210, 210, 210, 210,
+         210, 210, 210, 210, 210, 210, 210, 48, 210, 210,
+         210, 210, 48, 210, 48, 48, 48, 48, 48, 48,
+         48, 48, 48, 48, 48, 48, 48, 48, 48, 48,
+
+         48, 48, 48, 48, 48, 48, 48, 48, 54, 63,
+         65, 3, 55, 70, 66, 64, 71, 73, 3, 74,
+         210, 39, 75, 44, 56, 3, 79, 80, 81, 42,
+         43, 82, 83, 84, 85, 39, 86, 44, 87, 88,
+         89, 92, 93, 94, 95, 96, 97, 100, 98, 101,
+         102, 103, 106, 104, 90, 91, 99, 105, 107, 108,
+         109, 110, 111, 112, 113, 114, 115, 116, 117, 118,
+         119, 120, 121, 122, 123, 124, 125, 126, 127, 128,
+         129, 130, 131, 132, 133, 134, 135, 136, 137, 138,
+         139, 140, 141, 142, 143, 144, 145, 146, 147, 148,
+
+         149, 150, 151, 152, 153, 154, 155, 156, 157, 158,
+         159, 160, 161, 162, 163, 164, 165, 166, 167, 168,
+         169, 170, 171, 172, 173, 50, 176, 177, 178, 179,
+         70, 182, 183, 203, 184, 185, 187, 188, 49, 189,
+         175, 190, 192, 193, 181, 194, 195, 197, 198, 51,
+         199, 200, 201, 64, 202, 52, 100, 205, 53, 204,
+         206, 207, 60, 209, 93, 0, 0, 61, 3, 210,
+         210, 210, 210, 210, 210, 210, 210, 210, 210, 210,
+         210, 210, 210, 210, 210, 210, 210, 210, 210, 210,
+         210, 210, 210, 210, 210, 210, 210, 210, 210, 210,
+
+         210, 210, 210, 210, 210, 210, 210, 210, 210, 210,
+         210
         };
 
-static yyconst flex_int16_t yy_chk[232] =
-        {0,
+static yyconst flex_int16_t yy_chk[412] =
+        {1,
          1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
          1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
          1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
          1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
-         1, 1, 7, 13, 13, 15, 15, 17, 17, 23,
-         24, 26, 43, 43, 24, 23, 7, 26, 23, 27,
-         34, 29, 39, 34, 27, 30, 24, 29, 36, 30,
-         36, 60, 70, 36, 75, 176, 39, 170, 75, 169,
-         70, 166, 165, 159, 158, 60, 60, 175, 175, 156,
-         155, 153, 149, 147, 146, 145, 144, 143, 142, 141,
-
-         140, 138, 137, 136, 135, 134, 132, 131, 130, 129,
-         128, 127, 125, 124, 122, 119, 118, 116, 115, 113,
-         112, 111, 110, 108, 107, 106, 105, 103, 102, 101,
-         100, 98, 97, 96, 95, 94, 91, 90, 89, 88,
-         87, 86, 85, 84, 83, 82, 81, 80, 79, 77,
-         76, 74, 73, 72, 71, 69, 68, 67, 64, 63,
-         62, 59, 58, 57, 56, 55, 54, 53, 52, 51,
-         50, 49, 44, 42, 41, 38, 37, 35, 33, 32,
-         31, 28, 25, 22, 21, 19, 14, 3, 174, 174,
-         174, 174, 174, 174, 174, 174, 174, 174, 174, 174,
-
-         174, 174, 174, 174, 174, 174, 174, 174, 174, 174,
-         174, 174, 174, 174, 174, 174, 174, 174, 174, 174,
-         174, 174, 174, 174, 174, 174, 174, 174, 174, 174,
-         174
+         1, 1, 2, 2, 2, 13, 14, 21, 22, 25,
+         2, 28, 31, 32, 2, 33, 13, 13, 14, 2,
+         3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+         3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+         3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+         3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+
+         3, 3, 3, 7, 7, 7, 7, 7, 7, 7,
+         7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+         7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+         7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+         7, 7, 7, 7, 7, 7, 15, 17, 26, 19,
+         23, 35, 37, 38, 26, 27, 23, 15, 15, 23,
+         27, 49, 17, 17, 19, 20, 20, 20, 20, 20,
+         20, 20, 20, 20, 20, 20, 20, 20, 20, 20,
+         20, 20, 20, 20, 20, 20, 20, 20, 20, 20,
+         20, 20, 20, 20, 20, 20, 20, 20, 20, 20,
+
+         20, 20, 20, 20, 20, 20, 20, 20, 24, 29,
+         30, 42, 24, 34, 30, 29, 34, 36, 43, 36,
+         41, 41, 36, 42, 24, 44, 50, 51, 52, 43,
+         43, 53, 54, 55, 56, 41, 57, 44, 58, 59,
+         60, 62, 63, 64, 67, 68, 69, 71, 70, 72,
+         73, 74, 76, 75, 60, 60, 70, 75, 77, 79,
+         80, 81, 82, 83, 84, 85, 86, 87, 88, 89,
+         90, 91, 94, 95, 96, 97, 98, 100, 101, 102,
+         103, 105, 106, 107, 108, 110, 111, 112, 113, 115,
+         116, 118, 119, 122, 124, 125, 127, 128, 129, 130,
+
+         131, 132, 134, 135, 136, 137, 138, 140, 141, 142,
+         143, 144, 145, 146, 147, 149, 153, 155, 156, 158,
+         159, 165, 166, 169, 170, 174, 175, 176, 177, 178,
+         180, 181, 182, 180, 183, 184, 186, 187, 186, 188,
+         174, 189, 191, 192, 180, 193, 194, 196, 197, 191,
+         198, 199, 200, 196, 201, 191, 203, 204, 191, 203,
+         205, 206, 208, 208, 197, 0, 0, 208, 210, 210,
+         210, 210, 210, 210, 210, 210, 210, 210, 210, 210,
+         210, 210, 210, 210, 210, 210, 210, 210, 210, 210,
+         210, 210, 210, 210, 210, 210, 210, 210, 210, 210,
+
+         210, 210, 210, 210, 210, 210, 210, 210, 210, 210,
+         210
         };
 
 /* Table of booleans, true if rule could match eol. */
-static yyconst flex_int32_t yy_rule_can_match_eol[57] =
+static yyconst flex_int32_t yy_rule_can_match_eol[64] =
         {0,
-         1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+         1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+         0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
          0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-         0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0,};
+         1, 0, 0,};
 
 static yy_state_type yy_last_accepting_state;
 static char *yy_last_accepting_cpos;
@@ -836,12 +889,12 @@ YY_DECL {
       }
       while (yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state) {
         yy_current_state = (int) yy_def[yy_current_state];
-        if (yy_current_state >= 175)
+        if (yy_current_state >= 211)
           yy_c = yy_meta[(unsigned int) yy_c];
       }
       yy_current_state = yy_nxt[yy_base[yy_current_state] + (unsigned int) yy_c];
       ++yy_cp;
-    } while (yy_base[yy_current_state] != 189);
+    } while (yy_base[yy_current_state] != 369);
 
     yy_find_action:
     yy_act = yy_accept[yy_current_state];
@@ -1182,82 +1235,82 @@ YY_DECL {
 #line 208 "minisql.l"
       {
         MinisqlParserMovePos(yylineno, yytext);
-        yylval.syntax_node = CreateSyntaxNode(kNodeIdentifier, yytext);
-        return IDENTIFIER;
+        return BUFFER;
       }
         YY_BREAK
       case 40:
         YY_RULE_SETUP
-#line 214 "minisql.l"
+#line 213 "minisql.l"
       {
         MinisqlParserMovePos(yylineno, yytext);
-        yylval.syntax_node = CreateSyntaxNode(kNodeNumber, yytext);
-        return NUMBER;
+        return STATUS;
       }
         YY_BREAK
       case 41:
         YY_RULE_SETUP
-#line 220 "minisql.l"
+#line 218 "minisql.l"
       {
         MinisqlParserMovePos(yylineno, yytext);
-        yylval.syntax_node = CreateSyntaxNode(kNodeNumber, yytext);
-        return NUMBER;
+        return ALTER;
       }
         YY_BREAK
       case 42:
         YY_RULE_SETUP
-#line 226 "minisql.l"
+#line 223 "minisql.l"
       {
         MinisqlParserMovePos(yylineno, yytext);
-        return EQ;
+        return CACHE;
       }
         YY_BREAK
       case 43:
         YY_RULE_SETUP
-#line 231 "minisql.l"
+#line 228 "minisql.l"
       {
         MinisqlParserMovePos(yylineno, yytext);
-        return NE;
+        return NOCACHE;
       }
         YY_BREAK
       case 44:
         YY_RULE_SETUP
-#line 236 "minisql.l"
+#line 233 "minisql.l"
       {
         MinisqlParserMovePos(yylineno, yytext);
-        return LE;
+        return SHRINK;
       }
         YY_BREAK
       case 45:
         YY_RULE_SETUP
-#line 241 "minisql.l"
+#line 238 "minisql.l"
       {
         MinisqlParserMovePos(yylineno, yytext);
-        return GE;
+        return IO;
       }
         YY_BREAK
       case 46:
         YY_RULE_SETUP
-#line 246 "minisql.l"
+#line 243 "minisql.l"
       {
         MinisqlParserMovePos(yylineno, yytext);
-        return (',');
+        yylval.syntax_node = CreateSyntaxNode(kNodeIdentifier, yytext);
+        return IDENTIFIER;
       }
         YY_BREAK
       case 47:
         YY_RULE_SETUP
-#line 251 "minisql.l"
+#line 249 "minisql.l"
       {
         MinisqlParserMovePos(yylineno, yytext);
-        return ('*');
+        yylval.syntax_node = CreateSyntaxNode(kNodeNumber, yytext);
+        return NUMBER;
       }
         YY_BREAK
       case 48:
         YY_RULE_SETUP
-#line 256 "minisql.l"
+#line 255 "minisql.l"
       {
         MinisqlParserMovePos(yylineno, yytext);
-        return (';');
+        yylval.syntax_node = CreateSyntaxNode(kNodeNumber, yytext);
+        return NUMBER;
       }
         YY_BREAK
       case 49:
@@ -1265,7 +1318,7 @@ YY_DECL {
 #line 261 "minisql.l"
       {
         MinisqlParserMovePos(yylineno, yytext);
-        return ('\'');
+        return EQ;
       }
         YY_BREAK
       case 50:
@@ -1273,7 +1326,7 @@ YY_DECL {
 #line 266 "minisql.l"
       {
         MinisqlParserMovePos(yylineno, yytext);
-        return ('<');
+        return NE;
       }
         YY_BREAK
       case 51:
@@ -1281,7 +1334,7 @@ YY_DECL {
 #line 271 "minisql.l"
       {
         MinisqlParserMovePos(yylineno, yytext);
-        return ('>');
+        return LE;
       }
         YY_BREAK
       case 52:
@@ -1289,7 +1342,7 @@ YY_DECL {
 #line 276 "minisql.l"
       {
         MinisqlParserMovePos(yylineno, yytext);
-        return ('(');
+        return GE;
       }
         YY_BREAK
       case 53:
@@ -1297,29 +1350,85 @@ YY_DECL {
 #line 281 "minisql.l"
       {
         MinisqlParserMovePos(yylineno, yytext);
-        return (')');
+        return (',');
       }
         YY_BREAK
       case 54:
-/* rule 54 can match eol */
         YY_RULE_SETUP
 #line 286 "minisql.l"
       {
         MinisqlParserMovePos(yylineno, yytext);
+        return ('*');
       }
         YY_BREAK
       case 55:
         YY_RULE_SETUP
-#line 290 "minisql.l"
+#line 291 "minisql.l"
+      {
+        MinisqlParserMovePos(yylineno, yytext);
+        return (';');
+      }
+        YY_BREAK
+      case 56:
+        YY_RULE_SETUP
+#line 296 "minisql.l"
+      {
+        MinisqlParserMovePos(yylineno, yytext);
+        return ('\'');
+      }
+        YY_BREAK
+      case 57:
+        YY_RULE_SETUP
+#line 301 "minisql.l"
+      {
+        MinisqlParserMovePos(yylineno, yytext);
+        return ('<');
+      }
+        YY_BREAK
+      case 58:
+        YY_RULE_SETUP
+#line 306 "minisql.l"
+      {
+        MinisqlParserMovePos(yylineno, yytext);
+        return ('>');
+      }
+        YY_BREAK
+      case 59:
+        YY_RULE_SETUP
+#line 311 "minisql.l"
+      {
+        MinisqlParserMovePos(yylineno, yytext);
+        return ('(');
+      }
+        YY_BREAK
+      case 60:
+        YY_RULE_SETUP
+#line 316 "minisql.l"
+      {
+        MinisqlParserMovePos(yylineno, yytext);
+        return (')');
+      }
+        YY_BREAK
+      case 61:
+/* rule 54 can match eol */
+        YY_RULE_SETUP
+#line 321 "minisql.l"
+      {
+        MinisqlParserMovePos(yylineno, yytext);
+      }
+        YY_BREAK
+      case 62:
+        YY_RULE_SETUP
+#line 325 "minisql.l"
       {
         char str[128] = {0};
         sprintf(str, "Unrecognized token [%s] in input sql.", yytext);
         MinisqlParserSetError(str);
       }
         YY_BREAK
-      case 56:
+      case 63:
         YY_RULE_SETUP
-#line 296 "minisql.l"
+#line 331 "minisql.l"
         ECHO;
         YY_BREAK
 #line 1314 "../../parser/minisql_lex.c"
@@ -1579,7 +1688,7 @@ static yy_state_type yy_get_previous_state(void) {
     }
     while (yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state) {
       yy_current_state = (int) yy_def[yy_current_state];
-      if (yy_current_state >= 175)
+      if (yy_current_state >= 211)
         yy_c = yy_meta[(unsigned int) yy_c];
     }
     yy_current_state = yy_nxt[yy_base[yy_current_state] + (unsigned int) yy_c];
@@ -1604,11 +1713,11 @@ static yy_state_type yy_try_NUL_trans(yy_state_type yy_current_state) {
   }
   while (yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state) {
     yy_current_state = (int) yy_def[yy_current_state];
-    if (yy_current_state >= 175)
+    if (yy_current_state >= 211)
       yy_c = yy_meta[(unsigned int) yy_c];
   }
   yy_current_state = yy_nxt[yy_base[yy_current_state] + (unsigned int) yy_c];
-  yy_is_jam = (yy_current_state == 174);
+  yy_is_jam = (yy_current_state == 210);
 
   return yy_is_jam ? 0 : yy_current_state;
 }
@@ -169,6 +169,16 @@ const char *GetSyntaxNodeTypeStr(SyntaxNodeType type) {
       return "kNodeTrxCommit";
     case kNodeTrxRollback:
       return "kNodeTrxRollback";
+    case kNodeShowBufferStatus:
+      return "kNodeShowBufferStatus";
+    case kNodeSetVariable:
+      return "kNodeSetVariable";
+    case kNodeAlterTableCache:
+      return "kNodeAlterTableCache";
+    case kNodeShrinkDB:
+      return "kNodeShrinkDB";
+    case kNodeShowIOStatus:
+      return "kNodeShowIOStatus";
     default:
       return "error type";
   }
@@ -0,0 +1,226 @@
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include "storage/async_io.h"
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>) && defined(__NR_io_uring_setup)
+#include <linux/io_uring.h>
+#define MINISQL_HAVE_IO_URING 1
+#endif
+
+AsyncIO::AsyncIO(int fd, size_t queue_depth, bool use_io_uring)
+    : fd_(fd), queue_depth_(std::max<size_t>(queue_depth, 1)) {
+  if (use_io_uring) {
+    SetupRing();
+  }
+}
+
+AsyncIO::~AsyncIO() {
+  {
+    std::scoped_lock<std::mutex> lock(pool_latch_);
+    pool_running_ = false;
+  }
+  pool_cv_.notify_all();
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+  if (ring_fd_ >= 0) {
+    munmap(sqes_, sqes_size_);
+    if (cq_ring_ != sq_ring_) {
+      munmap(cq_ring_, cq_ring_size_);
+    }
+    munmap(sq_ring_, sq_ring_size_);
+    close(ring_fd_);
+  }
+}
+
+void AsyncIO::Run(std::vector<AsyncIORequest> &requests, const std::function<void(size_t)> &on_complete) {
+  if (requests.empty()) {
+    return;
+  }
+  if (UsesIOUring()) {
+    RunRing(requests, on_complete);
+  } else {
+    RunThreads(requests, on_complete);
+  }
+}
+
+#ifdef MINISQL_HAVE_IO_URING
+
+bool AsyncIO::SetupRing() {
+  io_uring_params params{};
+  int ring_fd = static_cast<int>(syscall(__NR_io_uring_setup, static_cast<unsigned>(queue_depth_), &params));
+  if (ring_fd < 0) {
+    return false;
+  }
+  sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if (single_mmap) {
+    sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+  }
+  sq_ring_ =
+      mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQ_RING);
+  if (sq_ring_ == MAP_FAILED) {
+    close(ring_fd);
+    return false;
+  }
+  cq_ring_ = single_mmap ? sq_ring_
+                         : mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd,
+                                IORING_OFF_CQ_RING);
+  sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+  sqes_ = cq_ring_ == MAP_FAILED ? MAP_FAILED
+                                 : mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                        ring_fd, IORING_OFF_SQES);
+  if (cq_ring_ == MAP_FAILED || sqes_ == MAP_FAILED) {
+    if (cq_ring_ != MAP_FAILED && cq_ring_ != sq_ring_) {
+      munmap(cq_ring_, cq_ring_size_);
+    }
+    munmap(sq_ring_, sq_ring_size_);
+    close(ring_fd);
+    return false;
+  }
+  auto *sq = static_cast<char *>(sq_ring_);
+  auto *cq = static_cast<char *>(cq_ring_);
+  sq_tail_ = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+  sq_mask_ = reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+  sq_array_ = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+  cq_head_ = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+  cq_tail_ = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+  cq_mask_ = reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+  cqes_ = cq + params.cq_off.cqes;
+  ring_entries_ = params.sq_entries;
+  ring_fd_ = ring_fd;
+  return true;
+}
+
+// 1.   Fill the free submission slots with the next requests and submit them together with the ones the kernel did
+//      not take last time. io_uring_enter may consume fewer entries than asked, the rest stay in the ring.
+// 2.   Wait for a completion only if the kernel holds requests already, otherwise a call that consumes nothing would
+//      wait forever.
+// 3.   Reap every completion that has arrived and hand it to the callback.
+// 4.   Repeat until every request has completed.
+void AsyncIO::RunRing(std::vector<AsyncIORequest> &requests, const std::function<void(size_t)> &on_complete) {
+  std::scoped_lock<std::mutex> lock(ring_latch_);
+  auto *sqes = static_cast<io_uring_sqe *>(sqes_);
+  auto *cqes = static_cast<io_uring_cqe *>(cqes_);
+  size_t submitted = 0;   // requests put into the submission ring
+  size_t completed = 0;
+  unsigned pending = 0;   // requests in the submission ring the kernel has not consumed yet
+  while (completed < requests.size()) {
+    unsigned to_submit = pending;
+    unsigned tail = *sq_tail_;
+    while (submitted < requests.size() && submitted - completed < ring_entries_) {
+      AsyncIORequest &request = requests[submitted];
+      unsigned index = tail & *sq_mask_;
+      io_uring_sqe *sqe = &sqes[index];
+      memset(sqe, 0, sizeof(*sqe));
+      sqe->opcode = request.write_ ? IORING_OP_WRITEV : IORING_OP_READV;
+      sqe->fd = request.fd_ >= 0 ? request.fd_ : fd_;
+      sqe->addr = reinterpret_cast<uint64_t>(request.iov_);
+      sqe->len = static_cast<unsigned>(request.iov_count_);
+      sqe->off = static_cast<uint64_t>(request.offset_);
+      sqe->user_data = submitted;
+      sq_array_[index] = index;
+      tail++;
+      to_submit++;
+      submitted++;
+    }
+    __atomic_store_n(sq_tail_, tail, __ATOMIC_RELEASE);
+    bool wait = submitted - completed > to_submit;
+    int entered;
+    do {
+      entered = static_cast<int>(syscall(__NR_io_uring_enter, ring_fd_, to_submit, wait ? 1 : 0,
+                                         wait ? IORING_ENTER_GETEVENTS : 0, nullptr, 0));
+    } while (entered < 0 && errno == EINTR);
+    // out of resources or the completion ring is full: nothing was consumed, reap and try again
+    if (entered < 0 && (errno == EAGAIN || errno == EBUSY)) {
+      entered = 0;
+    }
+    ASSERT(entered >= 0, "io_uring_enter failed.");
+    pending = to_submit - static_cast<unsigned>(entered);
+
+    unsigned head = *cq_head_;
+    unsigned cq_tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    while (head != cq_tail) {
+      io_uring_cqe *cqe = &cqes[head & *cq_mask_];
+      size_t index = cqe->user_data;
+      requests[index].result_ = cqe->res;
+      head++;
+      completed++;
+      if (on_complete) {
+        on_complete(index);
+      }
+    }
+    __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+  }
+}
+
+#else
+
+bool AsyncIO::SetupRing() { return false; }
+
+void AsyncIO::RunRing(std::vector<AsyncIORequest> &requests, const std::function<void(size_t)> &on_complete) {
+  RunThreads(requests, on_complete);
+}
+
+#endif
+
+void AsyncIO::RunThreads(std::vector<AsyncIORequest> &requests, const std::function<void(size_t)> &on_complete) {
+  Batch batch;
+  batch.first_ = requests.data();
+  {
+    std::scoped_lock<std::mutex> lock(pool_latch_);
+    if (!pool_running_) {
+      pool_running_ = true;
+      for (size_t i = 0; i < std::min(ASYNC_IO_THREADS, queue_depth_); i++) {
+        workers_.emplace_back(&AsyncIO::RunWorker, this);
+      }
+    }
+    for (auto &request : requests) {
+      pool_queue_.emplace_back(&batch, &request);
+    }
+  }
+  pool_cv_.notify_all();
+  size_t completed = 0;
+  std::unique_lock<std::mutex> lock(batch.latch_);
+  while (completed < requests.size()) {
+    batch.cv_.wait(lock, [&] { return !batch.done_.empty(); });
+    size_t index = batch.done_.front();
+    batch.done_.pop_front();
+    completed++;
+    if (on_complete) {
+      lock.unlock();
+      on_complete(index);
+      lock.lock();
+    }
+  }
+}
+
+void AsyncIO::RunWorker() {
+  std::unique_lock<std::mutex> lock(pool_latch_);
+  while (true) {
+    pool_cv_.wait(lock, [&] { return !pool_running_ || !pool_queue_.empty(); });
+    if (!pool_running_) {
+      break;
+    }
+    auto [batch, request] = pool_queue_.front();
+    pool_queue_.pop_front();
+    lock.unlock();
+    int fd = request->fd_ >= 0 ? request->fd_ : fd_;
+    ssize_t result = request->write_ ? pwritev(fd, request->iov_, request->iov_count_, request->offset_)
+                                     : preadv(fd, request->iov_, request->iov_count_, request->offset_);
+    request->result_ = result < 0 ? -errno : result;
+    {
+      // notify under the latch, the batch lives on the stack of Run and is gone once Run has seen the last request
+      std::scoped_lock<std::mutex> batch_lock(batch->latch_);
+      batch->done_.push_back(request - batch->first_);
+      batch->cv_.notify_one();
+    }
+    lock.lock();
+  }
+}
@@ -1,36 +1,143 @@
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <string>
 #include <stdexcept>
 
 #include "glog/logging.h"
 #include "page/bitmap_page.h"
 #include "storage/disk_manager.h"
 
-DiskManager::DiskManager(const std::string &db_file) : file_name_(db_file) {
+static_assert(PAGE_SIZE % DISK_IO_ALIGNMENT == 0, "Pages must be whole O_DIRECT blocks.");
+
+DiskManager::DiskManager(const std::string &db_file, bool direct_io, bool read_only, int64_t segment_size)
+    : segment_size_(segment_size), read_only_(read_only), file_name_(db_file) {
+  ASSERT(segment_size_ >= 0 && segment_size_ % PAGE_SIZE == 0, "Segments must be whole pages.");
   std::scoped_lock<std::recursive_mutex> lock(db_io_latch_);
-  db_io_.open(db_file, std::ios::binary | std::ios::in | std::ios::out);
-  // directory or file does not exist
-  if (!db_io_.is_open()) {
-    db_io_.clear();
-    // create a new file
-    db_io_.open(db_file, std::ios::binary | std::ios::trunc | std::ios::out);
-    db_io_.close();
-    // reopen with original mode
-    db_io_.open(db_file, std::ios::binary | std::ios::in | std::ios::out);
-    if (!db_io_.is_open()) {
-      throw std::exception();
+  int fd = -1;
+  if (read_only_) {
+    fd = open(db_file.c_str(), O_RDONLY);
+  } else if (direct_io) {
+    // create the file if it does not exist
+    fd = open(db_file.c_str(), O_RDWR | O_CREAT | O_DIRECT, 0644);
+    if (fd >= 0) {
+      direct_io_.store(true, std::memory_order_relaxed);
+    } else if (errno == EINVAL) {
+      LOG(WARNING) << "O_DIRECT not supported for " << db_file << ", using buffered I/O";
     }
   }
+  if (fd < 0 && !read_only_) {
+    fd = open(db_file.c_str(), O_RDWR | O_CREAT, 0644);
+  }
+  if (fd < 0) {
+    throw std::exception();
+  }
+  struct stat stat_buf {};
+  if (fstat(fd, &stat_buf) != 0) {
+    close(fd);
+    throw std::exception();
+  }
+  if (segment_size_ > 0 && stat_buf.st_size > segment_size_) {
+    LOG(INFO) << db_file << " is larger than a segment, keeping it as one file";
+    segment_size_ = 0;
+  }
+  // a segment for every segment_size_ bytes of the largest database, whose physical page ids fill a page_id_t
+  int64_t max_size = (static_cast<int64_t>(std::numeric_limits<page_id_t>::max()) + 1) * PAGE_SIZE;
+  if (segment_size_ > 0) {
+    max_segments_ = std::min<size_t>((max_size + segment_size_ - 1) / segment_size_, MAX_SEGMENTS);
+  }
+  segment_fds_ = std::make_unique<std::atomic<int>[]>(max_segments_);
+  for (size_t segment = 0; segment < max_segments_; segment++) {
+    segment_fds_[segment].store(segment == 0 ? fd : -1, std::memory_order_relaxed);
+  }
+  file_size_.store(stat_buf.st_size, std::memory_order_relaxed);
+  if (read_only_) {
+    OpenSegments(O_RDONLY);
+  } else {
+    OpenSegments(O_RDWR | (IsDirectIO() ? O_DIRECT : 0));
+  }
   ReadPhysicalPage(META_PAGE_ID, meta_data_);
+  // a new file takes the page size of this build, an existing one must have been created with it
+  auto *meta_page = reinterpret_cast<DiskFileMetaPage *>(meta_data_);
+  uint32_t page_size = meta_page->GetPageSize();
+  if (page_size == 0 && meta_page->GetAllocatedPages() == 0 && meta_page->GetExtentNums() == 0) {
+    meta_page->page_size_ = PAGE_SIZE;
+  } else if (page_size != PAGE_SIZE) {
+    ReleaseFiles();
+    throw std::runtime_error(db_file + " was created with " +
+                             (page_size == 0 ? std::string("an unrecorded") : std::to_string(page_size) + " byte") +
+                             " page size, this build uses " + std::to_string(PAGE_SIZE) + " byte pages");
+  }
+}
+
+void DiskManager::OpenSegments(int flags) {
+  size_t segments = 1;
+  for (; segment_size_ > 0 && segments < max_segments_; segments++) {
+    int fd = open(GetSegmentFileName(segments).c_str(), flags);
+    if (fd < 0) {
+      break;
+    }
+    segment_fds_[segments].store(fd, std::memory_order_relaxed);
+  }
+  for (size_t segment = 0; segment < segments; segment++) {
+    int fd = segment_fds_[segment].load(std::memory_order_relaxed);
+    struct stat stat_buf {};
+    if (fstat(fd, &stat_buf) != 0) {
+      stat_buf.st_size = 0;
+    }
+    ExtendFileSize(static_cast<int64_t>(segment) * segment_size_ + stat_buf.st_size);
+    // an empty segment has nothing to map, every page of it reads as past the end
+    if (read_only_) {
+      void *mapping = stat_buf.st_size > 0 ? mmap(nullptr, stat_buf.st_size, PROT_READ, MAP_SHARED, fd, 0) : nullptr;
+      if (mapping == MAP_FAILED) {
+        LOG(ERROR) << "Failed to map " << GetSegmentFileName(segment) << ", reading it instead";
+        mapping = nullptr;
+      }
+      mappings_.emplace_back(static_cast<char *>(mapping), mapping == nullptr ? 0 : stat_buf.st_size);
+    }
+  }
 }
 
 void DiskManager::Close() {
   std::scoped_lock<std::recursive_mutex> lock(db_io_latch_);
   if (!closed) {
-    db_io_.close();
-    closed = true;
+    // the bitmap pages and the meta page are only written by Sync
+    Sync();
+    ReleaseFiles();
   }
 }
 
+void DiskManager::ReleaseFiles() {
+  async_io_.reset();
+  for (auto &mapping : mappings_) {
+    if (mapping.first != nullptr) {
+      munmap(mapping.first, mapping.second);
+    }
+  }
+  mappings_.clear();
+  for (size_t segment = 0; segment < max_segments_; segment++) {
+    int fd = segment_fds_[segment].exchange(-1, std::memory_order_relaxed);
+    if (fd >= 0) {
+      close(fd);
+    }
+  }
+  for (int fd : retired_fds_) {
+    close(fd);
+  }
+  retired_fds_.clear();
+  closed = true;
+}
+
 void DiskManager::ReadPage(page_id_t logical_page_id, char *page_data) {
   ASSERT(logical_page_id >= 0, "Invalid page id.");
   ReadPhysicalPage(MapPageId(logical_page_id), page_data);
@@ -38,119 +145,724 @@ void DiskManager::ReadPage(page_id_t logical_page_id, char *page_data) {
 
 void DiskManager::WritePage(page_id_t logical_page_id, const char *page_data) {
   ASSERT(logical_page_id >= 0, "Invalid page id.");
+  if (RejectWrite("page write")) {
+    return;
+  }
   WritePhysicalPage(MapPageId(logical_page_id), page_data);
 }
 
+// 1.   Map the pages to physical page ids and sort them, then group physically contiguous pages of a segment into runs.
+// 2.   Submit every run as one vectored write of a single batch, so that the runs are written in parallel.
+// 3.   Finish a run that was written short, or refused because of O_DIRECT, with synchronous writes.
+void DiskManager::WritePages(std::vector<std::pair<page_id_t, const char *>> &pages) {
+  if (RejectWrite("page write")) {
+    return;
+  }
+  for (auto &page : pages) {
+    ASSERT(page.first >= 0, "Invalid page id.");
+    page.first = MapPageId(page.first);
+  }
+  std::sort(pages.begin(), pages.end());
+  // page cleaner copies are not aligned, with O_DIRECT they go through one aligned buffer for the whole batch
+  std::unique_ptr<char, decltype(&free)> bounce(nullptr, &free);
+  char *next_bounce = nullptr;
+  if (IsDirectIO()) {
+    size_t unaligned = std::count_if(pages.begin(), pages.end(), [](auto &page) { return !IsAligned(page.second); });
+    if (unaligned > 0) {
+      bounce.reset(static_cast<char *>(aligned_alloc(DISK_IO_ALIGNMENT, unaligned * PAGE_SIZE)));
+      next_bounce = bounce.get();
+    }
+  }
+  std::vector<iovec> iov;
+  iov.reserve(pages.size());
+  std::vector<AsyncIORequest> requests;
+  // offset of every run in the database, across segments
+  std::vector<int64_t> run_offsets;
+  auto segment_pages = static_cast<size_t>(segment_size_ / PAGE_SIZE);
+  size_t i = 0;
+  while (i < pages.size()) {
+    page_id_t first = pages[i].first;
+    auto [segment, offset] = LocatePage(first);
+    size_t run_start = iov.size();
+    while (i < pages.size() && pages[i].first == first + static_cast<page_id_t>(iov.size() - run_start) &&
+           iov.size() - run_start < IOV_MAX &&
+           (iov.size() == run_start || segment_pages == 0 || pages[i].first % segment_pages != 0)) {
+      auto data = const_cast<char *>(pages[i].second);
+      if (next_bounce != nullptr && !IsAligned(data)) {
+        memcpy(next_bounce, data, PAGE_SIZE);
+        data = next_bounce;
+        next_bounce += PAGE_SIZE;
+      }
+      iov.push_back({data, PAGE_SIZE});
+      i++;
+    }
+    AsyncIORequest request;
+    request.write_ = true;
+    request.fd_ = GetSegmentFd(segment, true);
+    request.offset_ = offset;
+    request.iov_ = iov.data() + run_start;
+    request.iov_count_ = static_cast<int>(iov.size() - run_start);
+    if (request.fd_ < 0) {
+      LOG(ERROR) << "No segment file for page " << first << " of " << file_name_;
+      continue;
+    }
+    requests.push_back(request);
+    run_offsets.push_back(static_cast<int64_t>(first) * PAGE_SIZE);
+  }
+  // the requests of a batch are in flight together, each one is timed from the submission of the batch
+  auto start = std::chrono::steady_clock::now();
+  GetAsyncIO()->Run(requests, [&](size_t r) {
+    AsyncIORequest &request = requests[r];
+    ssize_t length = static_cast<ssize_t>(request.iov_count_) * PAGE_SIZE;
+    if (request.result_ == length) {
+      RecordIO(true, length, start);
+      ExtendFileSize(run_offsets[r] + length);
+      return;
+    }
+    if (request.result_ == -EINVAL && IsDirectIO()) {
+      DisableDirectIO();
+    }
+    WriteRun(request.iov_, request.iov_count_, run_offsets[r]);
+  });
+}
+
+void DiskManager::ReadPages(std::vector<std::pair<page_id_t, char *>> &pages,
+                            const std::function<void(size_t)> &on_read) {
+  // the pages of a mapped file are a copy away
+  if (IsReadOnly()) {
+    for (size_t i = 0; i < pages.size(); i++) {
+      ReadPage(pages[i].first, pages[i].second);
+      if (on_read) {
+        on_read(i);
+      }
+    }
+    return;
+  }
+  std::vector<iovec> iov(pages.size());
+  std::vector<AsyncIORequest> requests;
+  std::vector<size_t> page_index;
+  for (size_t i = 0; i < pages.size(); i++) {
+    ASSERT(pages[i].first >= 0, "Invalid page id.");
+    page_id_t physical_page_id = MapPageId(pages[i].first);
+    auto [segment, offset] = LocatePage(physical_page_id);
+    int fd = GetSegmentFd(segment, false);
+    // pages past the end of the file and unaligned buffers with O_DIRECT are read right away
+    if (static_cast<int64_t>(physical_page_id) * PAGE_SIZE >= file_size_.load(std::memory_order_relaxed) || fd < 0 ||
+        (IsDirectIO() && !IsAligned(pages[i].second))) {
+      ReadPage(pages[i].first, pages[i].second);
+      if (on_read) {
+        on_read(i);
+      }
+      continue;
+    }
+    iov[i] = {pages[i].second, PAGE_SIZE};
+    AsyncIORequest request;
+    request.fd_ = fd;
+    request.offset_ = offset;
+    request.iov_ = &iov[i];
+    request.iov_count_ = 1;
+    requests.push_back(request);
+    page_index.push_back(i);
+  }
+  auto start = std::chrono::steady_clock::now();
+  GetAsyncIO()->Run(requests, [&](size_t r) {
+    size_t i = page_index[r];
+    // a short read at the end of the file, or a read refused because of O_DIRECT
+    if (requests[r].result_ != PAGE_SIZE) {
+      if (requests[r].result_ == -EINVAL && IsDirectIO()) {
+        DisableDirectIO();
+      }
+      ReadPage(pages[i].first, pages[i].second);
+    } else {
+      RecordIO(false, PAGE_SIZE, start);
+    }
+    if (on_read) {
+      on_read(i);
+    }
+  });
+}
+
+void DiskManager::Sync() {
+  // nothing was written
+  if (IsReadOnly()) {
+    return;
+  }
+  std::scoped_lock<std::recursive_mutex> lock(db_io_latch_);
+  for (size_t extIndex = 0; extIndex < bitmaps_.size(); extIndex++) {
+    if (bitmap_dirty_[extIndex]) {
+      WritePhysicalPage(getBitmapPhyIdFromExtIndex(extIndex), reinterpret_cast<char *>(bitmaps_[extIndex].get()));
+      bitmap_dirty_[extIndex] = false;
+    }
+  }
+  for (size_t group = 1; group <= directories_.size(); group++) {
+    if (directory_dirty_[group - 1]) {
+      WritePhysicalPage(getDirectoryPhyIdFromGroup(group), reinterpret_cast<char *>(directories_[group - 1].get()));
+      directory_dirty_[group - 1] = false;
+    }
+  }
+  WritePhysicalPage(META_PAGE_ID, meta_data_);
+  for (size_t segment = 0; segment < max_segments_; segment++) {
+    int fd = segment_fds_[segment].load(std::memory_order_relaxed);
+    if (fd < 0) {
+      break;
+    }
+    if (fsync(fd) != 0) {
+      LOG(ERROR) << "I/O error while syncing";
+    }
+  }
+  PunchFreedPages();
+}
+
+// 1.   Find the last allocated page, in the last extent with a used page.
+// 2.   Forget the extents after it and sync, an interrupted shrink leaves free pages at the end of the file behind.
+// 3.   Truncate the segment holding the end and remove the segments after it, they only hold free pages. Page I/O
+//      loads the descriptors without the latch, so a removed segment is emptied and unlinked but its descriptor is
+//      kept open until Close: a reader that loaded it reads zeros instead of another file reusing the number.
+int64_t DiskManager::Shrink() {
+  if (RejectWrite("shrink")) {
+    return 0;
+  }
+  std::scoped_lock<std::recursive_mutex> lock(db_io_latch_);
+  auto *meta_page = reinterpret_cast<DiskFileMetaPage *>(this->GetMetaData());
+  size_t extents = std::min<size_t>(meta_page->GetExtentNums(), MAX_EXTENTS);
+  while (extents > 0 && ExtentUsedPages(extents - 1) == 0) {
+    extents--;
+  }
+  // an empty database keeps its meta page
+  page_id_t end = META_PAGE_ID + 1;
+  if (extents > 0) {
+    uint32_t offset;
+    // a bitmap disagreeing with its counter keeps the whole extent
+    end = GetBitmap(extents - 1)->FindLastAllocated(offset)
+              ? MapPageId(static_cast<page_id_t>(BITMAP_SIZE * (extents - 1) + offset)) + 1
+              : getBitmapPhyIdFromExtIndex(extents - 1) + 1 + static_cast<page_id_t>(BITMAP_SIZE);
+  }
+  meta_page->num_extents_ = static_cast<uint32_t>(extents);
+  if (bitmaps_.size() > extents) {
+    bitmaps_.resize(extents);
+    bitmap_dirty_.resize(extents);
+  }
+  size_t groups = extents == 0 ? 0 : (extents - 1) / EXTENTS_PER_DIRECTORY_PAGE;
+  if (directories_.size() > groups) {
+    directories_.resize(groups);
+    directory_dirty_.resize(groups);
+  }
+  first_free_extent_ = std::min(first_free_extent_, extents);
+  freed_pages_.erase(std::remove_if(freed_pages_.begin(), freed_pages_.end(),
+                                    [&](page_id_t logical_page_id) { return MapPageId(logical_page_id) >= end; }),
+                     freed_pages_.end());
+  Sync();
+
+  int64_t old_size = GetFileSize();
+  int64_t new_size = static_cast<int64_t>(end) * PAGE_SIZE;
+  if (new_size >= old_size) {
+    return 0;
+  }
+  auto [segment, offset] = LocatePage(end);
+  // a segment starting at the end is removed, not left empty
+  if (segment > 0 && offset == 0) {
+    segment--;
+    offset = segment_size_;
+  }
+  int fd = GetSegmentFd(segment, false);
+  if (fd >= 0 && ftruncate(fd, offset) != 0) {
+    LOG(ERROR) << "I/O error while truncating";
+    return 0;
+  }
+  for (size_t next = segment + 1; next < max_segments_; next++) {
+    int next_fd = segment_fds_[next].exchange(-1, std::memory_order_acq_rel);
+    if (next_fd < 0) {
+      break;
+    }
+    if (ftruncate(next_fd, 0) != 0) {
+      LOG(ERROR) << "I/O error while truncating";
+    }
+    retired_fds_.push_back(next_fd);
+    if (unlink(GetSegmentFileName(next).c_str()) != 0) {
+      LOG(ERROR) << "Failed to remove " << GetSegmentFileName(next);
+    }
+  }
+  file_size_.store(new_size, std::memory_order_relaxed);
+  return old_size - new_size;
+}
+
+void DiskManager::AdviseWillNeed(const std::vector<page_id_t> &logical_page_ids) {
+  // direct reads do not go through the page cache the advice would fill
+  if (IsDirectIO()) {
+    return;
+  }
+  auto segment_pages = static_cast<size_t>(segment_size_ / PAGE_SIZE);
+  size_t i = 0;
+  while (i < logical_page_ids.size()) {
+    page_id_t first = MapPageId(logical_page_ids[i]);
+    size_t count = 1;
+    while (i + count < logical_page_ids.size() &&
+           MapPageId(logical_page_ids[i + count]) == first + static_cast<page_id_t>(count) &&
+           (segment_pages == 0 || (first + count) % segment_pages != 0)) {
+      count++;
+    }
+    auto [segment, offset] = LocatePage(first);
+    int fd = GetSegmentFd(segment, false);
+    if (fd >= 0) {
+      posix_fadvise(fd, offset, static_cast<off_t>(count) * PAGE_SIZE, POSIX_FADV_WILLNEED);
+    }
+    i += count;
+  }
+}
+
+// 1.   Start at the first extent that may have a free page, and skip the extents the directory shows as full.
+// 2.   Allocate the first free page of the extent from its cached bitmap, the bitmap is written back at the next Sync.
 page_id_t DiskManager::AllocatePage() {
+  if (RejectWrite("page allocation")) {
+    return INVALID_PAGE_ID;
+  }
+  std::scoped_lock<std::recursive_mutex> lock(db_io_latch_);
   auto *meta_page = reinterpret_cast<DiskFileMetaPage *>(this->GetMetaData());
   size_t ExtNums = meta_page->GetExtentNums();
 
-  for (size_t extIndex = 0; extIndex <= ExtNums; extIndex++) {
-    if (meta_page->extent_used_page_[extIndex] != BITMAP_SIZE) {
-      page_id_t bitmapPhyId = getBitmapPhyIdFromExtIndex(extIndex);
-      auto *bitmapPage = new BitmapPage<PAGE_SIZE>();
-
-      ReadPhysicalPage(bitmapPhyId, (char *)(bitmapPage));
-      uint32_t offset;
-      if (!bitmapPage->AllocatePage(offset)) {
-        continue;
+  for (size_t extIndex = first_free_extent_; extIndex <= ExtNums && extIndex < MAX_EXTENTS; extIndex++) {
+    if (ExtentUsedPages(extIndex) == BITMAP_SIZE) {
+      if (extIndex == first_free_extent_) {
+        first_free_extent_++;
       }
-      WritePhysicalPage(bitmapPhyId, (char *)(bitmapPage));
-      meta_page->num_allocated_pages_++;
-      meta_page->num_extents_ = extIndex + 1;
-      meta_page->extent_used_page_[extIndex]++;
-      return (page_id_t)(offset + BITMAP_SIZE * extIndex);
+      continue;
+    }
+    uint32_t offset;
+    if (GetBitmap(extIndex)->AllocatePage(offset)) {
+      return RecordAllocation(extIndex, offset);
     }
   }
   return INVALID_PAGE_ID;
 }
 
+// 1.   Take a page of the run holding the near page, after it if possible.
+// 2.   Otherwise start an empty run. Search forward from the near page first, so that an object grows towards the end
+//      of the file the way its scans read it, then the extents before it, then a new extent.
+// 3.   Without an empty run left, fall back to the first free page anywhere.
+page_id_t DiskManager::AllocatePageNear(page_id_t near_page_id) {
+  if (!page_runs_.load(std::memory_order_relaxed)) {
+    return AllocatePage();
+  }
+  if (RejectWrite("page allocation")) {
+    return INVALID_PAGE_ID;
+  }
+  std::scoped_lock<std::recursive_mutex> lock(db_io_latch_);
+  auto *meta_page = reinterpret_cast<DiskFileMetaPage *>(this->GetMetaData());
+  size_t ExtNums = std::min<size_t>(meta_page->GetExtentNums(), MAX_EXTENTS);
+  uint32_t offset;
+  size_t near_extent = first_free_extent_;
+  uint32_t near_run = 0;
+  if (near_page_id >= 0) {
+    near_extent = near_page_id / BITMAP_SIZE;
+    near_run = near_page_id % BITMAP_SIZE / BitmapPage<PAGE_SIZE>::RUN_PAGES + 1;
+    if (near_extent < MAX_EXTENTS && GetBitmap(near_extent)->AllocatePageInRun(near_page_id % BITMAP_SIZE, offset)) {
+      return RecordAllocation(near_extent, offset);
+    }
+  }
+  auto try_extent = [&](size_t extIndex, uint32_t first_run) {
+    // an extent with fewer free pages than a run cannot have an empty one
+    return BITMAP_SIZE - ExtentUsedPages(extIndex) >= BitmapPage<PAGE_SIZE>::RUN_PAGES &&
+           GetBitmap(extIndex)->AllocateEmptyRun(first_run, offset);
+  };
+  for (size_t extIndex = near_extent; extIndex < ExtNums; extIndex++) {
+    if (try_extent(extIndex, extIndex == near_extent ? near_run : 0)) {
+      return RecordAllocation(extIndex, offset);
+    }
+  }
+  for (size_t extIndex = first_free_extent_; extIndex < std::min(near_extent + 1, ExtNums); extIndex++) {
+    if (try_extent(extIndex, 0)) {
+      return RecordAllocation(extIndex, offset);
+    }
+  }
+  if (ExtNums < MAX_EXTENTS && try_extent(ExtNums, 0)) {
+    return RecordAllocation(ExtNums, offset);
+  }
+  return AllocatePage();
+}
+
 void DiskManager::DeAllocatePage(page_id_t logical_page_id) {
+  if (RejectWrite("page deallocation")) {
+    return;
+  }
+  std::scoped_lock<std::recursive_mutex> lock(db_io_latch_);
   auto *meta_page = reinterpret_cast<DiskFileMetaPage *>(this->GetMetaData());
   page_id_t phyPageId = MapPageId(logical_page_id);
   uint extIndex = getExtIndexFromPhyPageId(phyPageId);
-  page_id_t bitmapPhyId = getBitmapPhyIdFromExtIndex(extIndex);
-  auto *bitmapPage = new BitmapPage<PAGE_SIZE>();
-
-  ReadPhysicalPage(bitmapPhyId, (char *)(bitmapPage));
   uint32_t offset = getOffsetFromPhyId(phyPageId);
-  bitmapPage->DeAllocatePage(offset);
-  WritePhysicalPage(bitmapPhyId, (char *)(bitmapPage));
+  // a page that is free already is not counted twice
+  if (extIndex >= MAX_EXTENTS || !GetBitmap(extIndex)->DeAllocatePage(offset)) {
+    return;
+  }
+  bitmap_dirty_[extIndex] = true;
   meta_page->num_allocated_pages_--;
-  meta_page->extent_used_page_[extIndex]--;
+  ExtentUsedPages(extIndex)--;
+  MarkDirectoryDirty(extIndex);
+  first_free_extent_ = std::min<size_t>(first_free_extent_, extIndex);
+  if (PunchesHoles()) {
+    freed_pages_.push_back(logical_page_id);
+  }
 }
 
 bool DiskManager::IsPageFree(page_id_t logical_page_id) {
+  std::scoped_lock<std::recursive_mutex> lock(db_io_latch_);
   page_id_t physicalPageId = MapPageId(logical_page_id);
   uint32_t bitMapPageIndex = getExtIndexFromPhyPageId(physicalPageId);
   uint32_t pageOffset = getOffsetFromPhyId(physicalPageId);
-  auto bitmapPhyId = getBitmapPhyIdFromExtIndex(bitMapPageIndex);
-  auto *bitmapPage = new BitmapPage<PAGE_SIZE>();
-
-  ReadPhysicalPage(bitmapPhyId, (char *)(bitmapPage));
-  if (bitmapPage->IsPageFree(pageOffset)) {
+  if (bitMapPageIndex >= MAX_EXTENTS) {
     return true;
   }
-  return false;
+  return GetBitmap(bitMapPageIndex)->IsPageFree(pageOffset);
 }
 
-page_id_t DiskManager::MapPageId(page_id_t logical_page_id) {
-  auto N = (page_id_t)(logical_page_id / BITMAP_SIZE);
-  auto n = (page_id_t)(logical_page_id % BITMAP_SIZE);
-  return (page_id_t)(2 + N * (BITMAP_SIZE + 1) + n);
+char *DiskManager::GetMappedPage(page_id_t logical_page_id) {
+  ASSERT(logical_page_id >= 0, "Invalid page id.");
+  auto [segment, offset] = LocatePage(MapPageId(logical_page_id));
+  if (segment >= mappings_.size() || mappings_[segment].first == nullptr ||
+      static_cast<size_t>(offset) + PAGE_SIZE > mappings_[segment].second) {
+    return nullptr;
+  }
+  return mappings_[segment].first + offset;
 }
 
-int DiskManager::GetFileSize(const std::string &file_name) {
-  struct stat stat_buf {};
-  int rc = stat(file_name.c_str(), &stat_buf);
-  return rc == 0 ? stat_buf.st_size : -1;
+size_t DiskManager::GetSegmentCount() {
+  size_t segments = 0;
+  while (segments < max_segments_ && segment_fds_[segments].load(std::memory_order_relaxed) >= 0) {
+    segments++;
+  }
+  return segments;
+}
+
+DiskIOStats DiskManager::GetIOStats() const {
+  DiskIOStats stats;
+  stats.reads_ = reads_.load(std::memory_order_relaxed);
+  stats.read_bytes_ = read_bytes_.load(std::memory_order_relaxed);
+  stats.writes_ = writes_.load(std::memory_order_relaxed);
+  stats.written_bytes_ = written_bytes_.load(std::memory_order_relaxed);
+  for (size_t bucket = 0; bucket < LatencyHistogram::BUCKETS; bucket++) {
+    stats.read_latency_.buckets_[bucket] = read_latency_[bucket].load(std::memory_order_relaxed);
+    stats.write_latency_.buckets_[bucket] = write_latency_[bucket].load(std::memory_order_relaxed);
+  }
+  return stats;
+}
+
+void DiskManager::RecordIO(bool write, int64_t bytes, std::chrono::steady_clock::time_point start) {
+  auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+  size_t bucket = LatencyHistogram::Bucket(static_cast<uint64_t>(nanoseconds.count()));
+  if (write) {
+    writes_.fetch_add(1, std::memory_order_relaxed);
+    written_bytes_.fetch_add(bytes, std::memory_order_relaxed);
+    write_latency_[bucket].fetch_add(1, std::memory_order_relaxed);
+  } else {
+    reads_.fetch_add(1, std::memory_order_relaxed);
+    read_bytes_.fetch_add(bytes, std::memory_order_relaxed);
+    read_latency_[bucket].fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+uint32_t DiskManager::GetExtentUsedPages(size_t extent_index) {
+  std::scoped_lock<std::recursive_mutex> lock(db_io_latch_);
+  return extent_index < MAX_EXTENTS ? ExtentUsedPages(extent_index) : 0;
+}
+
+page_id_t DiskManager::MapPageId(page_id_t logical_page_id) {
+  auto N = (size_t)(logical_page_id / BITMAP_SIZE);
+  auto n = (size_t)(logical_page_id % BITMAP_SIZE);
+  return (page_id_t)(getBitmapPhyIdFromExtIndex(N) + 1 + n);
 }
 
 void DiskManager::ReadPhysicalPage(page_id_t physical_page_id, char *page_data) {
-  int offset = physical_page_id * PAGE_SIZE;
+  auto [segment, offset] = LocatePage(physical_page_id);
+  if (segment < mappings_.size() && mappings_[segment].first != nullptr &&
+      static_cast<size_t>(offset) + PAGE_SIZE <= mappings_[segment].second) {
+    memcpy(page_data, mappings_[segment].first + offset, PAGE_SIZE);
+    return;
+  }
+  int fd = GetSegmentFd(segment, false);
   // check if read beyond file length
-  if (offset >= GetFileSize(file_name_)) {
+  if (static_cast<int64_t>(physical_page_id) * PAGE_SIZE >= file_size_.load(std::memory_order_relaxed) || fd < 0) {
 #ifdef ENABLE_BPM_DEBUG
     LOG(INFO) << "Read less than a page" << std::endl;
 #endif
     memset(page_data, 0, PAGE_SIZE);
-  } else {
-    // set read cursor to offset
-    db_io_.seekp(offset);
-    db_io_.read(page_data, PAGE_SIZE);
-    // if file ends before reading PAGE_SIZE
-    int read_count = db_io_.gcount();
-    if (read_count < PAGE_SIZE) {
+    return;
+  }
+  if (IsDirectIO() && !IsAligned(page_data)) {
+    alignas(DISK_IO_ALIGNMENT) static thread_local char bounce[PAGE_SIZE];
+    ReadPhysicalPage(physical_page_id, bounce);
+    memcpy(page_data, bounce, PAGE_SIZE);
+    return;
+  }
+  ssize_t read_count = 0;
+  while (read_count < PAGE_SIZE) {
+    auto start = std::chrono::steady_clock::now();
+    ssize_t count = pread(fd, page_data + read_count, PAGE_SIZE - read_count, offset + read_count);
+    if (count < 0 && errno == EINVAL && IsDirectIO()) {
+      DisableDirectIO();
+      continue;
+    }
+    if (count < 0) {
+      LOG(ERROR) << "I/O error while reading";
+      break;
+    }
+    if (count == 0) {
+      break;
+    }
+    RecordIO(false, count, start);
+    read_count += count;
+  }
+  // if file ends before reading PAGE_SIZE
+  if (read_count < PAGE_SIZE) {
 #ifdef ENABLE_BPM_DEBUG
-      LOG(INFO) << "Read less than a page" << std::endl;
+    LOG(INFO) << "Read less than a page" << std::endl;
 #endif
-      memset(page_data + read_count, 0, PAGE_SIZE - read_count);
-    }
+    memset(page_data + read_count, 0, PAGE_SIZE - read_count);
   }
 }
 
 void DiskManager::WritePhysicalPage(page_id_t physical_page_id, const char *page_data) {
-  size_t offset = static_cast<size_t>(physical_page_id) * PAGE_SIZE;
-  // set write cursor to offset
-  db_io_.seekp(offset);
-  db_io_.write(page_data, PAGE_SIZE);
-  // check for I/O error
-  if (db_io_.bad()) {
-    LOG(ERROR) << "I/O error while writing";
+  if (IsDirectIO() && !IsAligned(page_data)) {
+    alignas(DISK_IO_ALIGNMENT) static thread_local char bounce[PAGE_SIZE];
+    memcpy(bounce, page_data, PAGE_SIZE);
+    WritePhysicalPage(physical_page_id, bounce);
+    return;
+  }
+  auto [segment, offset] = LocatePage(physical_page_id);
+  int fd = GetSegmentFd(segment, true);
+  if (fd < 0) {
+    LOG(ERROR) << "No segment file for physical page " << physical_page_id << " of " << file_name_;
+    return;
+  }
+  ssize_t written = 0;
+  while (written < PAGE_SIZE) {
+    auto start = std::chrono::steady_clock::now();
+    ssize_t count = pwrite(fd, page_data + written, PAGE_SIZE - written, offset + written);
+    if (count < 0 && errno == EINVAL && IsDirectIO()) {
+      DisableDirectIO();
+      continue;
+    }
+    // check for I/O error
+    if (count <= 0) {
+      LOG(ERROR) << "I/O error while writing";
+      break;
+    }
+    RecordIO(true, count, start);
+    written += count;
+  }
+  ExtendFileSize(static_cast<int64_t>(physical_page_id) * PAGE_SIZE + written);
+}
+
+void DiskManager::WriteRun(const iovec *iov, int iov_count, int64_t offset) {
+  auto [segment, segment_offset] = LocatePage(static_cast<page_id_t>(offset / PAGE_SIZE));
+  int fd = GetSegmentFd(segment, true);
+  if (fd < 0) {
+    LOG(ERROR) << "No segment file for offset " << offset << " of " << file_name_;
+    return;
+  }
+  int done = 0;
+  while (done < iov_count) {
+    auto start = std::chrono::steady_clock::now();
+    ssize_t written = pwritev(fd, iov + done, iov_count - done, segment_offset);
+    if (written < 0 && errno == EINVAL && IsDirectIO()) {
+      DisableDirectIO();
+      continue;
+    }
+    if (written < 0) {
+      LOG(ERROR) << "I/O error while writing";
+      return;
+    }
+    RecordIO(true, written, start);
+    // a short write ends on a page boundary unless the device is full, continue after the pages written
+    done += static_cast<int>(written / PAGE_SIZE);
+    offset += written / PAGE_SIZE * PAGE_SIZE;
+    segment_offset += written / PAGE_SIZE * PAGE_SIZE;
+    ExtendFileSize(offset);
+    if (written % PAGE_SIZE != 0) {
+      LOG(ERROR) << "I/O error while writing";
+      return;
+    }
+  }
+}
+
+// 1.   Keep the pages still free, a page allocated again since it was freed may hold data by now.
+// 2.   Punch every run of physically contiguous pages of a segment with one fallocate, skipping pages never written.
+void DiskManager::PunchFreedPages() {
+  if (freed_pages_.empty()) {
+    return;
+  }
+  std::vector<page_id_t> pages;
+  for (page_id_t logical_page_id : freed_pages_) {
+    if (IsPageFree(logical_page_id)) {
+      pages.push_back(MapPageId(logical_page_id));
+    }
+  }
+  freed_pages_.clear();
+  std::sort(pages.begin(), pages.end());
+  pages.erase(std::unique(pages.begin(), pages.end()), pages.end());
+  auto segment_pages = static_cast<size_t>(segment_size_ / PAGE_SIZE);
+  size_t i = 0;
+  while (i < pages.size() && PunchesHoles()) {
+    page_id_t first = pages[i];
+    size_t count = 1;
+    while (i + count < pages.size() && pages[i + count] == first + static_cast<page_id_t>(count) &&
+           (segment_pages == 0 || (first + count) % segment_pages != 0)) {
+      count++;
+    }
+    i += count;
+    auto [segment, offset] = LocatePage(first);
+    int fd = GetSegmentFd(segment, false);
+    if (fd < 0 || static_cast<int64_t>(first) * PAGE_SIZE >= GetFileSize()) {
+      continue;
+    }
+    if (fallocate(fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, offset, static_cast<off_t>(count) * PAGE_SIZE) == 0) {
+      continue;
+    }
+    if (errno == EOPNOTSUPP || errno == ENOSYS) {
+      punch_holes_.store(false, std::memory_order_relaxed);
+      LOG(WARNING) << "Hole punching not supported for " << file_name_ << ", deallocated pages keep their blocks";
+    } else {
+      LOG(ERROR) << "I/O error while punching a hole";
+    }
+  }
+}
+
+page_id_t DiskManager::RecordAllocation(size_t extent_index, uint32_t offset) {
+  auto *meta_page = reinterpret_cast<DiskFileMetaPage *>(this->GetMetaData());
+  bitmap_dirty_[extent_index] = true;
+  meta_page->num_allocated_pages_++;
+  meta_page->num_extents_ = std::max<uint32_t>(meta_page->num_extents_, extent_index + 1);
+  ExtentUsedPages(extent_index)++;
+  MarkDirectoryDirty(extent_index);
+  return static_cast<page_id_t>(offset + BITMAP_SIZE * extent_index);
+}
+
+BitmapPage<PAGE_SIZE> *DiskManager::GetBitmap(size_t extent_index) {
+  if (extent_index >= bitmaps_.size()) {
+    bitmaps_.resize(extent_index + 1);
+    bitmap_dirty_.resize(extent_index + 1, false);
+  }
+  if (bitmaps_[extent_index] == nullptr) {
+    bitmaps_[extent_index] = std::make_unique<BitmapPage<PAGE_SIZE>>();
+    ReadPhysicalPage(getBitmapPhyIdFromExtIndex(extent_index), reinterpret_cast<char *>(bitmaps_[extent_index].get()));
+  }
+  return bitmaps_[extent_index].get();
+}
+
+uint32_t &DiskManager::ExtentUsedPages(size_t extent_index) {
+  size_t group = extent_index / EXTENTS_PER_DIRECTORY_PAGE;
+  if (group == 0) {
+    return reinterpret_cast<DiskFileMetaPage *>(meta_data_)->extent_used_page_[extent_index];
+  }
+  if (group > directories_.size()) {
+    directories_.resize(group);
+    directory_dirty_.resize(group, false);
+  }
+  auto &directory = directories_[group - 1];
+  if (directory == nullptr) {
+    directory.reset(static_cast<DiskFileMetaPage *>(aligned_alloc(DISK_IO_ALIGNMENT, PAGE_SIZE)));
+    ReadPhysicalPage(getDirectoryPhyIdFromGroup(group), reinterpret_cast<char *>(directory.get()));
+  }
+  return directory->extent_used_page_[extent_index % EXTENTS_PER_DIRECTORY_PAGE];
+}
+
+void DiskManager::MarkDirectoryDirty(size_t extent_index) {
+  // the meta page is written by every Sync
+  size_t group = extent_index / EXTENTS_PER_DIRECTORY_PAGE;
+  if (group > 0) {
+    directory_dirty_[group - 1] = true;
+  }
+}
+
+std::pair<size_t, off_t> DiskManager::LocatePage(page_id_t physical_page_id) const {
+  int64_t offset = static_cast<int64_t>(physical_page_id) * PAGE_SIZE;
+  if (segment_size_ == 0) {
+    return {0, offset};
+  }
+  return {static_cast<size_t>(offset / segment_size_), offset % segment_size_};
+}
+
+int DiskManager::GetSegmentFd(size_t segment, bool create) {
+  if (segment >= max_segments_) {
+    return -1;
+  }
+  int fd = segment_fds_[segment].load(std::memory_order_acquire);
+  if (fd >= 0 || !create) {
+    return fd;
+  }
+  std::scoped_lock<std::recursive_mutex> lock(db_io_latch_);
+  // segments are created in order, so that opening the database finds all of them
+  for (size_t next = 1; next <= segment; next++) {
+    if (segment_fds_[next].load(std::memory_order_relaxed) >= 0) {
+      continue;
+    }
+    int flags = O_RDWR | O_CREAT | (IsDirectIO() ? O_DIRECT : 0);
+    int next_fd = open(GetSegmentFileName(next).c_str(), flags, 0644);
+    if (next_fd < 0) {
+      LOG(ERROR) << "Failed to create " << GetSegmentFileName(next);
+      return -1;
+    }
+    segment_fds_[next].store(next_fd, std::memory_order_release);
+  }
+  return segment_fds_[segment].load(std::memory_order_relaxed);
+}
+
+std::string DiskManager::GetSegmentFileName(size_t segment) const {
+  return segment == 0 ? file_name_ : file_name_ + "." + std::to_string(segment);
+}
+
+AsyncIO *DiskManager::GetAsyncIO() {
+  std::call_once(async_io_once_,
+                 [this] { async_io_ = std::make_unique<AsyncIO>(segment_fds_[0].load(std::memory_order_relaxed)); });
+  return async_io_.get();
+}
+
+void DiskManager::ExtendFileSize(int64_t end) {
+  int64_t size = file_size_.load(std::memory_order_relaxed);
+  while (end > size && !file_size_.compare_exchange_weak(size, end, std::memory_order_relaxed)) {
+  }
+}
+
+bool DiskManager::RejectWrite(const char *operation) {
+  if (!IsReadOnly()) {
+    return false;
+  }
+  LOG(ERROR) << "Rejected " << operation << " to read-only database " << file_name_;
+  return true;
+}
+
+void DiskManager::DisableDirectIO() {
+  std::scoped_lock<std::recursive_mutex> lock(db_io_latch_);
+  if (!IsDirectIO()) {
     return;
   }
-  // needs to flush to keep disk file in sync
-  db_io_.flush();
+  for (size_t segment = 0; segment < max_segments_; segment++) {
+    int fd = segment_fds_[segment].load(std::memory_order_relaxed);
+    if (fd < 0) {
+      break;
+    }
+    int flags = fcntl(fd, F_GETFL);
+    fcntl(fd, F_SETFL, flags & ~O_DIRECT);
+  }
+  direct_io_.store(false, std::memory_order_relaxed);
+  LOG(WARNING) << "O_DIRECT rejected for " << file_name_ << ", using buffered I/O";
 }
 
+// every group of EXTENTS_PER_DIRECTORY_PAGE extents starts with its directory page, the meta page for group 0
+static constexpr size_t GROUP_PAGES = 1 + EXTENTS_PER_DIRECTORY_PAGE * (DiskManager::BITMAP_SIZE + 1);
+
 uint DiskManager::getExtIndexFromPhyPageId(page_id_t physical_page_id) {
-  return (physical_page_id - 1) / (BITMAP_SIZE + 1);
+  size_t group = physical_page_id / GROUP_PAGES;
+  return group * EXTENTS_PER_DIRECTORY_PAGE + (physical_page_id % GROUP_PAGES - 1) / (BITMAP_SIZE + 1);
 }
 
 page_id_t DiskManager::getBitmapPhyIdFromExtIndex(uint extIndex) {
-  return (page_id_t)(extIndex * (BITMAP_SIZE + 1) + 1);
+  size_t group = extIndex / EXTENTS_PER_DIRECTORY_PAGE;
+  return (page_id_t)(getDirectoryPhyIdFromGroup(group) + 1 + extIndex % EXTENTS_PER_DIRECTORY_PAGE * (BITMAP_SIZE + 1));
+}
+
+page_id_t DiskManager::getDirectoryPhyIdFromGroup(size_t group) {
+  return (page_id_t)(group * GROUP_PAGES);
 }
 
 uint DiskManager::getOffsetFromPhyId(page_id_t physical_page_id) {
-  return (physical_page_id - 1) % (BITMAP_SIZE + 1) - 1;
+  return (physical_page_id % GROUP_PAGES - 1) % (BITMAP_SIZE + 1) - 1;
 }
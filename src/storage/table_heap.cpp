@@ -1,6 +1,10 @@
 #include "storage/table_heap.h"
 
 bool TableHeap::InsertTuple(Row &row, Transaction *txn) {
+  if (buffer_pool_manager_->RejectWrite("tuple insert")) {
+    return false;
+  }
+  PageOwnerScope owner_scope(owner_);
   // confirm the data can place in a page
   if (row.GetSerializedSize(nullptr) + 32 > PAGE_SIZE) {
     return false;
@@ -21,12 +25,17 @@ bool TableHeap::InsertTuple(Row &row, Transaction *txn) {
       curPage = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(nextPageId));
       curPage->WLatch();
     } else {
-      auto newPage = reinterpret_cast<TablePage *>(buffer_pool_manager_->NewPage(nextPageId));
+      // keep the chain together on disk, so that a scan reads runs of contiguous pages
+      auto newPage =
+          reinterpret_cast<TablePage *>(buffer_pool_manager_->NewPageNear(nextPageId, curPage->GetTablePageId()));
       if (newPage == nullptr) {
         curPage->WUnlatch();
         buffer_pool_manager_->UnpinPage(curPage->GetTablePageId(), false);
         return false;
       }
+      if (cached_) {
+        buffer_pool_manager_->SetResidencyHint({nextPageId}, true);
+      }
       newPage->WLatch();
       curPage->SetNextPageId(nextPageId);
       newPage->Init(nextPageId, curPage->GetTablePageId(), log_manager_, txn);
@@ -42,6 +51,10 @@ bool TableHeap::InsertTuple(Row &row, Transaction *txn) {
 }
 
 bool TableHeap::MarkDelete(const RowId &rid, Transaction *txn) {
+  if (buffer_pool_manager_->RejectWrite("tuple delete")) {
+    return false;
+  }
+  PageOwnerScope owner_scope(owner_);
   // Find the page which contains the tuple.
   auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
   // If the page could not be found, then abort the transaction.
@@ -57,6 +70,10 @@ bool TableHeap::MarkDelete(const RowId &rid, Transaction *txn) {
 }
 
 bool TableHeap::UpdateTuple(const Row &row, const RowId &rid, Transaction *txn) {
+  if (buffer_pool_manager_->RejectWrite("tuple update")) {
+    return false;
+  }
+  PageOwnerScope owner_scope(owner_);
   auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
   if (page == nullptr) {
     LOG(WARNING) << "warning: when update tuple, the page is nullptr" << endl;
@@ -71,6 +88,10 @@ bool TableHeap::UpdateTuple(const Row &row, const RowId &rid, Transaction *txn)
 }
 
 void TableHeap::ApplyDelete(const RowId &rid, Transaction *txn) {
+  if (buffer_pool_manager_->RejectWrite("tuple delete")) {
+    return;
+  }
+  PageOwnerScope owner_scope(owner_);
   // Step1: Find the page which contains the tuple.
   // Step2: Delete the tuple from the page.
   auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
@@ -85,6 +106,10 @@ void TableHeap::ApplyDelete(const RowId &rid, Transaction *txn) {
 }
 
 void TableHeap::RollbackDelete(const RowId &rid, Transaction *txn) {
+  if (buffer_pool_manager_->RejectWrite("tuple delete rollback")) {
+    return;
+  }
+  PageOwnerScope owner_scope(owner_);
   // Find the page which contains the tuple.
   auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
   assert(page != nullptr);
@@ -95,9 +120,19 @@ void TableHeap::RollbackDelete(const RowId &rid, Transaction *txn) {
   buffer_pool_manager_->UnpinPage(page->GetTablePageId(), true);
 }
 
-void TableHeap::FreeHeap() {}
+void TableHeap::FreeHeap() {
+  if (buffer_pool_manager_->RejectWrite("table drop")) {
+    return;
+  }
+  PageOwnerScope owner_scope(owner_);
+  for (auto page_id : GetPageIds()) {
+    buffer_pool_manager_->DeletePage(page_id);
+  }
+  first_page_id_ = INVALID_PAGE_ID;
+}
 
 bool TableHeap::GetTuple(Row *row, Transaction *txn) {
+  PageOwnerScope owner_scope(owner_);
   RowId rowId(row->GetRowId());
   auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(rowId.GetPageId()));
   if (page == nullptr) {
@@ -110,11 +145,93 @@ bool TableHeap::GetTuple(Row *row, Transaction *txn) {
   return res;
 }
 
+void TableHeap::SetCached(bool cached) {
+  cached_ = cached;
+  buffer_pool_manager_->SetResidencyHint(GetPageIds(), cached);
+}
+
+std::vector<page_id_t> TableHeap::GetPageIds() {
+  PageOwnerScope owner_scope(owner_);
+  std::vector<page_id_t> page_ids;
+  for (auto pageId = first_page_id_; pageId != INVALID_PAGE_ID;) {
+    auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(pageId));
+    if (page == nullptr) {
+      break;
+    }
+    page_ids.push_back(pageId);
+    page->RLatch();
+    auto nextPageId = page->GetNextPageId();
+    page->RUnlatch();
+    buffer_pool_manager_->UnpinPage(pageId, false);
+    pageId = nextPageId;
+  }
+  return page_ids;
+}
+
+// 1.   Allocate the lowest free page, give it back if it is not below the page.
+// 2.   Copy the page over and fix its own id, then point its neighbours in the chain, or the heap, at the copy.
+// 3.   Delete the old page.
+bool TableHeap::RelocatePage(page_id_t page_id, page_id_t &new_page_id) {
+  if (buffer_pool_manager_->RejectWrite("page relocation")) {
+    return false;
+  }
+  PageOwnerScope owner_scope(owner_);
+  auto newPage = reinterpret_cast<TablePage *>(buffer_pool_manager_->NewPage(new_page_id));
+  if (newPage == nullptr) {
+    return false;
+  }
+  if (new_page_id > page_id) {
+    buffer_pool_manager_->UnpinPage(new_page_id, false);
+    buffer_pool_manager_->DeletePage(new_page_id);
+    return false;
+  }
+  auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+  if (page == nullptr) {
+    buffer_pool_manager_->UnpinPage(new_page_id, false);
+    buffer_pool_manager_->DeletePage(new_page_id);
+    return false;
+  }
+  page->RLatch();
+  newPage->WLatch();
+  memcpy(newPage->GetData(), page->GetData(), PAGE_SIZE);
+  newPage->SetTablePageId(new_page_id);
+  auto prevPageId = newPage->GetPrevPageId();
+  auto nextPageId = newPage->GetNextPageId();
+  newPage->WUnlatch();
+  page->RUnlatch();
+  buffer_pool_manager_->UnpinPage(page_id, false);
+  buffer_pool_manager_->UnpinPage(new_page_id, true);
+
+  if (prevPageId == INVALID_PAGE_ID) {
+    first_page_id_ = new_page_id;
+  } else {
+    auto prevPage = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(prevPageId));
+    prevPage->WLatch();
+    prevPage->SetNextPageId(new_page_id);
+    prevPage->WUnlatch();
+    buffer_pool_manager_->UnpinPage(prevPageId, true);
+  }
+  if (nextPageId != INVALID_PAGE_ID) {
+    auto nextPage = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(nextPageId));
+    nextPage->WLatch();
+    nextPage->SetPrevPageId(new_page_id);
+    nextPage->WUnlatch();
+    buffer_pool_manager_->UnpinPage(nextPageId, true);
+  }
+  if (cached_) {
+    buffer_pool_manager_->SetResidencyHint({page_id}, false);
+    buffer_pool_manager_->SetResidencyHint({new_page_id}, true);
+  }
+  buffer_pool_manager_->DeletePage(page_id);
+  return true;
+}
+
 TableIterator TableHeap::Begin(Transaction *txn) {
+  PageOwnerScope owner_scope(owner_);
   RowId rowId;
   auto pageId = first_page_id_;
   while (pageId != INVALID_PAGE_ID) {
-    auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(rowId.GetPageId()));
+    auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(pageId));
     page->RLatch();
     auto foundTuple = page->GetFirstTupleRid(&rowId);
     page->RUnlatch();
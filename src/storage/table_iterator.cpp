@@ -5,16 +5,41 @@
 TableIterator::TableIterator() {}
 
 TableIterator::TableIterator(TableHeap *tableHeap, RowId rowId, Transaction *transaction)
-    : pTableHeap(tableHeap), pTransaction(transaction), pRow(new Row(rowId)) {
+    : pTableHeap(tableHeap),
+      pTransaction(transaction),
+      pRow(new Row(rowId)),
+      readAhead(tableHeap->buffer_pool_manager_, TablePage::NextPageIdOf) {
   if (rowId.GetPageId() != INVALID_PAGE_ID) {
-    pTableHeap->GetTuple(pRow, transaction);
+    PageOwnerScope owner_scope(pTableHeap->GetOwner());
+    pPage = static_cast<TablePage *>(pTableHeap->buffer_pool_manager_->FetchPage(rowId.GetPageId()));
+    if (pPage != nullptr) {
+      ReadRow(rowId);
+    }
   }
 }
 
 TableIterator::TableIterator(const TableIterator &other)
-    : pTableHeap(other.pTableHeap), pTransaction(other.pTransaction), pRow(new Row(*other.pRow)) {}
+    : pTableHeap(other.pTableHeap),
+      pTransaction(other.pTransaction),
+      pRow(new Row(*other.pRow)),
+      readAhead(other.readAhead) {}
+
+TableIterator &TableIterator::operator=(const TableIterator &other) {
+  if (this != &other) {
+    ReleasePage();
+    delete pRow;
+    pTableHeap = other.pTableHeap;
+    pTransaction = other.pTransaction;
+    pRow = new Row(*other.pRow);
+    readAhead = other.readAhead;
+  }
+  return *this;
+}
 
-TableIterator::~TableIterator() { delete pRow; }
+TableIterator::~TableIterator() {
+  ReleasePage();
+  delete pRow;
+}
 
 bool TableIterator::operator==(const TableIterator &itr) const { return pRow->GetRowId() == itr.pRow->GetRowId(); }
 
@@ -24,31 +49,41 @@ Row& TableIterator::operator*() { return *pRow; }
 
 Row *TableIterator::operator->() { return pRow; }
 
+// 1.   Pin the current page, unless the iterator already holds it (a copy does not).
+// 2.   Find the next tuple on the page, or on the first following page that has one, keeping only the page it is on
+//      pinned.
+// 3.   Read it from that page.
 TableIterator &TableIterator::operator++() {
+  PageOwnerScope owner_scope(pTableHeap->GetOwner());
   BufferPoolManager *buffer_pool_manager = pTableHeap->buffer_pool_manager_;
-  auto cur_page = static_cast<TablePage *>(buffer_pool_manager->FetchPage(pRow->rid_.GetPageId()));
-  cur_page->RLatch();
+  if (pPage == nullptr) {
+    pPage = static_cast<TablePage *>(buffer_pool_manager->FetchPage(pRow->rid_.GetPageId()));
+  }
+  pPage->RLatch();
 
   RowId next_tuple_rid;
-  if (!cur_page->GetNextTupleRid(pRow->rid_, &next_tuple_rid)) {
-    while (cur_page->GetNextPageId() != INVALID_PAGE_ID) {
-      auto next_page = static_cast<TablePage *>(buffer_pool_manager->FetchPage(cur_page->GetNextPageId()));
-      cur_page->RUnlatch();
-      buffer_pool_manager->UnpinPage(cur_page->GetTablePageId(), false);
-      cur_page = next_page;
-      cur_page->RLatch();
-      if (cur_page->GetFirstTupleRid(&next_tuple_rid)) {
+  if (!pPage->GetNextTupleRid(pRow->rid_, &next_tuple_rid)) {
+    while (pPage->GetNextPageId() != INVALID_PAGE_ID) {
+      auto next_page = static_cast<TablePage *>(buffer_pool_manager->FetchPage(pPage->GetNextPageId()));
+      pPage->RUnlatch();
+      buffer_pool_manager->UnpinPage(pPage->GetTablePageId(), false);
+      pPage = next_page;
+      pPage->RLatch();
+      readAhead.Advance(pPage->GetNextPageId());
+      if (pPage->GetFirstTupleRid(&next_tuple_rid)) {
         break;
       }
     }
   }
-  pRow->rid_ = next_tuple_rid;
+  pPage->RUnlatch();
 
-  if (*this != pTableHeap->End()) {
-    pTableHeap->GetTuple(pRow, pTransaction);
+  if (next_tuple_rid.GetPageId() == INVALID_PAGE_ID) {
+    ReleasePage();
+    delete pRow;
+    pRow = new Row(next_tuple_rid);
+  } else {
+    ReadRow(next_tuple_rid);
   }
-  cur_page->RUnlatch();
-  buffer_pool_manager->UnpinPage(cur_page->GetTablePageId(), false);
   return *this;
 }
 
@@ -57,3 +92,18 @@ TableIterator TableIterator::operator++(int) {
   ++(*this);
   return old_heap;
 }
+
+void TableIterator::ReadRow(RowId rid) {
+  delete pRow;
+  pRow = new Row(rid);
+  pPage->RLatch();
+  pPage->GetTuple(pRow, pTableHeap->schema_, pTransaction, pTableHeap->lock_manager_);
+  pPage->RUnlatch();
+}
+
+void TableIterator::ReleasePage() {
+  if (pPage != nullptr) {
+    pTableHeap->buffer_pool_manager_->UnpinPage(pPage->GetTablePageId(), false);
+    pPage = nullptr;
+  }
+}
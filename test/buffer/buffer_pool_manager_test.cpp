@@ -1,10 +1,36 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstdio>
 #include <random>
 #include <string>
+#include <thread>
+#include <vector>
 
-#include "buffer/buffer_pool_manager.h"
+#include "buffer/buffer_pool_manager_instance.h"
+#include "common/instance.h"
 #include "gtest/gtest.h"
 
+/**
+ * Wait until every page of page_ids is resident, or with resident false until none is, the prefetch thread and a
+ * shrinking pool change them in the background. @return false if that does not happen within 10 seconds
+ */
+static bool WaitForResident(BufferPoolManager *bpm, const std::vector<page_id_t> &page_ids, bool resident = true) {
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (true) {
+    std::vector<page_id_t> resident_pages = bpm->GetResidentPages();
+    if (std::all_of(page_ids.begin(), page_ids.end(), [&](page_id_t page_id) {
+          return (std::find(resident_pages.begin(), resident_pages.end(), page_id) != resident_pages.end()) == resident;
+        })) {
+      return true;
+    }
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+
 TEST(BufferPoolManagerTest, BinaryDataTest) {
   const std::string db_name = "bpm_test.db";
   const size_t buffer_pool_size = 10;
@@ -15,7 +41,7 @@ TEST(BufferPoolManagerTest, BinaryDataTest) {
 
   remove(db_name.c_str());
   auto *disk_manager = new DiskManager(db_name);
-  auto *bpm = new BufferPoolManager(buffer_pool_size, disk_manager);
+  auto *bpm = new BufferPoolManagerInstance(buffer_pool_size, disk_manager);
 
   page_id_t page_id_temp;
   auto *page0 = bpm->NewPage(page_id_temp);
@@ -72,3 +98,665 @@ TEST(BufferPoolManagerTest, BinaryDataTest) {
   delete disk_manager;
 }
 
+
+TEST(BufferPoolManagerTest, PageCleanerTest) {
+  const std::string db_name = "bpm_test.db";
+  const size_t buffer_pool_size = 10;
+
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new BufferPoolManagerInstance(buffer_pool_size, disk_manager);
+
+  // Scenario: fill the pool with dirty unpinned pages and let the cleaner write all of them.
+  page_id_t page_id_temp;
+  for (size_t i = 0; i < buffer_pool_size; ++i) {
+    auto *page = bpm->NewPage(page_id_temp);
+    ASSERT_NE(nullptr, page);
+    snprintf(page->GetData(), PAGE_SIZE, "page %zu", i);
+    EXPECT_TRUE(bpm->UnpinPage(page_id_temp, true));
+  }
+  bpm->StartPageCleaner(1.0);
+  for (int i = 0; i < 1000 && bpm->GetBackgroundWritebacks() < buffer_pool_size; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_EQ(buffer_pool_size, bpm->GetBackgroundWritebacks());
+
+  // Scenario: evicting the cleaned pages does not write anything on the foreground path.
+  for (size_t i = 0; i < buffer_pool_size; ++i) {
+    EXPECT_NE(nullptr, bpm->NewPage(page_id_temp));
+    EXPECT_TRUE(bpm->UnpinPage(page_id_temp, false));
+  }
+  EXPECT_EQ(0, bpm->GetForegroundWritebacks());
+  bpm->StopPageCleaner();
+
+  // Scenario: the pages written by the cleaner are read back intact.
+  for (page_id_t i = 0; i < static_cast<page_id_t>(buffer_pool_size); ++i) {
+    auto *page = bpm->FetchPage(i);
+    ASSERT_NE(nullptr, page);
+    EXPECT_EQ("page " + std::to_string(i), std::string(page->GetData()));
+    EXPECT_TRUE(bpm->UnpinPage(i, false));
+  }
+
+  delete bpm;
+  delete disk_manager;
+  remove(db_name.c_str());
+}
+
+TEST(BufferPoolManagerTest, EnginePageCleanerTest) {
+  const std::string db_name = "bpm_test.db";
+  const size_t buffer_pool_size = 16;
+  DBStorageEngine engine(db_name, true, buffer_pool_size);
+
+  // Scenario: a writable database cleans dirty pages in the background without being asked to.
+  page_id_t page_id_temp;
+  for (size_t i = 0; i < buffer_pool_size - 2; ++i) {
+    ASSERT_NE(nullptr, engine.bpm_->NewPage(page_id_temp));
+    EXPECT_TRUE(engine.bpm_->UnpinPage(page_id_temp, true));
+  }
+  for (int i = 0; i < 1000 && engine.bpm_->GetStats().background_writebacks_ == 0; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_LT(0, engine.bpm_->GetStats().background_writebacks_);
+}
+
+TEST(BufferPoolManagerTest, PrefetchTest) {
+  const std::string db_name = "bpm_test.db";
+  const size_t buffer_pool_size = 10;
+
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new BufferPoolManagerInstance(buffer_pool_size, disk_manager);
+
+  // Scenario: create twice as many pages as frames, so that pages 0~9 are evicted.
+  page_id_t page_id_temp;
+  for (size_t i = 0; i < buffer_pool_size * 2; ++i) {
+    auto *page = bpm->NewPage(page_id_temp);
+    ASSERT_NE(nullptr, page);
+    snprintf(page->GetData(), PAGE_SIZE, "page %zu", i);
+    EXPECT_TRUE(bpm->UnpinPage(page_id_temp, true));
+  }
+
+  // Scenario: fetching pages right after asking for them, while their reads may still be queued or in flight.
+  std::vector<page_id_t> page_ids = {0, 1, 2, 3, 4};
+  bpm->PrefetchPages(page_ids);
+  for (auto page_id : page_ids) {
+    auto *page = bpm->FetchPage(page_id);
+    ASSERT_NE(nullptr, page);
+    EXPECT_EQ("page " + std::to_string(page_id), std::string(page->GetData()));
+    EXPECT_TRUE(bpm->UnpinPage(page_id, false));
+  }
+
+  // Scenario: prefetching pages that are not allocated leaves them to NewPage.
+  bpm->PrefetchPages({20, 21});
+  auto *page = bpm->NewPage(page_id_temp);
+  ASSERT_NE(nullptr, page);
+  EXPECT_EQ(20, page_id_temp);
+  EXPECT_EQ(0, page->GetData()[0]);
+  EXPECT_TRUE(bpm->UnpinPage(page_id_temp, false));
+
+  // Scenario: prefetched pages stay resident, so they can be fetched even after the file is closed.
+  page_ids = {5, 6, 7, 8};
+  bpm->PrefetchPages(page_ids);
+  ASSERT_TRUE(WaitForResident(bpm, page_ids));
+  disk_manager->Close();
+  for (auto page_id : page_ids) {
+    page = bpm->FetchPage(page_id);
+    ASSERT_NE(nullptr, page);
+    EXPECT_EQ("page " + std::to_string(page_id), std::string(page->GetData()));
+    EXPECT_TRUE(bpm->UnpinPage(page_id, false));
+  }
+  EXPECT_TRUE(bpm->CheckAllUnpinned());
+
+  delete bpm;
+  delete disk_manager;
+  remove(db_name.c_str());
+}
+
+TEST(BufferPoolManagerTest, PrefetchChainTest) {
+  const std::string db_name = "bpm_test.db";
+  const size_t buffer_pool_size = 8;
+  const page_id_t num_pages = 16;
+
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new BufferPoolManagerInstance(buffer_pool_size, disk_manager);
+  // every page starts with the id of the next page of its chain
+  NextPageIdReader next_page_id = [](const char *data) { return *reinterpret_cast<const page_id_t *>(data); };
+  std::vector<page_id_t> chain = {0, 6, 3, 5, 1, 40};
+
+  page_id_t page_id_temp;
+  for (page_id_t i = 0; i < num_pages; ++i) {
+    auto *page = bpm->NewPage(page_id_temp);
+    ASSERT_NE(nullptr, page);
+    page_id_t next = INVALID_PAGE_ID;
+    auto it = std::find(chain.begin(), chain.end(), page_id_temp);
+    if (it != chain.end() && it + 1 != chain.end()) {
+      next = *(it + 1);
+    }
+    memcpy(page->GetData(), &next, sizeof(page_id_t));
+    EXPECT_TRUE(bpm->UnpinPage(page_id_temp, true));
+  }
+  bpm->FlushAllPages();
+
+  // Scenario: the pool follows the chain instead of reading the next page ids, and stops after count pages.
+  bpm->PrefetchChain(0, 4, next_page_id);
+  EXPECT_TRUE(WaitForResident(bpm, {0, 6, 3, 5}));
+  std::vector<page_id_t> resident = bpm->GetResidentPages();
+  for (page_id_t page_id : {2, 4, 7}) {
+    EXPECT_EQ(resident.end(), std::find(resident.begin(), resident.end(), page_id));
+  }
+
+  // Scenario: the chain is followed through the resident pages 3 and 5 to page 1, which leads to a free page.
+  bpm->PrefetchChain(3, 10, next_page_id);
+  EXPECT_TRUE(WaitForResident(bpm, {1}));
+  EXPECT_TRUE(bpm->CheckAllUnpinned());
+
+  delete bpm;
+  delete disk_manager;
+  remove(db_name.c_str());
+}
+
+TEST(BufferPoolManagerTest, StatsTest) {
+  const std::string db_name = "bpm_test.db";
+  const size_t buffer_pool_size = 4;
+
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new BufferPoolManagerInstance(buffer_pool_size, disk_manager);
+
+  // Scenario: fill the pool with pinned pages, one more page does not fit.
+  page_id_t page_id_temp;
+  for (size_t i = 0; i < buffer_pool_size; ++i) {
+    ASSERT_NE(nullptr, bpm->NewPage(page_id_temp));
+  }
+  EXPECT_EQ(nullptr, bpm->NewPage(page_id_temp));
+  BufferPoolStats stats = bpm->GetStats();
+  EXPECT_EQ(buffer_pool_size, stats.pool_size_);
+  EXPECT_EQ(buffer_pool_size, stats.resident_pages_);
+  EXPECT_EQ(buffer_pool_size, stats.pinned_frames_);
+  EXPECT_EQ(buffer_pool_size, stats.pinned_high_water_);
+  EXPECT_EQ(buffer_pool_size, stats.new_pages_);
+  EXPECT_EQ(1, stats.failed_fetches_);
+
+  // Scenario: a fetch of a resident page is a hit, pinning it twice counts one pinned frame.
+  EXPECT_NE(nullptr, bpm->FetchPage(0));
+  for (page_id_t i = 0; i < static_cast<page_id_t>(buffer_pool_size); ++i) {
+    EXPECT_TRUE(bpm->UnpinPage(i, true));
+  }
+  EXPECT_TRUE(bpm->UnpinPage(0, false));
+  stats = bpm->GetStats();
+  EXPECT_EQ(1, stats.fetches_);
+  EXPECT_EQ(1, stats.hits_);
+  EXPECT_EQ(0, stats.pinned_frames_);
+  EXPECT_EQ(buffer_pool_size, stats.pinned_high_water_);
+
+  // Scenario: new pages evict the dirty ones, fetching those back misses.
+  for (size_t i = 0; i < buffer_pool_size; ++i) {
+    ASSERT_NE(nullptr, bpm->NewPage(page_id_temp));
+    EXPECT_TRUE(bpm->UnpinPage(page_id_temp, false));
+  }
+  EXPECT_NE(nullptr, bpm->FetchPage(0));
+  EXPECT_TRUE(bpm->UnpinPage(0, false));
+  stats = bpm->GetStats();
+  EXPECT_EQ(buffer_pool_size + 1, stats.evictions_);
+  EXPECT_EQ(buffer_pool_size, stats.foreground_writebacks_);
+  EXPECT_EQ(1, stats.misses_);
+
+  // Scenario: deleting a resident page frees its frame.
+  EXPECT_TRUE(bpm->DeletePage(0));
+  stats = bpm->GetStats();
+  EXPECT_EQ(1, stats.deleted_pages_);
+  EXPECT_EQ(buffer_pool_size - 1, stats.resident_pages_);
+
+  delete bpm;
+  delete disk_manager;
+  remove(db_name.c_str());
+}
+
+TEST(BufferPoolManagerTest, ResizeTest) {
+  const std::string db_name = "bpm_test.db";
+  const size_t buffer_pool_size = 4;
+
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new BufferPoolManagerInstance(buffer_pool_size, disk_manager, ReplacerType::kClock);
+
+  // Scenario: growing the pool makes room for more pinned pages.
+  page_id_t page_id_temp;
+  for (size_t i = 0; i < buffer_pool_size; ++i) {
+    ASSERT_NE(nullptr, bpm->NewPage(page_id_temp));
+  }
+  EXPECT_EQ(nullptr, bpm->NewPage(page_id_temp));
+  EXPECT_FALSE(bpm->ResizePool(0));
+  EXPECT_TRUE(bpm->ResizePool(buffer_pool_size * 2));
+  EXPECT_EQ(buffer_pool_size * 2, bpm->GetPoolSize());
+  for (size_t i = 0; i < buffer_pool_size; ++i) {
+    auto *page = bpm->NewPage(page_id_temp);
+    ASSERT_NE(nullptr, page);
+    snprintf(page->GetData(), PAGE_SIZE, "page %d", page_id_temp);
+  }
+  EXPECT_EQ(nullptr, bpm->NewPage(page_id_temp));
+
+  // Scenario: shrinking writes back the pages held by the retired frames, and waits until the last one is unpinned.
+  for (page_id_t i = 0; i < static_cast<page_id_t>(buffer_pool_size); ++i) {
+    EXPECT_TRUE(bpm->UnpinPage(i, false));
+  }
+  std::vector<page_id_t> retired_page_ids;
+  const auto last_page_id = static_cast<page_id_t>(buffer_pool_size * 2 - 1);
+  for (page_id_t i = buffer_pool_size; i < last_page_id; ++i) {
+    EXPECT_TRUE(bpm->UnpinPage(i, true));
+    retired_page_ids.push_back(i);
+  }
+  std::atomic<bool> resized{false};
+  std::thread resizer([bpm, &resized] {
+    EXPECT_TRUE(bpm->ResizePool(buffer_pool_size));
+    resized = true;
+  });
+  // the shrink only releases the latch after evicting the unpinned pages, to wait for the pinned one
+  EXPECT_TRUE(WaitForResident(bpm, retired_page_ids, false));
+  EXPECT_FALSE(resized);
+  EXPECT_TRUE(bpm->UnpinPage(last_page_id, true));
+  resizer.join();
+  EXPECT_TRUE(resized);
+  EXPECT_EQ(buffer_pool_size, bpm->GetPoolSize());
+  EXPECT_TRUE(bpm->CheckAllUnpinned());
+
+  // Scenario: every page is still readable through the smaller pool.
+  for (page_id_t i = 0; i < static_cast<page_id_t>(buffer_pool_size * 2); ++i) {
+    auto *page = bpm->FetchPage(i);
+    ASSERT_NE(nullptr, page);
+    if (i >= static_cast<page_id_t>(buffer_pool_size)) {
+      EXPECT_EQ("page " + std::to_string(i), std::string(page->GetData()));
+    }
+    EXPECT_TRUE(bpm->UnpinPage(i, false));
+  }
+  EXPECT_EQ(buffer_pool_size, bpm->GetStats().resident_pages_);
+
+  // Scenario: a shrink gives up after RESIZE_PIN_TIMEOUT_MS on pages that stay pinned, and every frame stays usable,
+  // also the ones it emptied while waiting.
+  for (page_id_t i = 0; i < static_cast<page_id_t>(buffer_pool_size); ++i) {
+    ASSERT_NE(nullptr, bpm->FetchPage(i));
+  }
+  std::thread unpinner([bpm] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(RESIZE_PIN_TIMEOUT_MS / 10));
+    EXPECT_TRUE(bpm->UnpinPage(1, false));
+    EXPECT_TRUE(bpm->UnpinPage(2, false));
+  });
+  EXPECT_FALSE(bpm->ResizePool(1));
+  unpinner.join();
+  EXPECT_EQ(buffer_pool_size, bpm->GetPoolSize());
+  EXPECT_TRUE(bpm->UnpinPage(0, false));
+  EXPECT_TRUE(bpm->UnpinPage(3, false));
+  std::vector<page_id_t> new_page_ids;
+  for (size_t i = 0; i < buffer_pool_size; ++i) {
+    ASSERT_NE(nullptr, bpm->NewPage(page_id_temp));
+    new_page_ids.push_back(page_id_temp);
+  }
+  EXPECT_EQ(nullptr, bpm->NewPage(page_id_temp));
+  for (auto page_id : new_page_ids) {
+    EXPECT_TRUE(bpm->UnpinPage(page_id, false));
+  }
+
+  delete bpm;
+  delete disk_manager;
+  remove(db_name.c_str());
+}
+
+TEST(BufferPoolManagerTest, FlushAllPagesTest) {
+  const std::string db_name = "bpm_test.db";
+  const size_t buffer_pool_size = 16;
+
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new BufferPoolManagerInstance(buffer_pool_size, disk_manager);
+
+  // Scenario: dirty every other page and flush the pool, which leaves every page clean.
+  page_id_t page_id_temp;
+  for (size_t i = 0; i < buffer_pool_size; ++i) {
+    auto *page = bpm->NewPage(page_id_temp);
+    ASSERT_NE(nullptr, page);
+    snprintf(page->GetData(), PAGE_SIZE, "page %d", page_id_temp);
+    EXPECT_TRUE(bpm->UnpinPage(page_id_temp, i % 2 == 0));
+  }
+  bpm->FlushAllPages();
+  for (page_id_t i = 0; i < static_cast<page_id_t>(buffer_pool_size); ++i) {
+    auto *page = bpm->FetchPage(i);
+    ASSERT_NE(nullptr, page);
+    EXPECT_FALSE(page->IsDirty());
+    EXPECT_TRUE(bpm->UnpinPage(i, false));
+  }
+
+  // Scenario: the flushed pages are on disk, the clean ones were never written.
+  char data[PAGE_SIZE];
+  for (page_id_t i = 0; i < static_cast<page_id_t>(buffer_pool_size); ++i) {
+    disk_manager->ReadPage(i, data);
+    if (i % 2 == 0) {
+      EXPECT_EQ("page " + std::to_string(i), std::string(data));
+    } else {
+      EXPECT_EQ(0, data[0]);
+    }
+  }
+
+  delete bpm;
+  delete disk_manager;
+  remove(db_name.c_str());
+}
+
+TEST(BufferPoolManagerTest, ResidentPagesTest) {
+  const std::string db_name = "bpm_test.db";
+  const std::string warmup_name = db_name + ".warmup";
+  const size_t buffer_pool_size = 4;
+
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new BufferPoolManagerInstance(buffer_pool_size, disk_manager, ReplacerType::kLRU);
+
+  // Scenario: pinned pages come first, then the unpinned ones from the most to the least recently used.
+  page_id_t page_id_temp;
+  for (size_t i = 0; i < buffer_pool_size; ++i) {
+    ASSERT_NE(nullptr, bpm->NewPage(page_id_temp));
+    EXPECT_TRUE(bpm->UnpinPage(page_id_temp, true));
+  }
+  ASSERT_NE(nullptr, bpm->FetchPage(2));
+  EXPECT_TRUE(bpm->UnpinPage(2, false));
+  ASSERT_NE(nullptr, bpm->FetchPage(1));
+  std::vector<page_id_t> expected{1, 2, 3, 0};
+  EXPECT_EQ(expected, bpm->GetResidentPages());
+
+  // Scenario: the page set survives a round trip through the sidecar file.
+  ASSERT_TRUE(bpm->SaveResidentPages(warmup_name));
+  EXPECT_EQ(expected, BufferPoolManager::LoadResidentPages(warmup_name));
+  EXPECT_TRUE(bpm->UnpinPage(1, false));
+
+  // Scenario: a missing or corrupt file loads as an empty page set.
+  remove(warmup_name.c_str());
+  EXPECT_TRUE(BufferPoolManager::LoadResidentPages(warmup_name).empty());
+  FILE *file = fopen(warmup_name.c_str(), "w");
+  fputs("not a page set", file);
+  fclose(file);
+  EXPECT_TRUE(BufferPoolManager::LoadResidentPages(warmup_name).empty());
+
+  delete bpm;
+  delete disk_manager;
+  remove(db_name.c_str());
+  remove(warmup_name.c_str());
+}
+
+TEST(BufferPoolManagerTest, CompressedCacheTest) {
+  const std::string db_name = "bpm_test.db";
+  const size_t buffer_pool_size = 4;
+
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new BufferPoolManagerInstance(buffer_pool_size, disk_manager);
+  bpm->SetCompressedCacheSize(4 * PAGE_SIZE);
+
+  // Scenario: pages of padded text compress well, evicting them fills the compressed cache.
+  page_id_t page_id_temp;
+  for (size_t i = 0; i < 2 * buffer_pool_size; ++i) {
+    Page *page = bpm->NewPage(page_id_temp);
+    ASSERT_NE(nullptr, page);
+    snprintf(page->GetData(), PAGE_SIZE, "page %d", page_id_temp);
+    EXPECT_TRUE(bpm->UnpinPage(page_id_temp, true));
+  }
+  BufferPoolStats stats = bpm->GetStats();
+  EXPECT_EQ(4 * PAGE_SIZE, stats.compressed_capacity_);
+  EXPECT_EQ(buffer_pool_size, stats.compressed_pages_);
+  EXPECT_LT(stats.compressed_bytes_, PAGE_SIZE);
+
+  // Scenario: a miss on an evicted page is served from the compressed cache, with the data intact.
+  Page *page = bpm->FetchPage(0);
+  ASSERT_NE(nullptr, page);
+  EXPECT_EQ(0, strcmp(page->GetData(), "page 0"));
+  EXPECT_TRUE(bpm->UnpinPage(0, false));
+  stats = bpm->GetStats();
+  EXPECT_EQ(1, stats.misses_);
+  EXPECT_EQ(1, stats.compressed_lookups_);
+  EXPECT_EQ(1, stats.compressed_hits_);
+
+  // Scenario: a deleted page is dropped from the compressed cache.
+  EXPECT_TRUE(bpm->DeletePage(1));
+  EXPECT_EQ(stats.compressed_pages_ - 1, bpm->GetStats().compressed_pages_);
+
+  // Scenario: a page that does not compress is rejected when it is evicted.
+  std::mt19937 rng(7);
+  page = bpm->FetchPage(2);
+  ASSERT_NE(nullptr, page);
+  for (int i = 0; i < PAGE_SIZE; ++i) {
+    page->GetData()[i] = static_cast<char>(rng());
+  }
+  EXPECT_TRUE(bpm->UnpinPage(2, true));
+  uint64_t rejects = bpm->GetStats().compressed_rejects_;
+  for (page_id_t i = 4; i < 8; ++i) {
+    EXPECT_NE(nullptr, bpm->FetchPage(i));
+    EXPECT_TRUE(bpm->UnpinPage(i, false));
+  }
+  EXPECT_EQ(rejects + 1, bpm->GetStats().compressed_rejects_);
+
+  // Scenario: the rejected page is read back from disk.
+  uint64_t hits = bpm->GetStats().compressed_hits_;
+  page = bpm->FetchPage(2);
+  ASSERT_NE(nullptr, page);
+  rng.seed(7);
+  EXPECT_EQ(static_cast<char>(rng()), page->GetData()[0]);
+  EXPECT_EQ(hits, bpm->GetStats().compressed_hits_);
+  EXPECT_TRUE(bpm->UnpinPage(2, false));
+
+  // Scenario: disabling the cache empties it.
+  bpm->SetCompressedCacheSize(0);
+  stats = bpm->GetStats();
+  EXPECT_EQ(0, stats.compressed_pages_);
+  EXPECT_EQ(0, stats.compressed_bytes_);
+
+  delete bpm;
+  delete disk_manager;
+  remove(db_name.c_str());
+}
+
+TEST(BufferPoolManagerTest, ResidencyHintTest) {
+  const std::string db_name = "bpm_test.db";
+  const size_t buffer_pool_size = 4;
+
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new BufferPoolManagerInstance(buffer_pool_size, disk_manager);
+
+  // Scenario: pages 0 and 1 are cached, a scan over many other pages does not evict them.
+  page_id_t page_id_temp;
+  for (size_t i = 0; i < 2; ++i) {
+    ASSERT_NE(nullptr, bpm->NewPage(page_id_temp));
+    EXPECT_TRUE(bpm->UnpinPage(page_id_temp, true));
+  }
+  bpm->SetResidencyHint({0, 1}, true);
+  EXPECT_EQ(2, bpm->GetStats().cached_resident_pages_);
+  for (size_t i = 0; i < 10; ++i) {
+    ASSERT_NE(nullptr, bpm->NewPage(page_id_temp));
+    EXPECT_TRUE(bpm->UnpinPage(page_id_temp, true));
+  }
+  BufferPoolStats stats = bpm->GetStats();
+  EXPECT_EQ(0, stats.cached_evictions_);
+  EXPECT_EQ(2, stats.cached_resident_pages_);
+  for (page_id_t i = 0; i < 2; ++i) {
+    EXPECT_NE(nullptr, bpm->FetchPage(i));
+    EXPECT_TRUE(bpm->UnpinPage(i, false));
+  }
+  EXPECT_EQ(2, bpm->GetStats().hits_);
+
+  // Scenario: cached pages are evicted when every other frame is pinned, and keep their hint when read back.
+  std::vector<page_id_t> pinned;
+  for (size_t i = 0; i < buffer_pool_size; ++i) {
+    ASSERT_NE(nullptr, bpm->NewPage(page_id_temp));
+    pinned.push_back(page_id_temp);
+  }
+  stats = bpm->GetStats();
+  EXPECT_EQ(2, stats.cached_evictions_);
+  EXPECT_EQ(0, stats.cached_resident_pages_);
+  for (auto page_id : pinned) {
+    EXPECT_TRUE(bpm->UnpinPage(page_id, false));
+  }
+  EXPECT_NE(nullptr, bpm->FetchPage(0));
+  EXPECT_TRUE(bpm->UnpinPage(0, false));
+  EXPECT_EQ(1, bpm->GetStats().cached_resident_pages_);
+
+  // Scenario: taking the hint away makes the page ordinary again.
+  bpm->SetResidencyHint({0}, false);
+  EXPECT_EQ(0, bpm->GetStats().cached_resident_pages_);
+
+  delete bpm;
+  delete disk_manager;
+  remove(db_name.c_str());
+}
+
+TEST(BufferPoolManagerTest, FrameQuotaTest) {
+  const std::string db_name = "bpm_test.db";
+  const size_t buffer_pool_size = 8;
+
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new BufferPoolManagerInstance(buffer_pool_size, disk_manager);
+
+  // Scenario: a pool at its quota replaces its own pages although it has free frames.
+  bpm->SetFrameQuota(4);
+  page_id_t page_id_temp;
+  for (size_t i = 0; i < buffer_pool_size; ++i) {
+    Page *page = bpm->NewPage(page_id_temp);
+    ASSERT_NE(nullptr, page);
+    snprintf(page->GetData(), PAGE_SIZE, "page %d", page_id_temp);
+    EXPECT_TRUE(bpm->UnpinPage(page_id_temp, true));
+  }
+  BufferPoolStats stats = bpm->GetStats();
+  EXPECT_EQ(buffer_pool_size, stats.pool_size_);
+  EXPECT_EQ(4, stats.frame_quota_);
+  EXPECT_EQ(4, stats.resident_pages_);
+  EXPECT_EQ(4, stats.evictions_);
+
+  // Scenario: with every frame of the quota pinned, the pool is full.
+  for (page_id_t i = 4; i < 8; ++i) {
+    EXPECT_NE(nullptr, bpm->FetchPage(i));
+  }
+  EXPECT_EQ(nullptr, bpm->NewPage(page_id_temp));
+
+  // Scenario: shrinking the quota keeps pinned pages until a later call can evict them.
+  EXPECT_TRUE(bpm->UnpinPage(4, false));
+  EXPECT_TRUE(bpm->UnpinPage(5, false));
+  bpm->SetFrameQuota(1);
+  EXPECT_EQ(2, bpm->GetStats().resident_pages_);
+  EXPECT_TRUE(bpm->UnpinPage(6, false));
+  EXPECT_TRUE(bpm->UnpinPage(7, false));
+  bpm->SetFrameQuota(1);
+  EXPECT_EQ(1, bpm->GetStats().resident_pages_);
+
+  // Scenario: evicted pages were written back, and a larger quota uses the free frames again.
+  bpm->SetFrameQuota(buffer_pool_size);
+  for (page_id_t i = 0; i < 8; ++i) {
+    Page *page = bpm->FetchPage(i);
+    ASSERT_NE(nullptr, page);
+    EXPECT_EQ(0, strcmp(page->GetData(), ("page " + std::to_string(i)).c_str()));
+  }
+  EXPECT_EQ(buffer_pool_size, bpm->GetStats().resident_pages_);
+  for (page_id_t i = 0; i < 8; ++i) {
+    EXPECT_TRUE(bpm->UnpinPage(i, false));
+  }
+
+  delete bpm;
+  delete disk_manager;
+  remove(db_name.c_str());
+}
+
+TEST(BufferPoolManagerTest, FetchPagesTest) {
+  const std::string db_name = "bpm_test.db";
+  const size_t buffer_pool_size = 8;
+
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new BufferPoolManagerInstance(buffer_pool_size, disk_manager);
+
+  page_id_t page_id_temp;
+  for (size_t i = 0; i < 2 * buffer_pool_size; ++i) {
+    Page *page = bpm->NewPage(page_id_temp);
+    ASSERT_NE(nullptr, page);
+    snprintf(page->GetData(), PAGE_SIZE, "page %d", page_id_temp);
+    EXPECT_TRUE(bpm->UnpinPage(page_id_temp, true));
+  }
+
+  // Scenario: resident pages are hits, the others are read as one batch, and a repeated id is pinned twice.
+  std::vector<page_id_t> page_ids{15, 0, 1, 2, 14, 0};
+  std::vector<Page *> pages = bpm->FetchPages(page_ids);
+  ASSERT_EQ(page_ids.size(), pages.size());
+  for (size_t i = 0; i < pages.size(); ++i) {
+    ASSERT_NE(nullptr, pages[i]);
+    EXPECT_EQ(page_ids[i], pages[i]->GetPageId());
+    EXPECT_EQ(0, strcmp(pages[i]->GetData(), ("page " + std::to_string(page_ids[i])).c_str()));
+  }
+  BufferPoolStats stats = bpm->GetStats();
+  EXPECT_EQ(6, stats.fetches_);
+  EXPECT_EQ(3, stats.hits_);
+  EXPECT_EQ(3, stats.misses_);
+  EXPECT_EQ(2, pages[1]->GetPinCount());
+
+  // Scenario: pages that find no free frame come back as nullptr.
+  std::vector<page_id_t> more{3, 4, 5, 6, 7};
+  pages = bpm->FetchPages(more);
+  EXPECT_NE(nullptr, pages[2]);
+  EXPECT_EQ(nullptr, pages[3]);
+  EXPECT_EQ(nullptr, pages[4]);
+
+  delete bpm;
+  delete disk_manager;
+  remove(db_name.c_str());
+}
+
+TEST(BufferPoolManagerTest, OwnerStatsTest) {
+  const std::string db_name = "bpm_test.db";
+  const size_t buffer_pool_size = 4;
+  const page_owner_t table = 1;
+  const page_owner_t index = 2;
+
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new BufferPoolManagerInstance(buffer_pool_size, disk_manager);
+  // pages served from the compressed page cache are not disk reads
+  bpm->SetCompressedCacheSize(0);
+
+  // Scenario: pages created inside a scope carry its tag, their writebacks are charged to it.
+  page_id_t page_id_temp;
+  {
+    PageOwnerScope scope(table);
+    EXPECT_EQ(table, PageOwnerScope::Current());
+    for (size_t i = 0; i < 2 * buffer_pool_size; ++i) {
+      ASSERT_NE(nullptr, bpm->NewPage(page_id_temp));
+      EXPECT_TRUE(bpm->UnpinPage(page_id_temp, true));
+    }
+  }
+  EXPECT_EQ(INVALID_PAGE_OWNER, PageOwnerScope::Current());
+  auto owner_stats = bpm->GetOwnerStats();
+  EXPECT_EQ(0, owner_stats[table].reads_);
+  EXPECT_EQ(buffer_pool_size, owner_stats[table].writes_);
+
+  // Scenario: misses are charged to the scope of the fetch, the victims they evict to the owner of the victim.
+  {
+    PageOwnerScope scope(index);
+    for (page_id_t i = 0; i < static_cast<page_id_t>(buffer_pool_size); ++i) {
+      ASSERT_NE(nullptr, bpm->FetchPage(i));
+      EXPECT_TRUE(bpm->UnpinPage(i, false));
+    }
+  }
+  owner_stats = bpm->GetOwnerStats();
+  EXPECT_EQ(2 * buffer_pool_size, owner_stats[table].writes_);
+  EXPECT_EQ(buffer_pool_size, owner_stats[index].reads_);
+
+  // Scenario: a fetch outside of any scope keeps the tag of the page, and a miss outside of it goes unattributed.
+  ASSERT_NE(nullptr, bpm->FetchPage(0));
+  EXPECT_TRUE(bpm->UnpinPage(0, true));
+  EXPECT_TRUE(bpm->FlushPage(0));
+  ASSERT_NE(nullptr, bpm->FetchPage(5));
+  EXPECT_TRUE(bpm->UnpinPage(5, false));
+  owner_stats = bpm->GetOwnerStats();
+  EXPECT_EQ(1, owner_stats[index].writes_);
+  EXPECT_EQ(1, owner_stats[INVALID_PAGE_OWNER].reads_);
+  EXPECT_EQ(0, owner_stats[INVALID_PAGE_OWNER].writes_);
+
+  delete bpm;
+  delete disk_manager;
+  remove(db_name.c_str());
+}
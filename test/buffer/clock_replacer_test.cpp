@@ -0,0 +1,84 @@
+#include <thread>
+#include <vector>
+
+#include "buffer/clock_replacer.h"
+#include "gtest/gtest.h"
+
+TEST(ClockReplacerTest, SampleTest) {
+  ClockReplacer clock_replacer(7);
+
+  // Scenario: unpin six elements, i.e. add them to the replacer.
+  clock_replacer.Unpin(1);
+  clock_replacer.Unpin(2);
+  clock_replacer.Unpin(3);
+  clock_replacer.Unpin(4);
+  clock_replacer.Unpin(5);
+  clock_replacer.Unpin(6);
+  clock_replacer.Unpin(1);
+  EXPECT_EQ(6, clock_replacer.Size());
+
+  // Scenario: get three victims from the clock. All reference bits are set, so the first sweep clears them
+  // and the second one evicts in clock order.
+  int value;
+  clock_replacer.Victim(&value);
+  EXPECT_EQ(1, value);
+  clock_replacer.Victim(&value);
+  EXPECT_EQ(2, value);
+  clock_replacer.Victim(&value);
+  EXPECT_EQ(3, value);
+
+  // Scenario: pin elements in the replacer.
+  // Note that 3 has already been victimized, so pinning 3 should have no effect.
+  clock_replacer.Pin(3);
+  clock_replacer.Pin(4);
+  EXPECT_EQ(2, clock_replacer.Size());
+
+  // Scenario: unpin 4. Its reference bit is set again, so the hand gives it a second chance.
+  clock_replacer.Unpin(4);
+
+  // Scenario: continue looking for victims.
+  clock_replacer.Victim(&value);
+  EXPECT_EQ(5, value);
+  clock_replacer.Victim(&value);
+  EXPECT_EQ(6, value);
+  clock_replacer.Victim(&value);
+  EXPECT_EQ(4, value);
+  EXPECT_FALSE(clock_replacer.Victim(&value));
+  EXPECT_EQ(0, clock_replacer.Size());
+}
+
+TEST(ClockReplacerTest, ConcurrentTest) {
+  const int num_threads = 4;
+  const int frames_per_thread = 64;
+  ClockReplacer clock_replacer(num_threads * frames_per_thread);
+
+  // Scenario: every thread pins and unpins its own frames, leaving the odd ones evictable.
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; t++) {
+    threads.emplace_back([&clock_replacer, t] {
+      for (int round = 0; round < 100; round++) {
+        for (int i = 0; i < frames_per_thread; i++) {
+          frame_id_t frame_id = t * frames_per_thread + i;
+          clock_replacer.Pin(frame_id);
+          if (round < 99 || i % 2 == 1) {
+            clock_replacer.Unpin(frame_id);
+          }
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(num_threads * frames_per_thread / 2, clock_replacer.Size());
+
+  // Scenario: only the evictable frames are handed out, each of them exactly once.
+  int value;
+  std::vector<bool> seen(num_threads * frames_per_thread, false);
+  while (clock_replacer.Victim(&value)) {
+    EXPECT_EQ(1, value % 2);
+    EXPECT_FALSE(seen[value]);
+    seen[value] = true;
+  }
+  EXPECT_EQ(0, clock_replacer.Size());
+}
@@ -0,0 +1,72 @@
+#include <cstring>
+#include <random>
+
+#include "buffer/compressed_page_cache.h"
+#include "buffer/lz_codec.h"
+#include "gtest/gtest.h"
+
+TEST(CompressedPageCacheTest, CodecTest) {
+  char page[PAGE_SIZE];
+  char compressed[PAGE_SIZE];
+  char restored[PAGE_SIZE];
+
+  // Scenario: fixed width text rows and zeroed free space compress several times and come back unchanged.
+  memset(page, 0, PAGE_SIZE);
+  for (int i = 0; i < 64; i++) {
+    snprintf(page + i * 32, 32, "name-%04d%22s", i, "");
+  }
+  size_t size = LZCodec::Compress(page, PAGE_SIZE, compressed, PAGE_SIZE);
+  ASSERT_NE(0, size);
+  EXPECT_LT(size * 4, static_cast<size_t>(PAGE_SIZE));
+  ASSERT_TRUE(LZCodec::Decompress(compressed, size, restored, PAGE_SIZE));
+  EXPECT_EQ(0, memcmp(page, restored, PAGE_SIZE));
+
+  // Scenario: random bytes do not fit into a smaller buffer, but round trip with enough room.
+  std::mt19937 rng(3);
+  for (char &byte : page) {
+    byte = static_cast<char>(rng());
+  }
+  EXPECT_EQ(0, LZCodec::Compress(page, PAGE_SIZE, compressed, PAGE_SIZE / 2));
+  char large[2 * PAGE_SIZE];
+  size = LZCodec::Compress(page, PAGE_SIZE, large, sizeof(large));
+  ASSERT_NE(0, size);
+  ASSERT_TRUE(LZCodec::Decompress(large, size, restored, PAGE_SIZE));
+  EXPECT_EQ(0, memcmp(page, restored, PAGE_SIZE));
+
+  // Scenario: a truncated block is detected.
+  EXPECT_FALSE(LZCodec::Decompress(large, size - 1, restored, PAGE_SIZE));
+}
+
+TEST(CompressedPageCacheTest, CapacityTest) {
+  char page[PAGE_SIZE];
+  char restored[PAGE_SIZE];
+  CompressedPageCache cache(1024);
+
+  // Scenario: the cache keeps the newest pages that fit into its capacity.
+  for (page_id_t i = 0; i < 100; i++) {
+    memset(page, 'a' + i % 26, PAGE_SIZE);
+    EXPECT_TRUE(cache.Insert(i, page));
+    EXPECT_LE(cache.GetBytes(), 1024);
+  }
+  EXPECT_LT(cache.GetPages(), 100);
+  EXPECT_EQ(100 - cache.GetPages(), cache.GetEvictions());
+  EXPECT_FALSE(cache.Take(0, restored));
+  ASSERT_TRUE(cache.Take(99, restored));
+  memset(page, 'a' + 99 % 26, PAGE_SIZE);
+  EXPECT_EQ(0, memcmp(page, restored, PAGE_SIZE));
+
+  // Scenario: a page is taken out of the cache once found.
+  EXPECT_FALSE(cache.Take(99, restored));
+  EXPECT_EQ(3, cache.GetLookups());
+  EXPECT_EQ(1, cache.GetHits());
+
+  // Scenario: shrinking drops the oldest pages, disabling empties the cache.
+  uint64_t pages = cache.GetPages();
+  cache.SetCapacity(cache.GetBytes() / 2);
+  EXPECT_LT(cache.GetPages(), pages);
+  EXPECT_TRUE(cache.Take(98, restored));
+  cache.SetCapacity(0);
+  EXPECT_EQ(0, cache.GetPages());
+  EXPECT_EQ(0, cache.GetBytes());
+  EXPECT_FALSE(cache.Insert(0, page));
+}
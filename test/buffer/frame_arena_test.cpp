@@ -0,0 +1,74 @@
+#include <cstdint>
+#include <cstring>
+
+#include "buffer/frame_arena.h"
+#include "gtest/gtest.h"
+
+TEST(FrameArenaTest, LayoutTest) {
+  const size_t num_frames = 1024;
+  FrameArena arena(num_frames, true);
+  EXPECT_EQ(num_frames, arena.GetNumFrames());
+
+  // Scenario: the payloads are one contiguous, page aligned region, and huge page backed pools are aligned to a
+  // huge page.
+  size_t alignment = arena.UsesHugePages() ? FRAME_ARENA_HUGE_PAGE_SIZE : PAGE_SIZE;
+  EXPECT_EQ(0, reinterpret_cast<uintptr_t>(arena.GetData(0)) % alignment);
+  for (size_t i = 1; i < num_frames; i++) {
+    EXPECT_EQ(arena.GetData(i - 1) + PAGE_SIZE, arena.GetData(i));
+  }
+
+  // Scenario: the pages point into the arena, and start out empty and zeroed.
+  for (size_t i = 0; i < num_frames; i++) {
+    Page *page = arena.GetPage(i);
+    EXPECT_EQ(arena.GetData(i), page->GetData());
+    EXPECT_EQ(INVALID_PAGE_ID, page->GetPageId());
+    EXPECT_EQ(0, page->GetPinCount());
+    EXPECT_FALSE(page->IsDirty());
+    EXPECT_EQ(0, page->GetData()[PAGE_SIZE - 1]);
+  }
+
+  // Scenario: metadata written through the arena is what the page reports.
+  arena.PageId(7) = 42;
+  arena.PinCount(7) = 3;
+  arena.IsDirty(7) = true;
+  EXPECT_EQ(42, arena.GetPage(7)->GetPageId());
+  EXPECT_EQ(3, arena.GetPage(7)->GetPinCount());
+  EXPECT_TRUE(arena.GetPage(7)->IsDirty());
+  EXPECT_EQ(INVALID_PAGE_ID, arena.GetPage(8)->GetPageId());
+}
+
+TEST(FrameArenaTest, StandalonePageTest) {
+  // Scenario: a page that does not belong to a pool owns its data and book-keeping information.
+  Page page;
+  EXPECT_NE(nullptr, page.GetData());
+  EXPECT_EQ(INVALID_PAGE_ID, page.GetPageId());
+  EXPECT_EQ(0, page.GetPinCount());
+  EXPECT_FALSE(page.IsDirty());
+  page.SetLSN(5);
+  EXPECT_EQ(5, page.GetLSN());
+}
+
+TEST(FrameArenaTest, ResizeTest) {
+  FrameArena arena(16, false, 64);
+  EXPECT_EQ(64, arena.GetMaxFrames());
+  char *first = arena.GetData(0);
+  memset(first, 'x', PAGE_SIZE);
+
+  // Scenario: growing keeps the existing frames in place and adds empty, zeroed ones.
+  arena.Resize(64);
+  EXPECT_EQ(64, arena.GetNumFrames());
+  EXPECT_EQ(first, arena.GetData(0));
+  EXPECT_EQ('x', arena.GetData(0)[PAGE_SIZE - 1]);
+  for (size_t i = 16; i < 64; i++) {
+    EXPECT_EQ(INVALID_PAGE_ID, arena.GetPage(i)->GetPageId());
+    EXPECT_EQ(0, arena.GetData(i)[0]);
+  }
+
+  // Scenario: frames that come back after a shrink are empty again.
+  memset(arena.GetData(40), 'y', PAGE_SIZE);
+  arena.Resize(8);
+  EXPECT_EQ(8, arena.GetNumFrames());
+  arena.Resize(48);
+  EXPECT_EQ(0, arena.GetData(40)[0]);
+  EXPECT_EQ(first, arena.GetData(0));
+}
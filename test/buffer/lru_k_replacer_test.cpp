@@ -0,0 +1,74 @@
+#include "buffer/lru_k_replacer.h"
+#include "gtest/gtest.h"
+
+TEST(LRUKReplacerTest, SampleTest) {
+  LRUKReplacer lru_k_replacer(7, 2);
+
+  // Scenario: access frames 1~5 once and frame 1 again, then make all of them evictable.
+  for (frame_id_t i = 1; i <= 5; i++) {
+    lru_k_replacer.Pin(i);
+  }
+  lru_k_replacer.Pin(1);
+  for (frame_id_t i = 1; i <= 5; i++) {
+    lru_k_replacer.Unpin(i);
+  }
+  EXPECT_EQ(5, lru_k_replacer.Size());
+
+  // Scenario: frames accessed only once have an infinite backward k-distance and go first, oldest first.
+  int value;
+  lru_k_replacer.Victim(&value);
+  EXPECT_EQ(2, value);
+  lru_k_replacer.Victim(&value);
+  EXPECT_EQ(3, value);
+  EXPECT_EQ(3, lru_k_replacer.Size());
+
+  // Scenario: a second access to frame 4 moves it out of the history list.
+  lru_k_replacer.Pin(4);
+  EXPECT_EQ(2, lru_k_replacer.Size());
+  lru_k_replacer.Unpin(4);
+  lru_k_replacer.Victim(&value);
+  EXPECT_EQ(5, value);
+
+  // Scenario: frames 1 and 4 both have two accesses, frame 1's second most recent access is older.
+  lru_k_replacer.Victim(&value);
+  EXPECT_EQ(1, value);
+  lru_k_replacer.Victim(&value);
+  EXPECT_EQ(4, value);
+  EXPECT_FALSE(lru_k_replacer.Victim(&value));
+  EXPECT_EQ(0, lru_k_replacer.Size());
+}
+
+TEST(LRUKReplacerTest, ScanResistanceTest) {
+  LRUKReplacer lru_k_replacer(16, 2);
+
+  // Scenario: frame 0 is hot, frames 1~8 are touched once by a scan.
+  lru_k_replacer.Pin(0);
+  lru_k_replacer.Unpin(0);
+  lru_k_replacer.Pin(0);
+  lru_k_replacer.Unpin(0);
+  for (frame_id_t i = 1; i <= 8; i++) {
+    lru_k_replacer.Pin(i);
+    lru_k_replacer.Unpin(i);
+  }
+
+  // Scenario: the scanned frames are all evicted before the hot one.
+  int value;
+  for (frame_id_t i = 1; i <= 8; i++) {
+    ASSERT_TRUE(lru_k_replacer.Victim(&value));
+    EXPECT_EQ(i, value);
+  }
+  ASSERT_TRUE(lru_k_replacer.Victim(&value));
+  EXPECT_EQ(0, value);
+
+  // Scenario: a removed frame forgets its history.
+  lru_k_replacer.Pin(3);
+  lru_k_replacer.Pin(3);
+  lru_k_replacer.Remove(3);
+  lru_k_replacer.Pin(3);
+  lru_k_replacer.Unpin(3);
+  lru_k_replacer.Pin(4);
+  lru_k_replacer.Pin(4);
+  lru_k_replacer.Unpin(4);
+  ASSERT_TRUE(lru_k_replacer.Victim(&value));
+  EXPECT_EQ(3, value);
+}
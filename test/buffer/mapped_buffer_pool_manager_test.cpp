@@ -0,0 +1,110 @@
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "buffer/mapped_buffer_pool_manager.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+/** Create a database with num_pages pages, each holding "page <id>". */
+void CreateDatabase(const std::string &db_name, size_t num_pages) {
+  remove(db_name.c_str());
+  DiskManager disk_manager(db_name);
+  BufferPoolManagerInstance bpm(8, &disk_manager);
+  for (size_t i = 0; i < num_pages; i++) {
+    page_id_t page_id;
+    Page *page = bpm.NewPage(page_id);
+    ASSERT_NE(nullptr, page);
+    snprintf(page->GetData(), PAGE_SIZE, "page %d", page_id);
+    bpm.UnpinPage(page_id, true);
+  }
+  bpm.FlushAllPages();
+}
+
+}  // namespace
+
+TEST(MappedBufferPoolManagerTest, FetchTest) {
+  const std::string db_name = "mapped_bpm_test.db";
+  CreateDatabase(db_name, 32);
+  DiskManager disk_manager(db_name, false, true);
+  ASSERT_TRUE(disk_manager.IsReadOnly());
+  MappedBufferPoolManager bpm(&disk_manager);
+
+  // Scenario: a fetched page points into the mapping, its data is not copied.
+  Page *page = bpm.FetchPage(5);
+  ASSERT_NE(nullptr, page);
+  EXPECT_EQ(disk_manager.GetMappedPage(5), page->GetData());
+  EXPECT_STREQ("page 5", page->GetData());
+  EXPECT_EQ(5, page->GetPageId());
+  EXPECT_EQ(1, page->GetPinCount());
+
+  // Scenario: a second fetch pins the same page, the page is dropped once it is unpinned twice.
+  EXPECT_EQ(page, bpm.FetchPage(5));
+  EXPECT_EQ(2, page->GetPinCount());
+  EXPECT_TRUE(bpm.UnpinPage(5, false));
+  EXPECT_TRUE(bpm.UnpinPage(5, false));
+  EXPECT_FALSE(bpm.UnpinPage(5, false));
+  EXPECT_TRUE(bpm.CheckAllUnpinned());
+
+  std::vector<Page *> pages = bpm.FetchPages({0, 31, 17});
+  ASSERT_EQ(3, pages.size());
+  EXPECT_STREQ("page 0", pages[0]->GetData());
+  EXPECT_STREQ("page 31", pages[1]->GetData());
+  EXPECT_STREQ("page 17", pages[2]->GetData());
+  for (auto id : {0, 31, 17}) {
+    bpm.UnpinPage(id, false);
+  }
+
+  // Scenario: a page past the end of the file cannot be fetched.
+  EXPECT_EQ(nullptr, bpm.FetchPage(100));
+  EXPECT_FALSE(bpm.IsPageFree(31));
+  EXPECT_TRUE(bpm.IsPageFree(32));
+
+  BufferPoolStats stats = bpm.GetStats();
+  EXPECT_EQ(6, stats.fetches_);
+  EXPECT_EQ(1, stats.hits_);
+  EXPECT_EQ(4, stats.misses_);
+  EXPECT_EQ(1, stats.failed_fetches_);
+  remove(db_name.c_str());
+}
+
+TEST(MappedBufferPoolManagerTest, RejectWriteTest) {
+  const std::string db_name = "mapped_bpm_test.db";
+  CreateDatabase(db_name, 4);
+  {
+    DiskManager disk_manager(db_name, false, true);
+    MappedBufferPoolManager bpm(&disk_manager);
+    page_id_t page_id;
+    EXPECT_EQ(nullptr, bpm.NewPage(page_id));
+    EXPECT_EQ(INVALID_PAGE_ID, page_id);
+    EXPECT_FALSE(bpm.DeletePage(1));
+    EXPECT_EQ(INVALID_PAGE_ID, disk_manager.AllocatePage());
+    disk_manager.DeAllocatePage(1);
+    EXPECT_FALSE(disk_manager.IsPageFree(1));
+
+    char data[PAGE_SIZE] = "overwritten";
+    disk_manager.WritePage(2, data);
+    std::vector<std::pair<page_id_t, const char *>> writes{{3, data}};
+    disk_manager.WritePages(writes);
+    disk_manager.Sync();
+    EXPECT_STREQ("page 2", disk_manager.GetMappedPage(2));
+    EXPECT_STREQ("page 3", disk_manager.GetMappedPage(3));
+
+    // a dirty unpin is only logged
+    ASSERT_NE(nullptr, bpm.FetchPage(0));
+    EXPECT_TRUE(bpm.UnpinPage(0, true));
+  }
+
+  // Scenario: the file is unchanged when it is opened for writing again.
+  DiskManager disk_manager(db_name);
+  EXPECT_FALSE(disk_manager.IsReadOnly());
+  EXPECT_EQ(nullptr, disk_manager.GetMappedPage(0));
+  char data[PAGE_SIZE];
+  disk_manager.ReadPage(2, data);
+  EXPECT_STREQ("page 2", data);
+  EXPECT_FALSE(disk_manager.IsPageFree(1));
+  EXPECT_TRUE(disk_manager.IsPageFree(4));
+  remove(db_name.c_str());
+}
@@ -0,0 +1,135 @@
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "buffer/parallel_buffer_pool_manager.h"
+#include "gtest/gtest.h"
+
+TEST(ParallelBufferPoolManagerTest, SampleTest) {
+  const std::string db_name = "parallel_bpm_test.db";
+  const size_t num_instances = 4;
+  const size_t pool_size = 2;
+
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new ParallelBufferPoolManager(num_instances, pool_size, disk_manager);
+  EXPECT_EQ(num_instances * pool_size, bpm->GetPoolSize());
+
+  // Scenario: new pages are spread round-robin over the shards until every frame is pinned.
+  page_id_t page_id_temp;
+  for (size_t i = 0; i < num_instances * pool_size; ++i) {
+    auto *page = bpm->NewPage(page_id_temp);
+    ASSERT_NE(nullptr, page);
+    EXPECT_EQ(i, page_id_temp);
+    snprintf(page->GetData(), PAGE_SIZE, "page %zu", i);
+  }
+
+  // Scenario: shard 0 is full, so the next page, which belongs to it, cannot be created and is given back.
+  EXPECT_EQ(nullptr, bpm->NewPage(page_id_temp));
+  EXPECT_TRUE(bpm->IsPageFree(num_instances * pool_size));
+
+  // Scenario: unpinning a page of shard 0 makes room for the next page of that shard.
+  EXPECT_TRUE(bpm->UnpinPage(0, true));
+  EXPECT_NE(nullptr, bpm->NewPage(page_id_temp));
+  EXPECT_EQ(num_instances * pool_size, page_id_temp);
+  EXPECT_TRUE(bpm->UnpinPage(page_id_temp, false));
+
+  // Scenario: pages written before eviction are read back from disk.
+  for (page_id_t i = 1; i < static_cast<page_id_t>(num_instances * pool_size); ++i) {
+    EXPECT_TRUE(bpm->UnpinPage(i, true));
+  }
+  EXPECT_TRUE(bpm->CheckAllUnpinned());
+  for (page_id_t i = 0; i < static_cast<page_id_t>(num_instances * pool_size); ++i) {
+    auto *page = bpm->FetchPage(i);
+    ASSERT_NE(nullptr, page);
+    EXPECT_EQ("page " + std::to_string(i), std::string(page->GetData()));
+    EXPECT_TRUE(bpm->UnpinPage(i, false));
+  }
+
+  // Scenario: deleting a page frees it on disk.
+  EXPECT_TRUE(bpm->DeletePage(3));
+  EXPECT_TRUE(bpm->IsPageFree(3));
+
+  delete bpm;
+  delete disk_manager;
+  remove(db_name.c_str());
+}
+
+TEST(ParallelBufferPoolManagerTest, ResizeTest) {
+  const std::string db_name = "parallel_bpm_test.db";
+  const size_t num_instances = 4;
+  const size_t pool_size = 2;
+
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new ParallelBufferPoolManager(num_instances, pool_size, disk_manager);
+
+  // Scenario: a size that does not divide by the shards is spread over them, rather than rounded down.
+  EXPECT_FALSE(bpm->ResizePool(num_instances - 1));
+  EXPECT_TRUE(bpm->ResizePool(num_instances * pool_size + 3));
+  EXPECT_EQ(num_instances * pool_size + 3, bpm->GetPoolSize());
+
+  // Scenario: a shard that cannot shrink because its pages stay pinned fails the whole resize.
+  page_id_t page_id_temp;
+  std::vector<page_id_t> page_ids;
+  for (size_t i = 0; i < num_instances * pool_size; ++i) {
+    ASSERT_NE(nullptr, bpm->NewPage(page_id_temp));
+    if (page_id_temp % num_instances == 0) {
+      page_ids.push_back(page_id_temp);
+    } else {
+      EXPECT_TRUE(bpm->UnpinPage(page_id_temp, false));
+    }
+  }
+  EXPECT_FALSE(bpm->ResizePool(num_instances));
+  EXPECT_LT(num_instances, bpm->GetPoolSize());
+  for (auto page_id : page_ids) {
+    EXPECT_TRUE(bpm->UnpinPage(page_id, false));
+  }
+  EXPECT_TRUE(bpm->ResizePool(num_instances));
+  EXPECT_EQ(num_instances, bpm->GetPoolSize());
+
+  delete bpm;
+  delete disk_manager;
+  remove(db_name.c_str());
+}
+
+TEST(ParallelBufferPoolManagerTest, ConcurrentTest) {
+  const std::string db_name = "parallel_bpm_test.db";
+  const int num_threads = 4;
+  const int pages_per_thread = 32;
+
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new ParallelBufferPoolManager(4, 8, disk_manager);
+
+  // Scenario: threads create, write, evict and read back their own pages concurrently.
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; t++) {
+    threads.emplace_back([bpm, t] {
+      std::vector<page_id_t> page_ids;
+      for (int i = 0; i < pages_per_thread; i++) {
+        page_id_t page_id;
+        Page *page = bpm->NewPage(page_id);
+        ASSERT_NE(nullptr, page);
+        snprintf(page->GetData(), PAGE_SIZE, "%d:%d", t, i);
+        page_ids.push_back(page_id);
+        EXPECT_TRUE(bpm->UnpinPage(page_id, true));
+      }
+      for (int i = 0; i < pages_per_thread; i++) {
+        Page *page = bpm->FetchPage(page_ids[i]);
+        ASSERT_NE(nullptr, page);
+        EXPECT_EQ(std::to_string(t) + ":" + std::to_string(i), std::string(page->GetData()));
+        EXPECT_TRUE(bpm->UnpinPage(page_ids[i], false));
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_TRUE(bpm->CheckAllUnpinned());
+
+  delete bpm;
+  delete disk_manager;
+  remove(db_name.c_str());
+}
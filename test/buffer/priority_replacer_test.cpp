@@ -0,0 +1,54 @@
+#include "buffer/lru_replacer.h"
+#include "buffer/priority_replacer.h"
+#include "gtest/gtest.h"
+
+TEST(PriorityReplacerTest, SampleTest) {
+  PriorityReplacer replacer(new LRUReplacer(10), new LRUReplacer(10), 10, 0.3);
+
+  // Scenario: frames 1 and 2 are protected, the normal frames are evicted first.
+  replacer.SetProtected(1, true);
+  replacer.SetProtected(2, true);
+  for (frame_id_t i = 1; i <= 5; i++) {
+    replacer.Unpin(i);
+  }
+  EXPECT_EQ(5, replacer.Size());
+  EXPECT_EQ(2, replacer.GetProtectedFrames());
+  std::vector<frame_id_t> priority = {2, 1, 5, 4, 3};
+  EXPECT_EQ(priority, replacer.GetFramesByPriority());
+  frame_id_t value;
+  ASSERT_TRUE(replacer.Victim(&value));
+  EXPECT_EQ(3, value);
+  ASSERT_TRUE(replacer.Victim(&value));
+  EXPECT_EQ(4, value);
+
+  // Scenario: an unpinned frame that loses its protection becomes the next victim of the normal class.
+  replacer.SetProtected(1, false);
+  EXPECT_EQ(1, replacer.GetProtectedFrames());
+  ASSERT_TRUE(replacer.Victim(&value));
+  EXPECT_EQ(5, value);
+  ASSERT_TRUE(replacer.Victim(&value));
+  EXPECT_EQ(1, value);
+
+  // Scenario: protected frames are evicted once no normal frame is evictable.
+  ASSERT_TRUE(replacer.Victim(&value));
+  EXPECT_EQ(2, value);
+  EXPECT_FALSE(replacer.Victim(&value));
+
+  // Scenario: a pinned frame that becomes protected stays pinned.
+  replacer.SetProtected(6, true);
+  replacer.Pin(6);
+  replacer.SetProtected(6, false);
+  EXPECT_EQ(0, replacer.Size());
+
+  // Scenario: protected frames beyond the limit are evicted before the normal ones.
+  for (frame_id_t i = 0; i < 4; i++) {
+    replacer.SetProtected(i, true);
+    replacer.Unpin(i);
+  }
+  replacer.Unpin(7);
+  ASSERT_TRUE(replacer.Victim(&value));
+  EXPECT_EQ(0, value);
+  replacer.SetProtected(0, false);
+  ASSERT_TRUE(replacer.Victim(&value));
+  EXPECT_EQ(7, value);
+}
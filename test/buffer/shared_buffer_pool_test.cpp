@@ -0,0 +1,71 @@
+#include <cstdio>
+#include <string>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "buffer/shared_buffer_pool.h"
+#include "gtest/gtest.h"
+
+TEST(SharedBufferPoolTest, RebalanceTest) {
+  const std::string db_names[] = {"shared_pool_test_0.db", "shared_pool_test_1.db"};
+  const size_t pool_size = 64;
+
+  SharedBufferPool shared_pool(pool_size, 0);
+  DiskManager *disk_managers[2];
+  BufferPoolManagerInstance *bpms[2];
+  for (int i = 0; i < 2; ++i) {
+    remove(db_names[i].c_str());
+    disk_managers[i] = new DiskManager(db_names[i]);
+    bpms[i] = new BufferPoolManagerInstance(pool_size, disk_managers[i]);
+  }
+
+  // Scenario: without load the budget is split evenly, and the quotas add up to the budget.
+  shared_pool.Register(bpms[0], 8);
+  shared_pool.Register(bpms[1], 8);
+  EXPECT_EQ(32, shared_pool.GetQuota(bpms[0]).frames_);
+  EXPECT_EQ(32, shared_pool.GetQuota(bpms[1]).frames_);
+  EXPECT_EQ(32, bpms[0]->GetStats().frame_quota_);
+
+  // Scenario: a busy database takes the frames of an idle one, down to its minimum.
+  page_id_t page_id_temp;
+  for (int i = 0; i < 48; ++i) {
+    ASSERT_NE(nullptr, bpms[0]->NewPage(page_id_temp));
+    EXPECT_TRUE(bpms[0]->UnpinPage(page_id_temp, true));
+  }
+  for (int round = 0; round < 4; ++round) {
+    for (page_id_t i = 0; i < 48; ++i) {
+      ASSERT_NE(nullptr, bpms[0]->FetchPage(i));
+      EXPECT_TRUE(bpms[0]->UnpinPage(i, false));
+    }
+    shared_pool.Rebalance();
+  }
+  SharedBufferPoolQuota busy = shared_pool.GetQuota(bpms[0]);
+  SharedBufferPoolQuota idle = shared_pool.GetQuota(bpms[1]);
+  EXPECT_GT(busy.load_, idle.load_);
+  EXPECT_GE(busy.frames_, 48);
+  EXPECT_GE(idle.frames_, 8);
+  EXPECT_EQ(pool_size, busy.frames_ + idle.frames_);
+
+  // Scenario: the maximum caps a database, what it cannot take goes to the other one.
+  EXPECT_TRUE(shared_pool.SetLimits(bpms[0], 8, 16));
+  EXPECT_EQ(16, shared_pool.GetQuota(bpms[0]).frames_);
+  EXPECT_EQ(48, shared_pool.GetQuota(bpms[1]).frames_);
+  EXPECT_EQ(16, bpms[0]->GetStats().resident_pages_);
+
+  // Scenario: minimums that do not fit into the budget are refused.
+  EXPECT_FALSE(shared_pool.SetLimits(bpms[1], 60, 64));
+  EXPECT_FALSE(shared_pool.SetLimits(bpms[1], 16, 8));
+
+  // Scenario: the frames of an unregistered database go to the others.
+  shared_pool.Unregister(bpms[1]);
+  EXPECT_EQ(0, shared_pool.GetQuota(bpms[1]).frames_);
+  EXPECT_EQ(16, shared_pool.GetQuota(bpms[0]).frames_);
+  EXPECT_TRUE(shared_pool.SetLimits(bpms[0], 8, pool_size));
+  EXPECT_EQ(pool_size, shared_pool.GetQuota(bpms[0]).frames_);
+
+  shared_pool.Unregister(bpms[0]);
+  for (int i = 0; i < 2; ++i) {
+    delete bpms[i];
+    delete disk_managers[i];
+    remove(db_names[i].c_str());
+  }
+}
@@ -66,3 +66,20 @@ TEST(BPlusTreeTests, SampleTest) {
     ASSERT_EQ(kv_map[delete_seq[i]], ans[ans.size() - 1]);
   }
 }
+
+TEST(BPlusTreeTests, DestroyTest) {
+  DBStorageEngine engine(db_name);
+  BasicComparator<int> comparator;
+  auto *meta_page = reinterpret_cast<DiskFileMetaPage *>(engine.disk_mgr_->GetMetaData());
+  uint32_t allocated_pages = meta_page->GetAllocatedPages();
+  BPlusTree<int, int, BasicComparator<int>> tree(0, engine.bpm_, comparator, 4, 4);
+  for (int i = 0; i < 1000; i++) {
+    tree.Insert(i, i);
+  }
+  ASSERT_GT(meta_page->GetAllocatedPages(), allocated_pages + 1);
+  // Every page of the tree, leaf or internal, is given back.
+  tree.Destroy();
+  EXPECT_TRUE(tree.IsEmpty());
+  EXPECT_EQ(allocated_pages, meta_page->GetAllocatedPages());
+  EXPECT_TRUE(engine.bpm_->CheckAllUnpinned());
+}
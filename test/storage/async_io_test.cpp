@@ -0,0 +1,103 @@
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "storage/async_io.h"
+#include "storage/disk_manager.h"
+
+namespace {
+
+/** Write 64 pages through a batch, read them back in reverse through another one and check the data. */
+void CheckRoundTrip(bool use_io_uring) {
+  const std::string file_name = "async_io_test.db";
+  const size_t num_pages = 64;
+  remove(file_name.c_str());
+  int fd = open(file_name.c_str(), O_RDWR | O_CREAT, 0644);
+  ASSERT_GE(fd, 0);
+  AsyncIO async_io(fd, 8, use_io_uring);
+
+  std::vector<char> written(num_pages * PAGE_SIZE);
+  std::vector<iovec> iov(num_pages);
+  std::vector<AsyncIORequest> requests(num_pages);
+  for (size_t i = 0; i < num_pages; i++) {
+    memset(&written[i * PAGE_SIZE], static_cast<int>(i + 1), PAGE_SIZE);
+    iov[i] = {&written[i * PAGE_SIZE], PAGE_SIZE};
+    requests[i].write_ = true;
+    requests[i].offset_ = static_cast<off_t>(i) * PAGE_SIZE;
+    requests[i].iov_ = &iov[i];
+    requests[i].iov_count_ = 1;
+  }
+  std::vector<bool> completed(num_pages, false);
+  async_io.Run(requests, [&](size_t index) {
+    EXPECT_FALSE(completed[index]);
+    completed[index] = true;
+  });
+  for (size_t i = 0; i < num_pages; i++) {
+    EXPECT_TRUE(completed[i]);
+    EXPECT_EQ(PAGE_SIZE, requests[i].result_);
+  }
+
+  std::vector<char> read(num_pages * PAGE_SIZE);
+  for (size_t i = 0; i < num_pages; i++) {
+    iov[i] = {&read[(num_pages - 1 - i) * PAGE_SIZE], PAGE_SIZE};
+    requests[i].write_ = false;
+    requests[i].result_ = 0;
+  }
+  async_io.Run(requests);
+  for (size_t i = 0; i < num_pages; i++) {
+    EXPECT_EQ(PAGE_SIZE, requests[i].result_);
+    EXPECT_EQ(0, memcmp(&written[i * PAGE_SIZE], &read[(num_pages - 1 - i) * PAGE_SIZE], PAGE_SIZE));
+  }
+
+  // Scenario: a read past the end of the file completes with 0 bytes.
+  requests.resize(1);
+  requests[0].offset_ = static_cast<off_t>(num_pages) * PAGE_SIZE;
+  async_io.Run(requests);
+  EXPECT_EQ(0, requests[0].result_);
+
+  close(fd);
+  remove(file_name.c_str());
+}
+
+}  // namespace
+
+TEST(AsyncIOTest, IOUringTest) {
+  // falls back to the thread pool where io_uring is not available, the results must be the same
+  CheckRoundTrip(true);
+}
+
+TEST(AsyncIOTest, ThreadPoolTest) { CheckRoundTrip(false); }
+
+TEST(AsyncIOTest, DiskManagerBatchTest) {
+  const std::string db_name = "async_io_disk_test.db";
+  remove(db_name.c_str());
+  auto *disk_mgr = new DiskManager(db_name);
+  std::vector<char> data(16 * PAGE_SIZE);
+  std::vector<std::pair<page_id_t, const char *>> writes;
+  for (int i = 0; i < 16; i++) {
+    page_id_t page_id = disk_mgr->AllocatePage();
+    snprintf(&data[i * PAGE_SIZE], PAGE_SIZE, "page %d", page_id);
+    writes.emplace_back(page_id, &data[i * PAGE_SIZE]);
+  }
+  disk_mgr->WritePages(writes);
+
+  // Scenario: a batch read fills every buffer, including a page that was never written.
+  std::vector<char> buffers(17 * PAGE_SIZE, 'x');
+  std::vector<std::pair<page_id_t, char *>> reads;
+  for (int i = 0; i < 17; i++) {
+    reads.emplace_back(i, &buffers[i * PAGE_SIZE]);
+  }
+  size_t completed = 0;
+  disk_mgr->ReadPages(reads, [&](size_t) { completed++; });
+  EXPECT_EQ(17, completed);
+  for (int i = 0; i < 16; i++) {
+    EXPECT_STREQ(("page " + std::to_string(i)).c_str(), &buffers[i * PAGE_SIZE]);
+  }
+  EXPECT_EQ(0, buffers[16 * PAGE_SIZE]);
+  delete disk_mgr;
+  remove(db_name.c_str());
+}
@@ -1,9 +1,27 @@
+#include <sys/stat.h>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
 #include <unordered_set>
+#include <vector>
 
 #include "glog/logging.h"
 #include "gtest/gtest.h"
 #include "storage/disk_manager.h"
 
+namespace {
+
+/** Remove a database and its segment files, which outgrow the first one quickly at large page sizes. */
+void RemoveDatabase(const std::string &db_name) {
+  remove(db_name.c_str());
+  for (size_t segment = 1; remove((db_name + "." + std::to_string(segment)).c_str()) == 0; segment++) {
+  }
+}
+
+}  // namespace
+
 TEST(DiskManagerTest, BitMapPageTest) {
   const size_t size = 512;
   char buf[size];
@@ -62,5 +80,437 @@ TEST(DiskManagerTest, FreePageAllocationTest) {
   EXPECT_EQ(extent_nums * DiskManager::BITMAP_SIZE - 5, meta_page->GetAllocatedPages());
   EXPECT_EQ(DiskManager::BITMAP_SIZE - 2, meta_page->GetExtentUsedPage(0));
   EXPECT_EQ(DiskManager::BITMAP_SIZE - 3, meta_page->GetExtentUsedPage(1));
-  remove(db_name.c_str());
-}
\ No newline at end of file
+  RemoveDatabase(db_name);
+}
+TEST(DiskManagerTest, DirectIOTest) {
+  std::string db_name = "disk_direct_test.db";
+  RemoveDatabase(db_name);
+  auto *disk_mgr = new DiskManager(db_name, true);
+  // the file system of the test directory may not support O_DIRECT, the result must not depend on it
+  LOG(INFO) << "direct I/O " << (disk_mgr->IsDirectIO() ? "enabled" : "not supported");
+
+  alignas(DISK_IO_ALIGNMENT) char aligned[PAGE_SIZE];
+  char buffer[PAGE_SIZE + 1];
+  char *unaligned = buffer + 1;
+  std::vector<page_id_t> page_ids;
+  for (int i = 0; i < 4; i++) {
+    page_ids.push_back(disk_mgr->AllocatePage());
+  }
+  snprintf(aligned, PAGE_SIZE, "aligned page");
+  snprintf(unaligned, PAGE_SIZE, "unaligned page");
+  disk_mgr->WritePage(page_ids[0], aligned);
+  disk_mgr->WritePage(page_ids[1], unaligned);
+  std::vector<std::pair<page_id_t, const char *>> batch{{page_ids[2], aligned}, {page_ids[3], unaligned}};
+  disk_mgr->WritePages(batch);
+  disk_mgr->Sync();
+  delete disk_mgr;
+
+  // Scenario: the pages read back the same from a fresh disk manager, into aligned and unaligned buffers.
+  disk_mgr = new DiskManager(db_name, true);
+  for (int i = 0; i < 4; i++) {
+    disk_mgr->ReadPage(page_ids[i], i % 2 == 0 ? unaligned : aligned);
+    EXPECT_STREQ(i % 2 == 0 ? "aligned page" : "unaligned page", i % 2 == 0 ? unaligned : aligned);
+  }
+  EXPECT_FALSE(disk_mgr->IsPageFree(page_ids[3]));
+  delete disk_mgr;
+  RemoveDatabase(db_name);
+}
+
+TEST(DiskManagerTest, BitmapHintTest) {
+  // Scenario: the search hint only skips allocated pages, also across words and in the bytes after the last word.
+  const size_t size = 17;
+  char buf[size];
+  memset(buf, 0, size);
+  auto *bitmap = reinterpret_cast<BitmapPage<size> *>(buf);
+  auto num_pages = bitmap->GetMaxSupportedSize();
+  ASSERT_EQ(72, num_pages);
+  uint32_t ofs;
+  for (uint32_t i = 0; i < num_pages; i++) {
+    ASSERT_TRUE(bitmap->AllocatePage(ofs));
+    ASSERT_EQ(i, ofs);
+  }
+  ASSERT_FALSE(bitmap->AllocatePage(ofs));
+  ASSERT_TRUE(bitmap->DeAllocatePage(70));
+  ASSERT_TRUE(bitmap->DeAllocatePage(9));
+  ASSERT_TRUE(bitmap->DeAllocatePage(63));
+  for (uint32_t expected : {9, 63, 70}) {
+    ASSERT_TRUE(bitmap->AllocatePage(ofs));
+    EXPECT_EQ(expected, ofs);
+  }
+  ASSERT_FALSE(bitmap->AllocatePage(ofs));
+  EXPECT_FALSE(bitmap->IsPageFree(num_pages));
+
+  // Scenario: the last allocated page is found in the bytes after the last word and inside a word.
+  ASSERT_TRUE(bitmap->FindLastAllocated(ofs));
+  EXPECT_EQ(num_pages - 1, ofs);
+  for (uint32_t i = 70; i > 9; i--) {
+    ASSERT_TRUE(bitmap->DeAllocatePage(i + 1));
+  }
+  ASSERT_TRUE(bitmap->FindLastAllocated(ofs));
+  EXPECT_EQ(10, ofs);
+  for (uint32_t i = 0; i <= 10; i++) {
+    ASSERT_TRUE(bitmap->DeAllocatePage(i));
+  }
+  EXPECT_FALSE(bitmap->FindLastAllocated(ofs));
+}
+
+TEST(DiskManagerTest, BitmapPersistenceTest) {
+  std::string db_name = "disk_bitmap_test.db";
+  RemoveDatabase(db_name);
+  auto *disk_mgr = new DiskManager(db_name);
+  for (uint32_t i = 0; i < DiskManager::BITMAP_SIZE + 10; i++) {
+    ASSERT_EQ(i, disk_mgr->AllocatePage());
+  }
+  disk_mgr->DeAllocatePage(5);
+  disk_mgr->DeAllocatePage(5);
+  // Scenario: allocating in the first extent again does not lose the second one.
+  ASSERT_EQ(5, disk_mgr->AllocatePage());
+  disk_mgr->DeAllocatePage(7);
+  disk_mgr->DeAllocatePage(DiskManager::BITMAP_SIZE + 3);
+  auto *meta_page = reinterpret_cast<DiskFileMetaPage *>(disk_mgr->GetMetaData());
+  EXPECT_EQ(2, meta_page->GetExtentNums());
+  EXPECT_EQ(DiskManager::BITMAP_SIZE + 8, meta_page->GetAllocatedPages());
+  delete disk_mgr;
+
+  // Scenario: the bitmaps are written back at shutdown and read again by a fresh disk manager.
+  disk_mgr = new DiskManager(db_name);
+  EXPECT_TRUE(disk_mgr->IsPageFree(7));
+  EXPECT_FALSE(disk_mgr->IsPageFree(8));
+  EXPECT_TRUE(disk_mgr->IsPageFree(DiskManager::BITMAP_SIZE + 3));
+  EXPECT_FALSE(disk_mgr->IsPageFree(DiskManager::BITMAP_SIZE + 9));
+  EXPECT_TRUE(disk_mgr->IsPageFree(DiskManager::BITMAP_SIZE + 10));
+  EXPECT_EQ(7, disk_mgr->AllocatePage());
+  EXPECT_EQ(DiskManager::BITMAP_SIZE + 3, disk_mgr->AllocatePage());
+  EXPECT_EQ(DiskManager::BITMAP_SIZE + 10, disk_mgr->AllocatePage());
+  delete disk_mgr;
+  RemoveDatabase(db_name);
+}
+
+TEST(DiskManagerTest, PageSizeTest) {
+  std::string db_name = "disk_page_size_test.db";
+  RemoveDatabase(db_name);
+  auto *disk_mgr = new DiskManager(db_name);
+  ASSERT_EQ(0, disk_mgr->AllocatePage());
+  EXPECT_EQ(PAGE_SIZE, reinterpret_cast<DiskFileMetaPage *>(disk_mgr->GetMetaData())->GetPageSize());
+  delete disk_mgr;
+
+  // Scenario: the page size is written to the file and accepted by a disk manager of the same build.
+  disk_mgr = new DiskManager(db_name);
+  EXPECT_FALSE(disk_mgr->IsPageFree(0));
+  delete disk_mgr;
+
+  // Scenario: a file created with another page size is refused instead of being read with the wrong layout.
+  FILE *file = fopen(db_name.c_str(), "r+b");
+  ASSERT_NE(nullptr, file);
+  uint32_t other_page_size = PAGE_SIZE * 2;
+  fseek(file, offsetof(DiskFileMetaPage, page_size_), SEEK_SET);
+  fwrite(&other_page_size, sizeof(other_page_size), 1, file);
+  fclose(file);
+  EXPECT_THROW(DiskManager{db_name}, std::runtime_error);
+  RemoveDatabase(db_name);
+}
+
+TEST(DiskManagerTest, PageRunTest) {
+  std::string db_name = "disk_run_test.db";
+  RemoveDatabase(db_name);
+  auto *disk_mgr = new DiskManager(db_name);
+  const auto run_pages = static_cast<page_id_t>(BitmapPage<PAGE_SIZE>::RUN_PAGES);
+
+  // Scenario: two objects growing in turns each fill a run of their own, then start the next empty one.
+  page_id_t last[2] = {INVALID_PAGE_ID, INVALID_PAGE_ID};
+  std::vector<page_id_t> pages[2];
+  for (page_id_t i = 0; i < 3 * run_pages; i++) {
+    for (int object = 0; object < 2; object++) {
+      last[object] = disk_mgr->AllocatePageNear(last[object]);
+      pages[object].push_back(last[object]);
+    }
+  }
+  for (int object = 0; object < 2; object++) {
+    for (page_id_t i = 0; i < 3 * run_pages; i++) {
+      EXPECT_EQ(object * run_pages + i / run_pages * 2 * run_pages + i % run_pages, pages[object][i]);
+    }
+  }
+
+  // Scenario: a freed page is taken again by its own object, a plain allocation fills the first hole.
+  disk_mgr->DeAllocatePage(pages[0][3]);
+  disk_mgr->DeAllocatePage(pages[1][5]);
+  EXPECT_EQ(pages[1][5], disk_mgr->AllocatePageNear(pages[1][0]));
+  EXPECT_EQ(pages[0][3], disk_mgr->AllocatePage());
+  EXPECT_EQ(6 * run_pages, disk_mgr->AllocatePageNear(last[0]));
+
+  // Scenario: without runs an object takes the first free page.
+  disk_mgr->SetPageRuns(false);
+  EXPECT_EQ(6 * run_pages + 1, disk_mgr->AllocatePageNear(INVALID_PAGE_ID));
+  delete disk_mgr;
+  RemoveDatabase(db_name);
+}
+
+TEST(DiskManagerTest, SegmentTest) {
+  std::string db_name = "disk_segment_test.db";
+  const int64_t segment_size = 16 * PAGE_SIZE;
+  const page_id_t num_pages = 100;
+  auto fill = [](page_id_t page_id, char *data) { memset(data, 'a' + page_id % 26, PAGE_SIZE); };
+  RemoveDatabase(db_name);
+  auto *disk_mgr = new DiskManager(db_name, false, false, segment_size);
+  char data[PAGE_SIZE];
+  char buf[PAGE_SIZE];
+  // Scenario: single pages and a batch whose runs cross segment boundaries land in the right segment files.
+  std::vector<std::vector<char>> batch_data;
+  std::vector<std::pair<page_id_t, const char *>> batch;
+  for (page_id_t i = 0; i < num_pages; i++) {
+    fill(i, data);
+    if (i < num_pages / 2) {
+      disk_mgr->WritePage(i, data);
+    } else {
+      batch_data.emplace_back(data, data + PAGE_SIZE);
+    }
+  }
+  for (page_id_t i = num_pages / 2; i < num_pages; i++) {
+    batch.emplace_back(i, batch_data[i - num_pages / 2].data());
+  }
+  disk_mgr->WritePages(batch);
+  // pages 0 to 99 are physical pages 2 to 101
+  EXPECT_EQ(7, disk_mgr->GetSegmentCount());
+  delete disk_mgr;
+  for (int segment = 0; segment < 7; segment++) {
+    struct stat stat_buf {};
+    std::string file_name = segment == 0 ? db_name : db_name + "." + std::to_string(segment);
+    ASSERT_EQ(0, stat(file_name.c_str(), &stat_buf));
+    EXPECT_LE(stat_buf.st_size, segment_size);
+  }
+
+  // Scenario: the segments are found again, by a writable and by a mapped read-only disk manager.
+  disk_mgr = new DiskManager(db_name, false, false, segment_size);
+  EXPECT_EQ(7, disk_mgr->GetSegmentCount());
+  std::vector<std::vector<char>> read_data(num_pages, std::vector<char>(PAGE_SIZE));
+  std::vector<std::pair<page_id_t, char *>> reads;
+  for (page_id_t i = 0; i < num_pages; i++) {
+    reads.emplace_back(i, read_data[i].data());
+  }
+  disk_mgr->ReadPages(reads);
+  for (page_id_t i = 0; i < num_pages; i++) {
+    fill(i, data);
+    ASSERT_EQ(0, memcmp(read_data[i].data(), data, PAGE_SIZE));
+  }
+  delete disk_mgr;
+  disk_mgr = new DiskManager(db_name, false, true, segment_size);
+  for (page_id_t i = 0; i < num_pages; i++) {
+    fill(i, data);
+    ASSERT_NE(nullptr, disk_mgr->GetMappedPage(i));
+    ASSERT_EQ(0, memcmp(disk_mgr->GetMappedPage(i), data, PAGE_SIZE));
+  }
+  EXPECT_EQ(nullptr, disk_mgr->GetMappedPage(num_pages));
+  delete disk_mgr;
+  RemoveDatabase(db_name);
+
+  // Scenario: a database written as one file stays one file.
+  disk_mgr = new DiskManager(db_name, false, false, 0);
+  for (page_id_t i = 0; i < num_pages; i++) {
+    fill(i, data);
+    disk_mgr->WritePage(i, data);
+  }
+  delete disk_mgr;
+  disk_mgr = new DiskManager(db_name, false, false, segment_size);
+  EXPECT_EQ(0, disk_mgr->GetSegmentSize());
+  disk_mgr->WritePage(2 * num_pages, data);
+  EXPECT_EQ(1, disk_mgr->GetSegmentCount());
+  disk_mgr->ReadPage(num_pages - 1, buf);
+  fill(num_pages - 1, data);
+  EXPECT_EQ(0, memcmp(buf, data, PAGE_SIZE));
+  delete disk_mgr;
+  RemoveDatabase(db_name);
+}
+
+TEST(DiskManagerTest, ExtentDirectoryTest) {
+  std::string db_name = "disk_directory_test.db";
+  RemoveDatabase(db_name);
+  // one segment per group, so that the second group starts a sparse file of its own at every page size
+  const int64_t segment_size =
+      (1 + static_cast<int64_t>(EXTENTS_PER_DIRECTORY_PAGE) * (DiskManager::BITMAP_SIZE + 1)) * PAGE_SIZE;
+  auto *disk_mgr = new DiskManager(db_name, false, false, segment_size);
+  const page_id_t group_pages = EXTENTS_PER_DIRECTORY_PAGE * DiskManager::BITMAP_SIZE;
+  // Scenario: allocation goes on past the extents the meta page counts.
+  for (page_id_t i = 0; i < group_pages + 10; i++) {
+    ASSERT_EQ(i, disk_mgr->AllocatePage());
+  }
+  EXPECT_EQ(10, disk_mgr->GetExtentUsedPages(EXTENTS_PER_DIRECTORY_PAGE));
+  disk_mgr->DeAllocatePage(group_pages + 3);
+  disk_mgr->DeAllocatePage(17);
+  char data[PAGE_SIZE];
+  char buf[PAGE_SIZE];
+  memset(data, 'x', PAGE_SIZE);
+  disk_mgr->WritePage(group_pages + 9, data);
+  delete disk_mgr;
+
+  // Scenario: the directory page of the second group is read again, and its data pages do not overlap it.
+  disk_mgr = new DiskManager(db_name, false, false, segment_size);
+  EXPECT_EQ(2, disk_mgr->GetSegmentCount());
+  auto *meta_page = reinterpret_cast<DiskFileMetaPage *>(disk_mgr->GetMetaData());
+  EXPECT_EQ(EXTENTS_PER_DIRECTORY_PAGE + 1, meta_page->GetExtentNums());
+  EXPECT_EQ(group_pages + 8, meta_page->GetAllocatedPages());
+  EXPECT_EQ(9, disk_mgr->GetExtentUsedPages(EXTENTS_PER_DIRECTORY_PAGE));
+  EXPECT_EQ(DiskManager::BITMAP_SIZE - 1, disk_mgr->GetExtentUsedPages(0));
+  EXPECT_TRUE(disk_mgr->IsPageFree(group_pages + 3));
+  EXPECT_FALSE(disk_mgr->IsPageFree(group_pages + 4));
+  disk_mgr->ReadPage(group_pages + 9, buf);
+  EXPECT_EQ(0, memcmp(buf, data, PAGE_SIZE));
+  EXPECT_EQ(17, disk_mgr->AllocatePage());
+  EXPECT_EQ(group_pages + 3, disk_mgr->AllocatePage());
+  EXPECT_EQ(group_pages + 10, disk_mgr->AllocatePage());
+  delete disk_mgr;
+  RemoveDatabase(db_name);
+}
+
+TEST(DiskManagerTest, ShrinkTest) {
+  std::string db_name = "disk_shrink_test.db";
+  const int64_t segment_size = 16 * PAGE_SIZE;
+  const page_id_t num_pages = 100;
+  RemoveDatabase(db_name);
+  auto *disk_mgr = new DiskManager(db_name, false, false, segment_size);
+  auto allocated_blocks = [&] {
+    blkcnt_t blocks = 0;
+    for (size_t segment = 0; segment < disk_mgr->GetSegmentCount(); segment++) {
+      struct stat stat_buf {};
+      std::string file_name = segment == 0 ? db_name : db_name + "." + std::to_string(segment);
+      EXPECT_EQ(0, stat(file_name.c_str(), &stat_buf));
+      blocks += stat_buf.st_blocks;
+    }
+    return blocks;
+  };
+  char data[PAGE_SIZE];
+  char buf[PAGE_SIZE];
+  memset(data, 'x', PAGE_SIZE);
+  for (page_id_t i = 0; i < num_pages; i++) {
+    ASSERT_EQ(i, disk_mgr->AllocatePage());
+    disk_mgr->WritePage(i, data);
+  }
+  disk_mgr->Sync();
+  blkcnt_t blocks = allocated_blocks();
+
+  // Scenario: freed pages keep their blocks until the next Sync, except the ones allocated again.
+  for (page_id_t i = 10; i < 40; i++) {
+    disk_mgr->DeAllocatePage(i);
+  }
+  EXPECT_EQ(10, disk_mgr->AllocatePage());
+  disk_mgr->WritePage(10, data);
+  EXPECT_EQ(blocks, allocated_blocks());
+  disk_mgr->Sync();
+  if (disk_mgr->PunchesHoles()) {
+    EXPECT_EQ(blocks - 29 * PAGE_SIZE / 512, allocated_blocks());
+    disk_mgr->ReadPage(11, buf);
+    EXPECT_EQ(0, buf[0]);
+  }
+  disk_mgr->ReadPage(10, buf);
+  EXPECT_EQ(0, memcmp(buf, data, PAGE_SIZE));
+
+  // Scenario: shrinking cuts the file after the last allocated page and removes the segments past it.
+  for (page_id_t i = 50; i < num_pages; i++) {
+    disk_mgr->DeAllocatePage(i);
+  }
+  disk_mgr->DeAllocatePage(48);
+  // pages 0 to 99 are physical pages 2 to 101, page 49 is the fifth page of the fourth segment
+  EXPECT_EQ(static_cast<int64_t>(num_pages - 50) * PAGE_SIZE, disk_mgr->Shrink());
+  EXPECT_EQ(4, disk_mgr->GetSegmentCount());
+  EXPECT_EQ(52 * PAGE_SIZE, disk_mgr->GetFileSize());
+  EXPECT_EQ(0, disk_mgr->Shrink());
+  // page 45 ends the third segment, the fourth one is removed rather than left empty
+  for (page_id_t i : {46, 47, 49}) {
+    disk_mgr->DeAllocatePage(i);
+  }
+  EXPECT_EQ(4 * PAGE_SIZE, disk_mgr->Shrink());
+  EXPECT_EQ(3, disk_mgr->GetSegmentCount());
+  delete disk_mgr;
+  struct stat stat_buf {};
+  EXPECT_NE(0, stat((db_name + ".3").c_str(), &stat_buf));
+  ASSERT_EQ(0, stat((db_name + ".2").c_str(), &stat_buf));
+  EXPECT_EQ(segment_size, stat_buf.st_size);
+
+  // Scenario: the shrunk database opens with its pages, and allocation and writes grow it again.
+  disk_mgr = new DiskManager(db_name, false, false, segment_size);
+  EXPECT_EQ(3 * segment_size, disk_mgr->GetFileSize());
+  disk_mgr->ReadPage(45, buf);
+  EXPECT_EQ(0, memcmp(buf, data, PAGE_SIZE));
+  EXPECT_EQ(11, disk_mgr->AllocatePage());
+  EXPECT_FALSE(disk_mgr->IsPageFree(45));
+  EXPECT_TRUE(disk_mgr->IsPageFree(46));
+  disk_mgr->WritePage(num_pages, data);
+  EXPECT_EQ(7, disk_mgr->GetSegmentCount());
+  delete disk_mgr;
+
+  // Scenario: an empty database shrinks to its meta page.
+  disk_mgr = new DiskManager(db_name, false, false, segment_size);
+  for (page_id_t i = 0; i < num_pages; i++) {
+    disk_mgr->DeAllocatePage(i);
+  }
+  disk_mgr->Shrink();
+  EXPECT_EQ(PAGE_SIZE, disk_mgr->GetFileSize());
+  EXPECT_EQ(1, disk_mgr->GetSegmentCount());
+  EXPECT_EQ(0, reinterpret_cast<DiskFileMetaPage *>(disk_mgr->GetMetaData())->GetExtentNums());
+  EXPECT_EQ(0, disk_mgr->AllocatePage());
+  delete disk_mgr;
+  RemoveDatabase(db_name);
+}
+
+TEST(DiskManagerTest, IOStatsTest) {
+  // Scenario: latencies go to log2 buckets, and percentiles are the upper bound of the bucket by nearest rank.
+  EXPECT_EQ(0, LatencyHistogram::Bucket(0));
+  EXPECT_EQ(1, LatencyHistogram::Bucket(1));
+  EXPECT_EQ(2, LatencyHistogram::Bucket(2));
+  EXPECT_EQ(2, LatencyHistogram::Bucket(3));
+  EXPECT_EQ(11, LatencyHistogram::Bucket(1024));
+  EXPECT_EQ(LatencyHistogram::BUCKETS - 1, LatencyHistogram::Bucket(UINT64_MAX));
+  LatencyHistogram histogram;
+  EXPECT_EQ(0, histogram.Percentile(0.5));
+  histogram.buckets_[10] = 98;
+  histogram.buckets_[20] = 1;
+  histogram.buckets_[30] = 1;
+  EXPECT_EQ(100, histogram.Count());
+  EXPECT_EQ(uint64_t{1} << 10, histogram.Percentile(0.5));
+  EXPECT_EQ(uint64_t{1} << 20, histogram.Percentile(0.99));
+  EXPECT_EQ(uint64_t{1} << 30, histogram.Percentile(0.999));
+  EXPECT_EQ(uint64_t{1} << 10, histogram.Percentile(0));
+  histogram += histogram;
+  EXPECT_EQ(200, histogram.Count());
+
+  std::string db_name = "disk_test_io_stats.db";
+  RemoveDatabase(db_name);
+  auto *disk_manager = new DiskManager(db_name, false);
+  char data[PAGE_SIZE];
+  memset(data, 7, PAGE_SIZE);
+  DiskIOStats before = disk_manager->GetIOStats();
+
+  // Scenario: a page write and a page read are one operation each, a read past the end of the file is none.
+  disk_manager->WritePage(0, data);
+  disk_manager->ReadPage(0, data);
+  disk_manager->ReadPage(1000, data);
+  DiskIOStats stats = disk_manager->GetIOStats();
+  EXPECT_EQ(before.writes_ + 1, stats.writes_);
+  EXPECT_EQ(before.written_bytes_ + PAGE_SIZE, stats.written_bytes_);
+  EXPECT_EQ(before.reads_ + 1, stats.reads_);
+  EXPECT_EQ(before.read_bytes_ + PAGE_SIZE, stats.read_bytes_);
+
+  // Scenario: a batch writes a run of contiguous pages with one operation, and reads every page with one.
+  std::vector<char> buffer(4 * PAGE_SIZE, 3);
+  std::vector<std::pair<page_id_t, const char *>> writes;
+  std::vector<std::pair<page_id_t, char *>> reads;
+  for (page_id_t i = 0; i < 4; i++) {
+    writes.emplace_back(i + 1, buffer.data() + i * PAGE_SIZE);
+    reads.emplace_back(i + 1, buffer.data() + i * PAGE_SIZE);
+  }
+  disk_manager->WritePages(writes);
+  disk_manager->ReadPages(reads);
+  stats = disk_manager->GetIOStats();
+  EXPECT_EQ(before.writes_ + 2, stats.writes_);
+  EXPECT_EQ(before.written_bytes_ + 5 * PAGE_SIZE, stats.written_bytes_);
+  EXPECT_EQ(before.reads_ + 5, stats.reads_);
+  EXPECT_EQ(before.read_bytes_ + 5 * PAGE_SIZE, stats.read_bytes_);
+
+  // Scenario: every operation is in the latency histograms.
+  EXPECT_EQ(stats.reads_, stats.read_latency_.Count());
+  EXPECT_EQ(stats.writes_, stats.write_latency_.Count());
+  EXPECT_GT(stats.read_latency_.Percentile(0.5), 0);
+
+  disk_manager->Close();
+  delete disk_manager;
+  RemoveDatabase(db_name);
+}
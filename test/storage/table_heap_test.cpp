@@ -1,8 +1,11 @@
+#include <algorithm>
 #include <vector>
 #include <unordered_map>
 
 #include "common/instance.h"
 #include "gtest/gtest.h"
+#include "index/b_plus_tree.h"
+#include "index/basic_comparator.h"
 #include "record/field.h"
 #include "record/schema.h"
 #include "storage/table_heap.h"
@@ -54,3 +57,180 @@ TEST(TableHeapTest, TableHeapSampleTest) {
   }
 }
 
+
+TEST(TableHeapTest, RelocatePageTest) {
+  DBStorageEngine engine(db_file_name);
+  SimpleMemHeap heap;
+  const int row_nums = 1000;
+  std::vector<Column *> columns = {
+          ALLOC_COLUMN(heap)("id", TypeId::kTypeInt, 0, false, false),
+          ALLOC_COLUMN(heap)("name", TypeId::kTypeChar, 32, 1, true, false)
+  };
+  auto schema = std::make_shared<Schema>(columns);
+  // free pages below the table once the filler pages are deleted
+  std::vector<page_id_t> filler_ids(30);
+  for (auto &page_id : filler_ids) {
+    ASSERT_NE(nullptr, engine.bpm_->NewPage(page_id));
+    engine.bpm_->UnpinPage(page_id, false);
+  }
+  TableHeap *table_heap = TableHeap::Create(engine.bpm_, schema.get(), nullptr, nullptr, nullptr, &heap);
+  std::vector<Fields> row_values;
+  row_values.reserve(row_nums);
+  char characters[32];
+  for (int i = 0; i < row_nums; i++) {
+    RandomUtils::RandomString(characters, sizeof(characters));
+    row_values.push_back(Fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeChar, characters, sizeof(characters),
+                                                                   true)});
+    Row row(row_values.back());
+    ASSERT_TRUE(table_heap->InsertTuple(row, nullptr));
+  }
+  for (auto page_id : filler_ids) {
+    ASSERT_TRUE(engine.bpm_->DeletePage(page_id));
+  }
+  engine.Checkpoint();
+
+  std::vector<page_id_t> page_ids = table_heap->GetPageIds();
+  ASSERT_GT(page_ids.size(), 1);
+  page_id_t lowest = *std::min_element(page_ids.begin(), page_ids.end());
+  for (auto it = page_ids.rbegin(); it != page_ids.rend(); it++) {
+    page_id_t new_page_id;
+    ASSERT_TRUE(table_heap->RelocatePage(*it, new_page_id));
+    EXPECT_LT(new_page_id, lowest);
+  }
+  // nothing is left to move down
+  page_id_t new_page_id;
+  EXPECT_FALSE(table_heap->RelocatePage(table_heap->GetFirstPageId(), new_page_id));
+  ASSERT_EQ(page_ids.size(), table_heap->GetPageIds().size());
+
+  // the chain keeps its order, so the rows come back in insertion order
+  int i = 0;
+  for (auto iter = table_heap->Begin(nullptr); iter != table_heap->End(); iter++, i++) {
+    ASSERT_LT(i, row_nums);
+    Row row(iter->GetRowId());
+    ASSERT_TRUE(table_heap->GetTuple(&row, nullptr));
+    for (size_t j = 0; j < schema->GetColumnCount(); j++) {
+      ASSERT_EQ(CmpBool::kTrue, row.GetField(j)->CompareEquals(row_values[i][j]));
+    }
+  }
+  EXPECT_EQ(row_nums, i);
+  EXPECT_GT(engine.Shrink(), 0);
+}
+
+TEST(TableHeapTest, ReadOnlyTest) {
+  SimpleMemHeap heap;
+  std::vector<Column *> columns = {ALLOC_COLUMN(heap)("id", TypeId::kTypeInt, 0, false, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  page_id_t first_page_id;
+  RowId rid;
+  {
+    DBStorageEngine engine(db_file_name);
+    TableHeap *table_heap = TableHeap::Create(engine.bpm_, schema.get(), nullptr, nullptr, nullptr, &heap);
+    first_page_id = table_heap->GetFirstPageId();
+    Fields fields{Field(TypeId::kTypeInt, 1)};
+    Row row(fields);
+    ASSERT_TRUE(table_heap->InsertTuple(row, nullptr));
+    rid = row.GetRowId();
+  }
+
+  // Scenario: the writes to a database opened read-only are rejected instead of faulting on its mapped pages.
+  DBStorageEngine engine(db_file_name, false, DEFAULT_BUFFER_POOL_SIZE, ReplacerType::kLRU, 1, nullptr, true);
+  TableHeap *table_heap = TableHeap::Create(engine.bpm_, first_page_id, schema.get(), nullptr, nullptr, &heap);
+  Fields fields{Field(TypeId::kTypeInt, 2)};
+  Row row(fields);
+  EXPECT_FALSE(table_heap->InsertTuple(row, nullptr));
+  EXPECT_FALSE(table_heap->UpdateTuple(row, rid, nullptr));
+  EXPECT_FALSE(table_heap->MarkDelete(rid, nullptr));
+  TableInfo *table_info = nullptr;
+  EXPECT_EQ(DB_FAILED, engine.catalog_mgr_->CreateTable("t", schema.get(), nullptr, table_info));
+  BasicComparator<int> comparator;
+  BPlusTree<int, int, BasicComparator<int>> tree(0, engine.bpm_, comparator);
+  EXPECT_FALSE(tree.Insert(1, 1));
+
+  // Scenario: the rows are still there to read.
+  Row read_row(rid);
+  ASSERT_TRUE(table_heap->GetTuple(&read_row, nullptr));
+  EXPECT_EQ(CmpBool::kTrue, read_row.GetField(0)->CompareEquals(Field(TypeId::kTypeInt, 1)));
+}
+
+TEST(TableHeapTest, DropTableShrinkTest) {
+  DBStorageEngine engine(db_file_name);
+  SimpleMemHeap heap;
+  const int row_nums = 5000;
+  std::vector<Column *> columns = {
+          ALLOC_COLUMN(heap)("id", TypeId::kTypeInt, 0, false, false),
+          ALLOC_COLUMN(heap)("name", TypeId::kTypeChar, 32, 1, true, false)
+  };
+  auto schema = std::make_shared<Schema>(columns);
+  TableInfo *kept = nullptr;
+  TableInfo *dropped = nullptr;
+  ASSERT_EQ(DB_SUCCESS, engine.catalog_mgr_->CreateTable("kept", schema.get(), nullptr, kept));
+  ASSERT_EQ(DB_SUCCESS, engine.catalog_mgr_->CreateTable("dropped", schema.get(), nullptr, dropped));
+  char characters[32];
+  for (int i = 0; i < row_nums; i++) {
+    RandomUtils::RandomString(characters, sizeof(characters));
+    Fields fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeChar, characters, sizeof(characters), true)};
+    Row row(fields);
+    ASSERT_TRUE((i % 10 == 0 ? kept : dropped)->GetTableHeap()->InsertTuple(row, nullptr));
+  }
+  engine.Checkpoint();
+  std::vector<page_id_t> page_ids = dropped->GetTableHeap()->GetPageIds();
+  ASSERT_GT(page_ids.size(), 1);
+  int64_t file_size = engine.disk_mgr_->GetFileSize();
+
+  // Scenario: the pages of a dropped table are deallocated, so the file shrinks by them.
+  ASSERT_EQ(DB_SUCCESS, engine.catalog_mgr_->DropTable("dropped"));
+  for (auto page_id : page_ids) {
+    EXPECT_TRUE(engine.bpm_->IsPageFree(page_id));
+  }
+  EXPECT_GT(engine.Shrink(), 0);
+  EXPECT_LT(engine.disk_mgr_->GetFileSize(), file_size);
+  // the catalog leaves none of its pages pinned
+  EXPECT_TRUE(engine.bpm_->CheckAllUnpinned());
+}
+
+TEST(TableHeapTest, CompactTablesReopenTest) {
+  SimpleMemHeap heap;
+  const int row_nums = 1000;
+  std::vector<Column *> columns = {ALLOC_COLUMN(heap)("id", TypeId::kTypeInt, 0, false, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  page_id_t first_page_id;
+  {
+    DBStorageEngine engine(db_file_name);
+    // free pages below the table once the filler pages are deleted
+    std::vector<page_id_t> filler_ids(30);
+    for (auto &page_id : filler_ids) {
+      ASSERT_NE(nullptr, engine.bpm_->NewPage(page_id));
+      engine.bpm_->UnpinPage(page_id, false);
+    }
+    TableInfo *table_info = nullptr;
+    ASSERT_EQ(DB_SUCCESS, engine.catalog_mgr_->CreateTable("t", schema.get(), nullptr, table_info));
+    for (int i = 0; i < row_nums; i++) {
+      Fields fields{Field(TypeId::kTypeInt, i)};
+      Row row(fields);
+      ASSERT_TRUE(table_info->GetTableHeap()->InsertTuple(row, nullptr));
+    }
+    engine.Checkpoint();
+    for (auto page_id : filler_ids) {
+      ASSERT_TRUE(engine.bpm_->DeletePage(page_id));
+    }
+    first_page_id = table_info->GetTableHeap()->GetFirstPageId();
+    EXPECT_GT(engine.Shrink(), 0);
+    EXPECT_LT(table_info->GetTableHeap()->GetFirstPageId(), first_page_id);
+    EXPECT_EQ(table_info->GetTableHeap()->GetFirstPageId(), table_info->GetRootPageId());
+  }
+
+  // Scenario: the moved head of the heap is recorded in the table metadata, so the rows are found after a reopen.
+  DBStorageEngine engine(db_file_name, false);
+  std::vector<TableInfo *> tables;
+  engine.catalog_mgr_->GetTables(tables);
+  ASSERT_EQ(1, tables.size());
+  TableHeap *table_heap = tables[0]->GetTableHeap();
+  EXPECT_LT(table_heap->GetFirstPageId(), first_page_id);
+  int i = 0;
+  for (auto iter = table_heap->Begin(nullptr); iter != table_heap->End(); iter++, i++) {
+    Row row(iter->GetRowId());
+    ASSERT_TRUE(table_heap->GetTuple(&row, nullptr));
+    ASSERT_EQ(CmpBool::kTrue, row.GetField(0)->CompareEquals(Field(TypeId::kTypeInt, i)));
+  }
+  EXPECT_EQ(row_nums, i);
+}